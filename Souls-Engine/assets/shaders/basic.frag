@@ -1,85 +1,95 @@
 #version 330 core
+// 编译期特性开关（由 Shader::LoadFromFiles 的defines传入，见 ShaderVariants）：
+//   SHADOWS     0/1，默认1；为0时不做阴影采样（不启用阴影的场景）
+//   LIGHT_COUNT 定义时固定计算LightData中的前N个光源，不走分簇光照（未启用分簇光照且光源数已知时）；
+//               未定义时在运行时按ClusterData/numLights选择
+//   OUTLINE     定义时只输出overrideColor（选中物体和光源指示器的轮廓）
+#ifndef SHADOWS
+#define SHADOWS 1
+#endif
+
 out vec4 FragColor;
 
+#ifdef OUTLINE
+
+uniform vec3 overrideColor;
+
+void main()
+{
+    FragColor = vec4(overrideColor, 1.0);
+}
+
+#else
+
 in vec3 Color;
 in vec3 FragPos;
 in vec3 Normal;
-in vec4 FragPosLightSpace;  // 光源空间的片段位置
-
-uniform bool useOverrideColor;
-uniform vec3 overrideColor;
 
 // 材质属性（符合标准Phong光照模型）
-struct Material {
-    vec3 ambient;      // k_a: 环境光反射系数 (0-1)
-    vec3 diffuse;      // k_d: 漫反射系数 (0-1)
-    vec3 specular;     // k_s: 镜面反射系数 (0-1)
-    float shininess;   // n: 镜面反射指数（控制光泽度）
-};
-uniform Material material;
-
-// 光源结构
-struct Light {
-    vec3 position;     // 光源位置
-    vec3 color;        // I_p: 光源颜色和强度
-    float intensity;   // 光源强度倍数
-    // 距离衰减参数: attenuation = 1.0 / (constant + linear * distance + quadratic * distance^2)
-    float constant;
-    float linear;
-    float quadratic;
-};
-
-// 支持最多8个光源（符合OpenGL标准）
-#define MAX_LIGHTS 8
-uniform int numLights;
-uniform Light lights[MAX_LIGHTS];
-
-uniform vec3 viewPos;           // 观察者位置
-uniform vec3 globalAmbient;     // I_a: 全局环境光强度（独立于光源）
-
-// 阴影贴图
-uniform sampler2D shadowMap;
-uniform bool useShadows;  // 是否启用阴影
+// 由顶点着色器传入：普通绘制时来自uniform material，实例化绘制时来自逐实例属性
+in MaterialData {
+    flat vec3 ambient;      // k_a: 环境光反射系数 (0-1)
+    flat vec3 diffuse;      // k_d: 漫反射系数 (0-1)
+    flat vec3 specular;     // k_s: 镜面反射系数 (0-1)
+    flat float shininess;   // n: 镜面反射指数（控制光泽度）
+} material;
+
+#include "frame_uniforms.glsl"
+
+#if defined(LIGHT_COUNT) && (LIGHT_COUNT < 0 || LIGHT_COUNT > MAX_LIGHTS)
+#error LIGHT_COUNT must be between 0 and MAX_LIGHTS
+#endif
+
+#ifndef LIGHT_COUNT
+uniform samplerBuffer clusterLights;         // 每个光源两个texel：(位置, 影响范围), (颜色, 强度)
+uniform usamplerBuffer clusterRanges;        // 每个簇：(光源下标列表中的起始位置, 光源数)
+uniform usamplerBuffer clusterLightIndices;  // 所有簇的光源下标
+#endif
+
+#if SHADOWS
+// 阴影贴图数组（每个级联一层，硬件深度比较）
+uniform sampler2DArrayShadow shadowMap;
 
 // 计算阴影因子（PCF - Percentage Closer Filtering，用于柔化阴影边缘）
-float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir) {
-    if (!useShadows) {
-        return 1.0;  // 不启用阴影时，返回1.0（完全照亮）
+float ShadowCalculation(vec3 fragPos, vec3 normal) {
+    // 按视图空间深度选择级联，超出最后一个级联的片段不在阴影中
+    float viewDepth = -(view * vec4(fragPos, 1.0)).z;
+    int cascade = -1;
+    for (int i = 0; i < cascadeCount; ++i) {
+        if (viewDepth < cascadeSplits[i]) {
+            cascade = i;
+            break;
+        }
     }
-    
-    // 执行透视除法，将齐次坐标转换为NDC坐标
-    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
-    
-    // 转换到 [0,1] 范围
-    projCoords = projCoords * 0.5 + 0.5;
-    
-    // 检查片段是否在阴影贴图范围内
-    if (projCoords.x < 0.0 || projCoords.x > 1.0 || 
-        projCoords.y < 0.0 || projCoords.y > 1.0 ||
-        projCoords.z > 1.0) {
+    if (cascade < 0) {
+        return 1.0;
+    }
+
+    // 法线偏移（Normal Offset）用于避免阴影痤疮：沿法线移动约一个纹素后再投影，
+    // 掠射角下偏移更大；深度偏移由深度通道的glPolygonOffset负责
+    float NdotL = clamp(dot(normal, shadowLightDirection.xyz), 0.0, 1.0);
+    vec3 offsetPos = fragPos + normal * cascadeTexelSizes[cascade] * (2.0 - NdotL);
+
+    // 正交投影不需要透视除法，转换到 [0,1] 范围
+    vec3 projCoords = (cascadeMatrices[cascade] * vec4(offsetPos, 1.0)).xyz * 0.5 + 0.5;
+    if (projCoords.z > 1.0) {
         return 1.0;  // 超出范围，不在阴影中
     }
-    
-    // 获取当前片段在光源视角下的深度
-    float currentDepth = projCoords.z;
-    
-    // 阴影偏移（Shadow Bias）用于避免阴影痤疮
-    float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
-    
-    // PCF（百分比接近滤波）- 采样周围像素，柔化阴影边缘
+
+    // PCF（百分比接近滤波）- 采样周围3x3个位置，每次采样由硬件再做2x2的比较和双线性混合
     float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
     for (int x = -1; x <= 1; ++x) {
         for (int y = -1; y <= 1; ++y) {
             vec2 offset = vec2(x, y) * texelSize;
-            float closestDepth = texture(shadowMap, projCoords.xy + offset).r;
-            shadow += currentDepth - bias > closestDepth ? 0.0 : 1.0;
+            shadow += texture(shadowMap, vec4(projCoords.xy + offset, float(cascade), projCoords.z));
         }
     }
     shadow /= 9.0;  // 9个采样点
     
     return shadow;
 }
+#endif
 
 // 计算单个光源的贡献（改进的Blinn-Phong模型）
 // 标准Phong公式: I = I_a * k_a + I_p * [k_d * (N·L) + k_s * (R·V)^n]
@@ -123,42 +133,75 @@ vec3 CalculateLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir, float
 
 void main()
 {
-    if (useOverrideColor) {
-        FragColor = vec4(overrideColor, 1.0);
-    } else {
-        vec3 norm = normalize(Normal);
-        vec3 viewDir = normalize(viewPos - FragPos);
-        
-        // 标准Phong光照模型计算
-        // I = I_a * k_a + Σ[I_p * (k_d * (N·L) + k_s * (N·H)^n)]
-        
-        // 1. 全局环境光分量（不受距离衰减影响）
-        // I_ambient = I_a * k_a
-        vec3 ambient = material.ambient * globalAmbient;
-        
-        // 2. 计算阴影因子（使用第一个光源作为主光源生成阴影）
-        float shadow = 1.0;
-        if (numLights > 0 && useShadows) {
-            vec3 lightDir = normalize(lights[0].position - FragPos);
-            shadow = ShadowCalculation(FragPosLightSpace, norm, lightDir);
+    vec3 norm = normalize(Normal);
+    vec3 viewDir = normalize(viewPos - FragPos);
+    
+    // 标准Phong光照模型计算
+    // I = I_a * k_a + Σ[I_p * (k_d * (N·L) + k_s * (N·H)^n)]
+    
+    // 1. 全局环境光分量（不受距离衰减影响）
+    // I_ambient = I_a * k_a
+    vec3 ambient = material.ambient * globalAmbient;
+    
+    // 2. 计算阴影因子（主光源按方向光生成级联阴影，只作用于第0个光源）
+    float shadow = 1.0;
+#if SHADOWS
+    if (cascadeCount > 0) {
+        shadow = ShadowCalculation(FragPos, norm);
+    }
+#endif
+    
+    // 3. 累加所有光源的直接光照贡献
+    vec3 directLighting = vec3(0.0);
+#ifdef LIGHT_COUNT
+    // 光源数在编译期确定，循环可以完全展开
+    for (int i = 0; i < LIGHT_COUNT; i++) {
+        directLighting += CalculateLight(lights[i], norm, FragPos, viewDir, i == 0 ? shadow : 1.0);
+    }
+#else
+    if (clusterGrid.w != 0u) {
+        // 由屏幕位置和视图深度找到所在的簇，只计算簇中的光源
+        float viewDepth = -(view * vec4(FragPos, 1.0)).z;
+        uvec3 cluster = uvec3(uvec2(gl_FragCoord.xy / clusterTileSize.xy),
+                              uint(max(log(viewDepth) * clusterDepthParams.x + clusterDepthParams.y, 0.0)));
+        cluster = min(cluster, clusterGrid.xyz - 1u);
+        uvec2 range = texelFetch(clusterRanges, int(cluster.x + clusterGrid.x * (cluster.y + clusterGrid.y * cluster.z))).xy;
+        for (uint i = 0u; i < range.y; i++) {
+            int index = int(texelFetch(clusterLightIndices, int(range.x + i)).r);
+            vec4 positionRange = texelFetch(clusterLights, index * 2);
+            vec4 colorIntensity = texelFetch(clusterLights, index * 2 + 1);
+
+            Light light;
+            light.position = positionRange.xyz;
+            light.intensity = colorIntensity.w;
+            light.color = colorIntensity.rgb;
+            light.constant = clusterAttenuation.x;
+            light.linear = clusterAttenuation.y;
+            light.quadratic = clusterAttenuation.z;
+
+            // 在影响范围边缘平滑衰减到0，范围之外的簇不包含该光源
+            float ratio = length(light.position - FragPos) / positionRange.w;
+            float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+            directLighting += CalculateLight(light, norm, FragPos, viewDir, index == 0 ? shadow : 1.0) * window * window;
         }
-        
-        // 3. 累加所有光源的直接光照贡献
-        vec3 directLighting = vec3(0.0);
+    } else {
         for (int i = 0; i < numLights && i < MAX_LIGHTS; i++) {
-            directLighting += CalculateLight(lights[i], norm, FragPos, viewDir, shadow);
+            directLighting += CalculateLight(lights[i], norm, FragPos, viewDir, i == 0 ? shadow : 1.0);
         }
-        
-        // 4. 最终颜色 = 环境光 + 直接光照
-        vec3 result = ambient + directLighting;
-        
-        // 5. 将顶点颜色作为基色（用于棋盘格等顶点着色物体）
-        result *= Color;
-        
-        // 6. 防止颜色值溢出（根据课程建议）
-        // 方法1: 限制到有效范围 [0, 1]
-        result = clamp(result, 0.0, 1.0);
-        
-        FragColor = vec4(result, 1.0);
     }
+#endif
+    
+    // 4. 最终颜色 = 环境光 + 直接光照
+    vec3 result = ambient + directLighting;
+    
+    // 5. 将顶点颜色作为基色（用于棋盘格等顶点着色物体）
+    result *= Color;
+    
+    // 6. 防止颜色值溢出（根据课程建议）
+    // 方法1: 限制到有效范围 [0, 1]
+    result = clamp(result, 0.0, 1.0);
+    
+    FragColor = vec4(result, 1.0);
 }
+
+#endif
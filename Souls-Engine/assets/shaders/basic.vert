@@ -1,23 +1,66 @@
 #version 330 core
+// 顶点属性（布局见 VertexLayout：位置为half或float，法线为10/10/10/2，颜色为RGBA8，由GL解压）
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNormal;
+
+// 实例化绘制的逐实例属性（布局见 RenderQueue::InstanceData）
+layout (location = 3) in mat4 aInstanceModel;     // 占用location 3-6
+layout (location = 7) in vec3 aInstanceAmbient;
+layout (location = 8) in vec3 aInstanceDiffuse;
+layout (location = 9) in vec4 aInstanceSpecular;  // xyz: 镜面反射颜色, w: 光泽度
 
 out vec3 Color;
 out vec3 FragPos;
 out vec3 Normal;
 
+// 材质属性（非实例化绘制时使用）
+struct Material {
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    float shininess;
+};
+uniform Material material;
+
+// 传给片段着色器的材质参数（按图元平直插值）
+out MaterialData {
+    flat vec3 ambient;
+    flat vec3 diffuse;
+    flat vec3 specular;
+    flat float shininess;
+} materialOut;
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+// 每帧相机数据（所有程序共享的uniform缓冲，见 FrameUniforms）
+#include "frame_uniforms.glsl"
+
+// 为true时模型矩阵和材质来自逐实例属性，而不是uniform
+uniform bool useInstancing;
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    // 简化：假设法线就是顶点位置（对于中心在原点的几何体）
-    // 实际应该从顶点数据中读取法线，但当前顶点格式只有位置和颜色
-    Normal = normalize(vec3(model * vec4(aPos, 0.0)));
-    
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    mat4 modelMatrix = model;
+    if (useInstancing) {
+        modelMatrix = aInstanceModel;
+        materialOut.ambient = aInstanceAmbient;
+        materialOut.diffuse = aInstanceDiffuse;
+        materialOut.specular = aInstanceSpecular.xyz;
+        materialOut.shininess = aInstanceSpecular.w;
+    } else {
+        materialOut.ambient = material.ambient;
+        materialOut.diffuse = material.diffuse;
+        materialOut.specular = material.specular;
+        materialOut.shininess = material.shininess;
+    }
+
+    vec4 worldPos = modelMatrix * vec4(aPos, 1.0);
+    FragPos = vec3(worldPos);
+    // 法线矩阵：模型矩阵左上3x3的逆转置（墙壁等物体有非均匀缩放，不能直接用模型矩阵）
+    mat3 normalMatrix = transpose(inverse(mat3(modelMatrix)));
+    Normal = normalize(normalMatrix * aNormal);
+
+    gl_Position = projection * view * worldPos;
     Color = aColor;
 }
-
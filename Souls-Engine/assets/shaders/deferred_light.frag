@@ -0,0 +1,144 @@
+#version 330 core
+// 延迟渲染的光照通道：从G-buffer读取材质参数，每个像素计算一次光照（G-buffer布局见 DeferredRenderer）
+// 光照模型、分簇光照和阴影与 basic.frag 一致，修改时两边保持同步
+out vec4 FragColor;
+
+uniform sampler2D gAlbedo;     // rgb: k_d * Color
+uniform sampler2D gSpecular;   // rgb: k_s * Color
+uniform sampler2D gNormal;     // xy: 八面体编码的法线，z: 光泽度
+uniform sampler2D gAmbient;    // rgb: I_a * k_a * Color
+uniform sampler2D gDepth;
+
+// 由深度重建世界空间位置
+uniform mat4 inverseViewProjection;
+
+#include "frame_uniforms.glsl"
+
+uniform samplerBuffer clusterLights;
+uniform usamplerBuffer clusterRanges;
+uniform usamplerBuffer clusterLightIndices;
+
+uniform sampler2DArrayShadow shadowMap;
+
+// 八面体编码的逆变换（见 gbuffer.frag）
+vec3 DecodeNormal(vec2 encoded) {
+    vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// 阴影因子（级联选择、法线偏移和3x3 PCF，与 basic.frag 相同）
+float ShadowCalculation(vec3 fragPos, vec3 normal, float viewDepth) {
+    int cascade = -1;
+    for (int i = 0; i < cascadeCount; ++i) {
+        if (viewDepth < cascadeSplits[i]) {
+            cascade = i;
+            break;
+        }
+    }
+    if (cascade < 0) {
+        return 1.0;
+    }
+
+    float NdotL = clamp(dot(normal, shadowLightDirection.xyz), 0.0, 1.0);
+    vec3 offsetPos = fragPos + normal * cascadeTexelSizes[cascade] * (2.0 - NdotL);
+
+    vec3 projCoords = (cascadeMatrices[cascade] * vec4(offsetPos, 1.0)).xyz * 0.5 + 0.5;
+    if (projCoords.z > 1.0) {
+        return 1.0;
+    }
+
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            vec2 offset = vec2(x, y) * texelSize;
+            shadow += texture(shadowMap, vec4(projCoords.xy + offset, float(cascade), projCoords.z));
+        }
+    }
+    return shadow / 9.0;
+}
+
+// 单个光源的直接光照（Blinn-Phong，与 basic.frag 相同；材质系数已乘上顶点颜色）
+vec3 CalculateLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow,
+                    vec3 albedo, vec3 specularColor, float shininess) {
+    vec3 lightDir = normalize(light.position - fragPos);
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance +
+                                light.quadratic * (distance * distance));
+    vec3 lightColorIntensity = light.color * light.intensity;
+
+    float NdotL = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = albedo * NdotL * lightColorIntensity;
+
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float NdotH = max(dot(normal, halfwayDir), 0.0);
+    vec3 specular = specularColor * pow(NdotH, shininess) * lightColorIntensity;
+
+    return (diffuse + specular) * attenuation * shadow;
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    if (depth >= 1.0) {
+        discard;  // 没有几何体，保留背景
+    }
+
+    // 由屏幕坐标和深度重建世界空间位置
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(textureSize(gDepth, 0));
+    vec4 worldPos = inverseViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    vec3 fragPos = worldPos.xyz / worldPos.w;
+
+    vec3 albedo = texelFetch(gAlbedo, pixel, 0).rgb;
+    vec3 specularColor = texelFetch(gSpecular, pixel, 0).rgb;
+    vec4 normalShininess = texelFetch(gNormal, pixel, 0);
+    vec3 ambient = texelFetch(gAmbient, pixel, 0).rgb;
+
+    vec3 norm = DecodeNormal(normalShininess.xy);
+    float shininess = normalShininess.z;
+    vec3 viewDir = normalize(viewPos - fragPos);
+    float viewDepth = -(view * vec4(fragPos, 1.0)).z;
+
+    float shadow = 1.0;
+    if (cascadeCount > 0) {
+        shadow = ShadowCalculation(fragPos, norm, viewDepth);
+    }
+
+    vec3 directLighting = vec3(0.0);
+    if (clusterGrid.w != 0u) {
+        // 屏幕瓦片 x 深度切片：只计算像素所在簇的光源
+        uvec3 cluster = uvec3(uvec2(gl_FragCoord.xy / clusterTileSize.xy),
+                              uint(max(log(viewDepth) * clusterDepthParams.x + clusterDepthParams.y, 0.0)));
+        cluster = min(cluster, clusterGrid.xyz - 1u);
+        uvec2 range = texelFetch(clusterRanges, int(cluster.x + clusterGrid.x * (cluster.y + clusterGrid.y * cluster.z))).xy;
+        for (uint i = 0u; i < range.y; i++) {
+            int index = int(texelFetch(clusterLightIndices, int(range.x + i)).r);
+            vec4 positionRange = texelFetch(clusterLights, index * 2);
+            vec4 colorIntensity = texelFetch(clusterLights, index * 2 + 1);
+
+            Light light;
+            light.position = positionRange.xyz;
+            light.intensity = colorIntensity.w;
+            light.color = colorIntensity.rgb;
+            light.constant = clusterAttenuation.x;
+            light.linear = clusterAttenuation.y;
+            light.quadratic = clusterAttenuation.z;
+
+            float ratio = length(light.position - fragPos) / positionRange.w;
+            float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+            directLighting += CalculateLight(light, norm, fragPos, viewDir, index == 0 ? shadow : 1.0,
+                                             albedo, specularColor, shininess) * window * window;
+        }
+    } else {
+        for (int i = 0; i < numLights && i < MAX_LIGHTS; i++) {
+            directLighting += CalculateLight(lights[i], norm, fragPos, viewDir, i == 0 ? shadow : 1.0,
+                                             albedo, specularColor, shininess);
+        }
+    }
+
+    FragColor = vec4(clamp(ambient + directLighting, 0.0, 1.0), 1.0);
+}
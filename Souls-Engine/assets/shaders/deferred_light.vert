@@ -0,0 +1,7 @@
+#version 330 core
+// 延迟渲染的光照通道：由gl_VertexID生成覆盖整个屏幕的三角形（不需要顶点缓冲）
+void main()
+{
+    vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
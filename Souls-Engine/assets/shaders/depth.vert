@@ -1,12 +1,19 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
-uniform mat4 lightSpaceMatrix;
+// 实例化绘制的模型矩阵（布局见 RenderQueue::InstanceData，深度通道只用到模型矩阵）
+layout (location = 3) in mat4 aInstanceModel;
+
+uniform mat4 lightSpaceMatrix;  // 当前级联的光源空间矩阵（见 ShadowMap::RenderCascades）
 uniform mat4 model;
 
+// 为true时模型矩阵来自逐实例属性
+uniform bool useInstancing;
+
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    mat4 modelMatrix = useInstancing ? aInstanceModel : model;
+    gl_Position = lightSpaceMatrix * modelMatrix * vec4(aPos, 1.0);
 }
 
 
@@ -0,0 +1,48 @@
+// 每帧共享的uniform块（布局与 FrameUniforms 一致），由各着色器通过 #include 引入（见 Shader::LoadFromFiles）
+
+// 光源结构（std140布局，成员顺序与 FrameUniforms::LightEntry 一致）
+struct Light {
+    vec3 position;     // 光源位置
+    float intensity;   // 光源强度倍数
+    vec3 color;        // I_p: 光源颜色和强度
+    // 距离衰减参数: attenuation = 1.0 / (constant + linear * distance + quadratic * distance^2)
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+// 支持最多8个光源（符合OpenGL标准）
+#define MAX_LIGHTS 8
+
+// 每帧数据（所有程序共享的uniform缓冲，见 FrameUniforms）
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;           // 观察者位置
+    vec3 globalAmbient;     // I_a: 全局环境光强度（独立于光源）
+};
+
+layout (std140) uniform LightData {
+    Light lights[MAX_LIGHTS];
+    int numLights;
+};
+
+// 分簇光照（见 LightClusters / FrameUniforms::SetLightClusters）
+// 启用时光源来自簇光源列表（数量不受MAX_LIGHTS限制），否则使用LightData中的光源
+layout (std140) uniform ClusterData {
+    uvec4 clusterGrid;          // xyz: 簇网格尺寸，w: 1表示启用
+    vec4 clusterTileSize;       // xy: 每个簇的屏幕尺寸（像素）
+    vec4 clusterDepthParams;    // x: scale, y: bias，切片 = log(视图深度) * scale + bias
+    vec4 clusterAttenuation;    // xyz: constant, linear, quadratic
+};
+
+// 级联阴影（见 ShadowMap / FrameUniforms::SetShadows）
+#define MAX_CASCADES 4
+
+layout (std140) uniform ShadowData {
+    mat4 cascadeMatrices[MAX_CASCADES];  // 每个级联的光源空间矩阵
+    vec4 cascadeSplits;                  // 每个级联覆盖的最远视图距离
+    vec4 cascadeTexelSizes;              // 每个级联一个纹素的世界空间尺寸
+    vec4 shadowLightDirection;           // xyz: 指向光源的方向
+    int cascadeCount;                    // 0表示不启用阴影
+};
@@ -0,0 +1,39 @@
+#version 330 core
+// 延迟渲染的几何通道（与 basic.vert 配合使用，G-buffer布局见 DeferredRenderer）
+layout (location = 0) out vec4 gAlbedo;     // rgb: k_d * Color
+layout (location = 1) out vec4 gSpecular;   // rgb: k_s * Color
+layout (location = 2) out vec4 gNormal;     // xy: 八面体编码的法线，z: 光泽度
+layout (location = 3) out vec4 gAmbient;    // rgb: I_a * k_a * Color
+
+in vec3 Color;
+in vec3 FragPos;
+in vec3 Normal;
+
+// 材质属性（与 basic.frag 相同，由顶点着色器传入）
+in MaterialData {
+    flat vec3 ambient;
+    flat vec3 diffuse;
+    flat vec3 specular;
+    flat float shininess;
+} material;
+
+#include "frame_uniforms.glsl"
+
+// 八面体编码：单位法线投影到八面体再展开到[-1,1]^2，两个分量即可保存方向
+vec2 EncodeNormal(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    if (n.z < 0.0) {
+        vec2 signs = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(n.yx)) * signs;
+    }
+    return n.xy;
+}
+
+void main()
+{
+    // 顶点颜色作为基色，与 basic.frag 中 result *= Color 等价
+    gAlbedo = vec4(material.diffuse * Color, 1.0);
+    gSpecular = vec4(material.specular * Color, 1.0);
+    gNormal = vec4(EncodeNormal(normalize(Normal)), material.shininess, 1.0);
+    gAmbient = vec4(material.ambient * globalAmbient * Color, 1.0);
+}
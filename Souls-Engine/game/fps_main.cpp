@@ -6,6 +6,7 @@
 #include "../src/core/Window.h"
 #include "../src/core/OpenGLContext.h"
 #include "../src/core/Shader.h"
+#include "../src/core/ShaderVariants.h"
 #include "../src/core/Camera.h"
 #include "../src/core/ObjectManager.h"
 #include "../src/core/FPSGameManager.h"
@@ -14,7 +15,18 @@
 #include "../src/core/LightManager.h"
 #include "../src/core/Material.h"
 #include "../src/core/SceneNode.h"
+#include "../src/core/RenderQueue.h"
+#include "../src/core/OcclusionCuller.h"
+#include "../src/core/ShadowMap.h"
+#include "../src/core/LightClusters.h"
+#include "../src/core/FrameUniforms.h"
+#include "../src/core/DeferredRenderer.h"
+#include "../src/core/GpuTimer.h"
+#include "../src/core/GpuCuller.h"
+#include "../src/core/HiZBuffer.h"
+#include "../src/core/StaticBatcher.h"
 #include "../src/geometry/Mesh.h"
+#include "../src/geometry/GeometryArena.h"
 #include "../src/core/OpenGLContext.h"  // For GL_CHECK_ERROR macro
 #include <GLFW/glfw3.h>
 #include <imgui.h>
@@ -23,7 +35,9 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -108,16 +122,21 @@ int main() {
     };
     
     std::string vertexPath, fragmentPath;
+    std::string depthVertexPath, depthFragmentPath;
+    std::string shaderDirectory;
     bool shaderFilesFound = false;
     
     for (const auto& basePath : shaderPaths) {
         vertexPath = basePath + "basic.vert";
         fragmentPath = basePath + "basic.frag";
+        depthVertexPath = basePath + "depth.vert";
+        depthFragmentPath = basePath + "depth.frag";
         
         std::cout << "Checking Shader files: " << basePath << std::endl;
         
         if (FileExists(vertexPath) && FileExists(fragmentPath)) {
             std::cout << "Found Shader files: " << basePath << std::endl;
+            shaderDirectory = basePath;
             shaderFilesFound = true;
             break;
         }
@@ -164,10 +183,12 @@ int main() {
     // Set viewport
     glViewport(0, 0, window.GetWidth(), window.GetHeight());
 
-    // Load Shader
-    SoulsEngine::Shader shader;
+    // Load Shader: the world shader is compiled per feature set (SHADOWS, LIGHT_COUNT) on first use;
+    // the shadowed, clustered variant used by default is built up front
+    SoulsEngine::ShaderVariants worldShaders(vertexPath, fragmentPath);
     std::cout << "Loading Shader from: " << vertexPath << " and " << fragmentPath << std::endl;
-    if (!shader.LoadFromFiles(vertexPath, fragmentPath)) {
+    SoulsEngine::Shader* worldShader = worldShaders.Get({ { "SHADOWS", "1" } });
+    if (!worldShader) {
         std::cerr << "Error: Shader compilation/linking failed!" << std::endl;
         window.Shutdown();
         std::cout << "Press Enter to exit..." << std::endl;
@@ -176,6 +197,54 @@ int main() {
     }
     std::cout << "Shader loaded and compiled successfully!" << std::endl;
 
+    // Inputs of the active world variant; the defines are rebuilt and looked up only when one of them changes
+    bool worldVariantShadows = true;
+    bool worldVariantClustered = true;
+    size_t worldVariantLightCount = 0;
+    std::string worldVariantKey = SoulsEngine::ShaderVariants::MakeKey({ { "SHADOWS", "1" } });
+
+    // Depth-only shader for the shadow cascades
+    SoulsEngine::Shader depthShader;
+    if (!depthShader.LoadFromFiles(depthVertexPath, depthFragmentPath)) {
+        std::cerr << "Error: Depth shader compilation/linking failed!" << std::endl;
+        window.Shutdown();
+        std::cout << "Press Enter to exit..." << std::endl;
+        std::cin.get();
+        return -1;
+    }
+
+    // Deferred path: G-buffer pass (shares basic.vert) and full-screen lighting pass; forward only if they fail
+    SoulsEngine::Shader gbufferShader;
+    SoulsEngine::Shader lightingShader;
+    bool deferredShadersLoaded = gbufferShader.LoadFromFiles(vertexPath, shaderDirectory + "gbuffer.frag")
+        && lightingShader.LoadFromFiles(shaderDirectory + "deferred_light.vert", shaderDirectory + "deferred_light.frag");
+    if (!deferredShadersLoaded) {
+        std::cerr << "Warning: Deferred shader compilation/linking failed, forward rendering only" << std::endl;
+    }
+
+    // Uniform handles for the weapon pass, resolved once per world shader variant instead of by name on every draw
+    SoulsEngine::UniformHandle<glm::mat4> modelUniform;
+    SoulsEngine::UniformHandle<glm::vec3> ambientUniform;
+    SoulsEngine::UniformHandle<glm::vec3> diffuseUniform;
+    SoulsEngine::UniformHandle<glm::vec3> specularUniform;
+    SoulsEngine::UniformHandle<float> shininessUniform;
+    const SoulsEngine::Shader* weaponUniformShader = nullptr;
+    auto resolveWeaponUniforms = [&]() {
+        if (weaponUniformShader == worldShader) return;
+        modelUniform = worldShader->GetUniformHandle<glm::mat4>("model");
+        ambientUniform = worldShader->GetUniformHandle<glm::vec3>("material.ambient");
+        diffuseUniform = worldShader->GetUniformHandle<glm::vec3>("material.diffuse");
+        specularUniform = worldShader->GetUniformHandle<glm::vec3>("material.specular");
+        shininessUniform = worldShader->GetUniformHandle<float>("material.shininess");
+        weaponUniformShader = worldShader;
+    };
+    auto applyMaterial = [&](const SoulsEngine::Material& material) {
+        worldShader->Set(ambientUniform, material.GetAmbient());
+        worldShader->Set(diffuseUniform, material.GetDiffuse());
+        worldShader->Set(specularUniform, material.GetSpecular());
+        worldShader->Set(shininessUniform, material.GetShininess());
+    };
+
     // Create camera (first-person view)
     SoulsEngine::Camera camera(glm::vec3(0.0f, 1.6f, 0.0f));
     float aspectRatio = static_cast<float>(window.GetWidth()) / static_cast<float>(window.GetHeight());
@@ -198,6 +267,61 @@ int main() {
     SoulsEngine::ObjectManager objectManager;
     std::cout << "Object manager created" << std::endl;
 
+    // Render queue for the world pass (sorted by state, submitted through a GL state cache)
+    SoulsEngine::RenderQueue renderQueue;
+    const bool multiDrawSupported = SoulsEngine::RenderQueue::IsMultiDrawSupported();
+    std::cout << "Multi-draw indirect: " << (multiDrawSupported ? "supported" : "not supported (GL < 4.3), per-draw submission") << std::endl;
+
+    // Software occlusion culling against the walls and ground (rasterized on the job system)
+    SoulsEngine::OcclusionCuller occlusionCuller;
+
+    // GPU-driven culling (G toggles): frustum and Hi-Z occlusion tests in a compute shader that writes
+    // the indirect commands directly; the Hi-Z pyramid is built from the previous frame's world depth
+    SoulsEngine::GpuCuller gpuCuller;
+    SoulsEngine::HiZBuffer hiZBuffer;
+    SoulsEngine::Shader cullShader;
+    SoulsEngine::Shader hiZShader;
+    const bool gpuCullingSupported = SoulsEngine::GpuCuller::IsSupported()
+        && cullShader.LoadComputeFromFile(shaderDirectory + "gpu_cull.comp")
+        && hiZShader.LoadComputeFromFile(shaderDirectory + "hiz_downsample.comp");
+    std::cout << "GPU culling: " << (gpuCullingSupported ? "supported" : "not supported, CPU culling only") << std::endl;
+    bool gpuCullingEnabled = false;
+    bool gpuCullingKeyPressed = false;
+
+    // Static batching (B toggles): walls and ground are pre-transformed and merged per material,
+    // rebuilt only when a static node changes
+    SoulsEngine::StaticBatcher staticBatcher;
+    bool staticBatchingEnabled = true;
+    bool staticBatchingKeyPressed = false;
+
+    // Cascaded shadow maps for the main light; K cycles the quality presets
+    struct ShadowPreset {
+        const char* name;
+        int cascadeCount;
+        unsigned int resolution;
+    };
+    const ShadowPreset shadowPresets[] = {
+        { "Low", 1, 1024 },
+        { "Medium", 2, 1024 },
+        { "High", 3, 2048 },
+        { "Ultra", 4, 2048 }
+    };
+    const int shadowPresetCount = static_cast<int>(sizeof(shadowPresets) / sizeof(shadowPresets[0]));
+    int shadowPreset = 2;
+    auto makeShadowSettings = [&](SoulsEngine::ShadowSettings settings, int preset) {
+        settings.cascadeCount = shadowPresets[preset].cascadeCount;
+        settings.resolution = shadowPresets[preset].resolution;
+        return settings;
+    };
+    SoulsEngine::ShadowMap shadowMap(makeShadowSettings(SoulsEngine::ShadowSettings(), shadowPreset));
+    bool shadowsEnabled = shadowMap.Initialize();
+    if (!shadowsEnabled) {
+        std::cerr << "Error: Failed to create shadow map, shadows disabled!" << std::endl;
+    }
+    SoulsEngine::RenderQueue shadowQueue;
+    bool shadowKeyPressed = false;
+    bool shadowCacheKeyPressed = false;
+
     // Create light manager
     SoulsEngine::LightManager lightManager;
     
@@ -213,6 +337,40 @@ int main() {
     }
     std::cout << "Light created" << std::endl;
 
+    // Clustered forward lighting: lights are binned into a view-space cluster grid every frame,
+    // so the fragment shader only evaluates the lights that reach its cluster
+    SoulsEngine::LightClusters lightClusters;
+    bool clustersEnabled = lightClusters.Initialize();
+    if (!clustersEnabled) {
+        std::cerr << "Warning: Failed to create light cluster buffers, lighting limited to "
+                  << SoulsEngine::FrameUniforms::MaxLights << " lights" << std::endl;
+    }
+
+    // Deferred renderer (M toggles forward/deferred) and GPU timers for both paths
+    SoulsEngine::DeferredRenderer deferredRenderer;
+    SoulsEngine::RenderPath renderPath = SoulsEngine::RenderPath::Forward;
+    bool renderPathKeyPressed = false;
+    bool multiDrawKeyPressed = false;
+    SoulsEngine::GpuTimer forwardTimer;
+    SoulsEngine::GpuTimer geometryTimer;
+    SoulsEngine::GpuTimer lightingTimer;
+    forwardTimer.Initialize();
+    geometryTimer.Initialize();
+    lightingTimer.Initialize();
+
+    // Light field for stress testing the clustered path (N toggles 256 small point lights)
+    std::vector<std::shared_ptr<SoulsEngine::Light>> lightField;
+    bool lightFieldKeyPressed = false;
+
+    // Per-frame camera and light data (uniform buffers shared by every shader program)
+    SoulsEngine::FrameUniforms frameUniforms;
+    if (!frameUniforms.Initialize()) {
+        std::cerr << "Error: Failed to create frame uniform buffers!" << std::endl;
+        window.Shutdown();
+        std::cin.get();
+        return -1;
+    }
+
     // Create FPS game manager
     std::cout << "Creating FPS game manager..." << std::endl;
     SoulsEngine::FPSGameManager fpsGameManager(&objectManager, &camera);
@@ -225,6 +383,9 @@ int main() {
     weaponModel.CreateWeapon(&objectManager);
     std::cout << "Weapon model created" << std::endl;
 
+    // Resolve the weapon handle once; per-frame access is an O(1) slot lookup without refcounting
+    SoulsEngine::NodeHandle weaponHandle = objectManager.FindHandle("WeaponBody");
+
     // Initialize ImGui (for game UI)
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
@@ -261,6 +422,87 @@ int main() {
             glfwSetWindowShouldClose(window.GetGLFWWindow(), true);
         }
 
+        // K cycles the shadow quality preset (edge-triggered)
+        bool shadowKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_K) == GLFW_PRESS;
+        if (shadowKeyDown && !shadowKeyPressed && shadowsEnabled) {
+            shadowPreset = (shadowPreset + 1) % shadowPresetCount;
+            shadowsEnabled = shadowMap.SetSettings(makeShadowSettings(shadowMap.GetSettings(), shadowPreset));
+            if (!shadowsEnabled) {
+                std::cerr << "Error: Failed to resize shadow map, shadows disabled!" << std::endl;
+            }
+        }
+        shadowKeyPressed = shadowKeyDown;
+
+        // L toggles caching of the static (walls, ground) shadow depth
+        bool shadowCacheKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_L) == GLFW_PRESS;
+        if (shadowCacheKeyDown && !shadowCacheKeyPressed && shadowsEnabled) {
+            SoulsEngine::ShadowSettings settings = shadowMap.GetSettings();
+            settings.cacheStatic = !settings.cacheStatic;
+            shadowsEnabled = shadowMap.SetSettings(settings);
+            if (!shadowsEnabled) {
+                std::cerr << "Error: Failed to recreate shadow map, shadows disabled!" << std::endl;
+            }
+        }
+        shadowCacheKeyPressed = shadowCacheKeyDown;
+
+        // N toggles the light field: a 16x16 grid of colored point lights hovering over the arena floor
+        bool lightFieldKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_N) == GLFW_PRESS;
+        if (lightFieldKeyDown && !lightFieldKeyPressed) {
+            if (lightField.empty()) {
+                const int gridSize = 16;
+                for (int i = 0; i < gridSize * gridSize; ++i) {
+                    float x = -16.0f + 32.0f * (i % gridSize + 0.5f) / gridSize;
+                    float z = -16.0f + 32.0f * (i / gridSize + 0.5f) / gridSize;
+                    float hue = static_cast<float>(i) / (gridSize * gridSize) * 6.2831853f;
+                    glm::vec3 color = 0.5f + 0.5f * glm::cos(hue + glm::vec3(0.0f, 2.094f, 4.189f));
+                    auto fieldLight = lightManager.AddLight(glm::vec3(x, 0.6f, z), color, 1.5f, 360.0f);
+                    fieldLight->SetRange(4.0f);
+                    lightField.push_back(fieldLight);
+                }
+            } else {
+                for (auto& fieldLight : lightField) {
+                    lightManager.RemoveLight(fieldLight);
+                }
+                lightField.clear();
+            }
+        }
+        lightFieldKeyPressed = lightFieldKeyDown;
+        for (size_t i = 0; i < lightField.size(); ++i) {
+            glm::vec3 position = lightField[i]->GetPosition();
+            position.y = 0.6f + 0.4f * std::sin(currentTime * 2.0f + static_cast<float>(i));
+            lightField[i]->SetPosition(position);
+        }
+
+        // M toggles between the forward and deferred world pass
+        bool renderPathKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_M) == GLFW_PRESS;
+        if (renderPathKeyDown && !renderPathKeyPressed && deferredShadersLoaded) {
+            renderPath = renderPath == SoulsEngine::RenderPath::Forward ? SoulsEngine::RenderPath::Deferred
+                                                                        : SoulsEngine::RenderPath::Forward;
+        }
+        renderPathKeyPressed = renderPathKeyDown;
+
+        // I toggles multi-draw indirect submission (only on GL 4.3+ contexts)
+        bool multiDrawKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_I) == GLFW_PRESS;
+        if (multiDrawKeyDown && !multiDrawKeyPressed && multiDrawSupported) {
+            renderQueue.SetMultiDrawEnabled(!renderQueue.IsMultiDrawEnabled());
+        }
+        multiDrawKeyPressed = multiDrawKeyDown;
+
+        // G toggles GPU culling; the Hi-Z pyramid is dropped so a stale one is never used after re-enabling
+        bool gpuCullingKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_G) == GLFW_PRESS;
+        if (gpuCullingKeyDown && !gpuCullingKeyPressed && gpuCullingSupported) {
+            gpuCullingEnabled = !gpuCullingEnabled;
+            hiZBuffer.Shutdown();
+        }
+        gpuCullingKeyPressed = gpuCullingKeyDown;
+
+        // B toggles static batching (CPU culling path only; the GPU culler already draws each mesh group at once)
+        bool staticBatchingKeyDown = glfwGetKey(window.GetGLFWWindow(), GLFW_KEY_B) == GLFW_PRESS;
+        if (staticBatchingKeyDown && !staticBatchingKeyPressed) {
+            staticBatchingEnabled = !staticBatchingEnabled;
+        }
+        staticBatchingKeyPressed = staticBatchingKeyDown;
+
         // Process player input (including movement, mouse control, shooting, etc.)
         fpsGameManager.ProcessPlayerInput(deltaTime, window.GetGLFWWindow(), 
                                           window.GetWidth(), window.GetHeight());
@@ -268,96 +510,168 @@ int main() {
         // Update game logic
         fpsGameManager.Update(deltaTime);
 
+        // Calculate view and projection matrices (recalculate each frame as view may change)
+        glm::mat4 view = camera.GetViewMatrix();
+        glm::mat4 projection = camera.GetProjectionMatrix(aspectRatio);
+
+        // The camera is final for this frame: start rasterizing occluders on the worker threads
+        // so it overlaps with the weapon/scene update and the uniform upload below (not needed when culling on the GPU)
+        if (!gpuCullingEnabled) {
+            occlusionCuller.BeginFrame(projection * view, objectManager);
+        }
+
         // Update weapon model position (based on zoom state)
         weaponModel.Update(fpsGameManager.IsZoomed(), window.GetWidth(), window.GetHeight());
 
+        // Update scene
+        objectManager.Update();
+
+        // Pick the tessellation level of LOD meshes (targets) from their projected screen size
+        SoulsEngine::LODStats lodStats = objectManager.UpdateLODs(SoulsEngine::LODContext::FromCamera(
+            camera.GetPosition(), projection, static_cast<float>(window.GetHeight())));
+
+        // Shadow pass: the main light is treated as a directional light shining towards the arena center.
+        // Each cascade is culled against its own light-space frustum; the pass restores the framebuffer and viewport
+        const bool shadowPass = shadowsEnabled && light;
+        if (shadowPass) {
+            glm::vec3 lightDirection = glm::normalize(glm::vec3(0.0f) - light->GetPosition());
+            shadowMap.Update(view, projection, lightDirection,
+                             objectManager.ComputeWorldBounds(~SoulsEngine::NodeLayer::ViewModel));
+            shadowMap.RenderCascades(objectManager, depthShader, shadowQueue);
+            shadowMap.BindTexture();
+            frameUniforms.SetShadows(&shadowMap);
+        } else {
+            frameUniforms.SetShadows(nullptr);
+        }
+
         // Clear buffers
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+        // Pick this frame's world shader variant: shadow sampling is compiled out when there is no shadow pass,
+        // and without light clusters the light loop runs over a compile-time light count
+        const size_t lightCount = clustersEnabled ? 0 : std::min(lightManager.GetLights().size(),
+                                                                 static_cast<size_t>(SoulsEngine::FrameUniforms::MaxLights));
+        if (shadowPass != worldVariantShadows || clustersEnabled != worldVariantClustered ||
+            lightCount != worldVariantLightCount) {
+            SoulsEngine::ShaderDefines worldDefines = { { "SHADOWS", shadowPass ? "1" : "0" } };
+            if (!clustersEnabled) {
+                worldDefines.push_back({ "LIGHT_COUNT", std::to_string(lightCount) });
+            }
+            // A variant that fails to compile keeps the previous shader (the failure is cached, so it is not retried)
+            if (SoulsEngine::Shader* variant = worldShaders.Get(worldDefines)) {
+                worldShader = variant;
+                worldVariantKey = SoulsEngine::ShaderVariants::MakeKey(worldDefines);
+            }
+            worldVariantShadows = shadowPass;
+            worldVariantClustered = clustersEnabled;
+            worldVariantLightCount = lightCount;
+        }
+        SoulsEngine::Shader& shader = *worldShader;
+
         // Use Shader
         shader.Use();
-
-        // Calculate view and projection matrices (recalculate each frame as view may change)
-        glm::mat4 view = camera.GetViewMatrix();
-        glm::mat4 projection = camera.GetProjectionMatrix(aspectRatio);
+        resolveWeaponUniforms();
         
-        // Pass matrices to Shader
-        shader.SetMat4("view", glm::value_ptr(view));
-        shader.SetMat4("projection", glm::value_ptr(projection));
-        
-        // Update scene
-        objectManager.Update();
-        
-        // Set light parameters
-        auto firstLight = lightManager.GetFirstLight();
-        if (firstLight) {
-            glm::vec3 lightPos = firstLight->GetPosition();
-            glm::vec3 lightColor = firstLight->GetColor();
-            float lightIntensity = firstLight->GetIntensity();
-            glm::vec3 viewPos = camera.GetPosition();
-            
-            shader.SetVec3("lightPos", lightPos.x, lightPos.y, lightPos.z);
-            shader.SetVec3("lightColor", lightColor.r * lightIntensity, 
-                          lightColor.g * lightIntensity, lightColor.b * lightIntensity);
-            shader.SetVec3("viewPos", viewPos.x, viewPos.y, viewPos.z);
+        // Bin the lights into clusters (one job per depth slice) and upload the light lists
+        if (clustersEnabled) {
+            lightClusters.Build(lightManager.GetLights(), view, projection, window.GetWidth(), window.GetHeight(),
+                                &SoulsEngine::JobSystem::Get());
+            lightClusters.Upload();
+            lightClusters.BindTextures();
+            frameUniforms.SetLightClusters(&lightClusters);
         }
 
-        // Render scene (including weapon, but weapon position needs special handling)
-        // First save weapon node's original position and rotation
-        auto weaponNode = objectManager.FindNode("WeaponBody");
-        glm::vec3 weaponOriginalPos(0.0f);
-        glm::vec3 weaponOriginalRot(0.0f);
-        if (weaponNode) {
-            weaponOriginalPos = weaponNode->GetPosition();
-            weaponOriginalRot = weaponNode->GetRotation();
-            
-            // Calculate weapon's position and rotation in world coordinates (follow camera)
-            glm::vec3 cameraPos = camera.GetPosition();
-            glm::vec3 cameraFront = camera.GetFront();
-            glm::vec3 cameraRight = camera.GetRight();
-            glm::vec3 cameraUp = camera.GetUp();
-            
-            // Convert weapon local coordinates to world coordinates
-            // Note: In camera coordinate system, positive z is forward (camera looks at -z, so positive z means forward)
-            glm::vec3 weaponWorldPos = cameraPos + 
-                cameraRight * weaponOriginalPos.x + 
-                cameraUp * weaponOriginalPos.y + 
-                cameraFront * weaponOriginalPos.z;  // positive z means camera forward
-            
-            // Temporarily set weapon's world position (for subsequent rendering)
-            weaponNode->SetPosition(weaponWorldPos);
-            weaponNode->SetRotation(weaponOriginalRot);
-        }
+        // Upload camera, light and shadow data (one buffer update per block, shared by all programs)
+        frameUniforms.SetCamera(view, projection, camera.GetPosition());
+        frameUniforms.SetLights(lightManager.GetLights());
+        frameUniforms.Upload();
+
+        // The weapon lives in the view-model layer: it is drawn below from a model matrix built from the camera,
+        // so its scene node is never moved per frame (that would bump the transform version and defeat change detection)
+        SoulsEngine::SceneNode* weaponNode = objectManager.GetNode(weaponHandle);
         
-        // First render other scene objects (excluding weapon)
-        auto allNodes = objectManager.GetAllNodes();
-        glm::mat4 identity = glm::mat4(1.0f);
-        for (auto& node : allNodes) {
-            if (node && node->GetName() != "WeaponBody" && 
-                node->GetName() != "WeaponBarrel" && 
-                node->GetName() != "WeaponStock" && 
-                node->GetName() != "WeaponScope") {
-                auto sceneNode = std::dynamic_pointer_cast<SoulsEngine::SceneNode>(node);
-                if (sceneNode) {
-                    sceneNode->Render(identity, &shader);
-                }
+        // First render other scene objects (excluding weapon, which lives in the view-model layer),
+        // skipping nodes whose world bounds fall outside the camera frustum or behind the occluders
+        SoulsEngine::ViewFrustum frustum(view, projection);
+        renderQueue.Begin(view);
+        SoulsEngine::CullingStats cullingStats;
+        if (gpuCullingEnabled) {
+            // Instance buffers only change with the scene (LOD switches swap meshes); the compute pass fills the commands
+            gpuCuller.Sync(objectManager, ~SoulsEngine::NodeLayer::ViewModel, lodStats.levelChanges > 0);
+            gpuCuller.Cull(cullShader, frustum, &hiZBuffer);
+        } else {
+            // Batched static nodes are drawn through their merged meshes instead of one by one;
+            // static nodes the batcher could not merge (no readable geometry) still go through the queue
+            if (staticBatchingEnabled) {
+                staticBatcher.Update(objectManager, ~SoulsEngine::NodeLayer::ViewModel);
+                staticBatcher.Submit(renderQueue, frustum);
             }
+            cullingStats = objectManager.ForEachVisibleRenderable(frustum, [&](SoulsEngine::SceneNode& node) {
+                if (staticBatchingEnabled && staticBatcher.IsBatched(node)) return;
+                renderQueue.Submit(node);
+            }, ~SoulsEngine::NodeLayer::ViewModel, &occlusionCuller);
+            renderQueue.Sort();
+        }
+        auto drawWorld = [&](const SoulsEngine::Shader& worldShader) {
+            if (gpuCullingEnabled) {
+                gpuCuller.Draw(worldShader);
+            } else {
+                renderQueue.Execute(worldShader);
+            }
+        };
+
+        // The G-buffer follows the framebuffer size; fall back to forward if it cannot be created
+        bool deferredFrame = false;
+        if (renderPath == SoulsEngine::RenderPath::Deferred) {
+            int framebufferWidth = 0, framebufferHeight = 0;
+            glfwGetFramebufferSize(window.GetGLFWWindow(), &framebufferWidth, &framebufferHeight);
+            deferredFrame = deferredRenderer.Resize(framebufferWidth, framebufferHeight);
+        }
+        if (deferredFrame) {
+            // Geometry pass writes the material inputs once per pixel; the lighting pass then shades each pixel
+            // once against its cluster's lights and copies the depth back for the weapon pass below
+            geometryTimer.Begin();
+            deferredRenderer.BeginGeometryPass();
+            drawWorld(gbufferShader);
+            deferredRenderer.EndGeometryPass();
+            geometryTimer.End();
+
+            lightingTimer.Begin();
+            deferredRenderer.LightingPass(lightingShader, view, projection);
+            lightingTimer.End();
+            shader.Use();
+        } else {
+            forwardTimer.Begin();
+            drawWorld(shader);
+            forwardTimer.End();
+        }
+
+        // Build next frame's Hi-Z pyramid from the world depth, before the weapon is drawn so it never occludes the scene
+        if (gpuCullingEnabled) {
+            int framebufferWidth = 0, framebufferHeight = 0;
+            glfwGetFramebufferSize(window.GetGLFWWindow(), &framebufferWidth, &framebufferHeight);
+            if (hiZBuffer.Resize(framebufferWidth, framebufferHeight)) {
+                hiZBuffer.Build(hiZShader, projection * view);
+            }
+            shader.Use();
         }
         
         // Render weapon separately, using camera's rotation matrix to make it follow view
         if (weaponNode) {
-            auto weaponSceneNode = std::dynamic_pointer_cast<SoulsEngine::SceneNode>(weaponNode);
+            SoulsEngine::SceneNode* weaponSceneNode = weaponNode;
             if (weaponSceneNode) {
                 glm::vec3 cameraPos = camera.GetPosition();
                 glm::vec3 cameraFront = camera.GetFront();
                 glm::vec3 cameraRight = camera.GetRight();
                 glm::vec3 cameraUp = camera.GetUp();
                 
-                // Calculate weapon world position (using original local position)
+                // Convert weapon local (camera-space) position to world coordinates
+                // Note: In camera coordinate system, positive z is forward (camera looks at -z, so positive z means forward)
+                glm::vec3 weaponLocalPos = weaponNode->GetPosition();
                 glm::vec3 weaponWorldPos = cameraPos + 
-                    cameraRight * weaponOriginalPos.x + 
-                    cameraUp * weaponOriginalPos.y + 
-                    cameraFront * weaponOriginalPos.z;
+                    cameraRight * weaponLocalPos.x + 
+                    cameraUp * weaponLocalPos.y + 
+                    cameraFront * weaponLocalPos.z;
                 
                 // Get weapon's local rotation and scale (needed for scope alignment calculation)
                 glm::vec3 weaponRot = weaponNode->GetRotation();
@@ -415,30 +729,24 @@ int main() {
                 weaponTransform = glm::scale(weaponTransform, weaponScale);
                 
                 // Set model matrix directly to shader, then render weapon and its children
-                shader.SetMat4("model", glm::value_ptr(weaponTransform));
+                shader.Set(modelUniform, weaponTransform);
                 
                 // Render weapon main node
                 if (weaponSceneNode->GetMesh()) {
                     // Apply material
                     const auto& material = weaponSceneNode->GetMaterial();
                     if (material) {
-                        shader.SetVec3("material.ambient", material->GetAmbient().r, material->GetAmbient().g, material->GetAmbient().b);
-                        shader.SetVec3("material.diffuse", material->GetDiffuse().r, material->GetDiffuse().g, material->GetDiffuse().b);
-                        shader.SetVec3("material.specular", material->GetSpecular().r, material->GetSpecular().g, material->GetSpecular().b);
-                        shader.SetFloat("material.shininess", material->GetShininess());
+                        applyMaterial(*material);
                     } else {
                         static auto defaultMat = SoulsEngine::Material::CreateDefault();
-                        shader.SetVec3("material.ambient", defaultMat.GetAmbient().r, defaultMat.GetAmbient().g, defaultMat.GetAmbient().b);
-                        shader.SetVec3("material.diffuse", defaultMat.GetDiffuse().r, defaultMat.GetDiffuse().g, defaultMat.GetDiffuse().b);
-                        shader.SetVec3("material.specular", defaultMat.GetSpecular().r, defaultMat.GetSpecular().g, defaultMat.GetSpecular().b);
-                        shader.SetFloat("material.shininess", defaultMat.GetShininess());
+                        applyMaterial(defaultMat);
                     }
                     weaponSceneNode->GetMesh()->Draw();
                 }
                 
                 // Render weapon's child nodes (barrel, stock, scope)
                 for (auto& child : weaponNode->GetChildren()) {
-                    auto childSceneNode = std::dynamic_pointer_cast<SoulsEngine::SceneNode>(child);
+                    auto childSceneNode = dynamic_cast<SoulsEngine::SceneNode*>(child.get());
                     if (childSceneNode && childSceneNode->GetMesh()) {
                         // Calculate child node's world transformation
                         glm::vec3 childPos = child->GetPosition();
@@ -452,33 +760,21 @@ int main() {
                         childTransform = glm::rotate(childTransform, glm::radians(childRot.x), glm::vec3(1.0f, 0.0f, 0.0f));
                         childTransform = glm::scale(childTransform, childScale);
                         
-                        shader.SetMat4("model", glm::value_ptr(childTransform));
+                        shader.Set(modelUniform, childTransform);
                         
                         // Apply material
                         const auto& childMaterial = childSceneNode->GetMaterial();
                         if (childMaterial) {
-                            shader.SetVec3("material.ambient", childMaterial->GetAmbient().r, childMaterial->GetAmbient().g, childMaterial->GetAmbient().b);
-                            shader.SetVec3("material.diffuse", childMaterial->GetDiffuse().r, childMaterial->GetDiffuse().g, childMaterial->GetDiffuse().b);
-                            shader.SetVec3("material.specular", childMaterial->GetSpecular().r, childMaterial->GetSpecular().g, childMaterial->GetSpecular().b);
-                            shader.SetFloat("material.shininess", childMaterial->GetShininess());
+                            applyMaterial(*childMaterial);
                         } else {
                             static auto defaultMat = SoulsEngine::Material::CreateDefault();
-                            shader.SetVec3("material.ambient", defaultMat.GetAmbient().r, defaultMat.GetAmbient().g, defaultMat.GetAmbient().b);
-                            shader.SetVec3("material.diffuse", defaultMat.GetDiffuse().r, defaultMat.GetDiffuse().g, defaultMat.GetDiffuse().b);
-                            shader.SetVec3("material.specular", defaultMat.GetSpecular().r, defaultMat.GetSpecular().g, defaultMat.GetSpecular().b);
-                            shader.SetFloat("material.shininess", defaultMat.GetShininess());
+                            applyMaterial(defaultMat);
                         }
                         childSceneNode->GetMesh()->Draw();
                     }
                 }
             }
         }
-        
-        // Restore weapon's local position and rotation
-        if (weaponNode) {
-            weaponNode->SetPosition(weaponOriginalPos);
-            weaponNode->SetRotation(weaponOriginalRot);
-        }
 
         // Render game UI (using ImGui)
         ImGui_ImplOpenGL3_NewFrame();
@@ -488,7 +784,7 @@ int main() {
         // Game UI window
         {
             ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
-            ImGui::SetNextWindowSize(ImVec2(250, 150), ImGuiCond_Always);
+            ImGui::SetNextWindowSize(ImVec2(250, 460), ImGuiCond_Always);
             ImGui::Begin("Game Info", nullptr, 
                          ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | 
                          ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoTitleBar);
@@ -504,6 +800,72 @@ int main() {
                 ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Playing...");
             }
             
+            // Render queue counters for the world pass
+            const SoulsEngine::RenderStats& renderStats = renderQueue.GetStats();
+            ImGui::Separator();
+            if (gpuCullingEnabled) {
+                const SoulsEngine::GpuCullingStats& gpuStats = gpuCuller.GetStats();
+                ImGui::Text("GPU culling: %u / %u instances visible, %u draws", gpuStats.visible, gpuStats.instances,
+                            gpuStats.drawCalls);
+            } else {
+                ImGui::Text("Culling: %u / %u nodes visible (%u occluded)", cullingStats.visible, cullingStats.tested, cullingStats.occluded);
+                ImGui::Text("GPU culling: %s", gpuCullingSupported ? "off" : "unsupported");
+                if (staticBatchingEnabled) {
+                    const SoulsEngine::StaticBatchStats& batchStats = staticBatcher.GetStats();
+                    ImGui::Text("Static batches: %u / %u drawn, %u nodes", batchStats.visibleBatches, batchStats.batches,
+                                batchStats.nodes);
+                } else {
+                    ImGui::Text("Static batches: off");
+                }
+            }
+            ImGui::Text("Draws: %u / %u items, %u triangles", renderStats.drawCalls, renderStats.drawItems, renderStats.triangles);
+            ImGui::Text("LOD: %u nodes, %u / %u triangles (%u switched)", lodStats.nodes, lodStats.triangles,
+                        lodStats.fullDetailTriangles, lodStats.levelChanges);
+            ImGui::Text("Instanced: %u draws, %u instances", renderStats.instancedDrawCalls, renderStats.instances);
+            if (multiDrawSupported && renderQueue.IsMultiDrawEnabled()) {
+                ImGui::Text("Multi-draw: %u calls, %u commands", renderStats.multiDrawCalls, renderStats.indirectCommands);
+            } else {
+                ImGui::Text("Multi-draw: %s", multiDrawSupported ? "off" : "unsupported");
+            }
+            ImGui::Text("State changes: %u", renderStats.GetStateChanges());
+            ImGui::Text("Uniforms: %u written, %u skipped", renderStats.uniformsWritten, renderStats.uniformsSkipped);
+            if (clustersEnabled) {
+                const SoulsEngine::ClusterStats& clusterStats = lightClusters.GetStats();
+                ImGui::Text("Lights: %u / %u visible, max %u per cluster", clusterStats.visibleLights,
+                            clusterStats.lights, clusterStats.maxLightsPerCluster);
+            }
+            ImGui::Text("Renderer: %s", deferredFrame ? "Deferred" : "Forward");
+            const SoulsEngine::ShaderVariantStats& variantStats = worldShaders.GetStats();
+            ImGui::Text("Shader: %s (%u variants, %.1f ms)", worldVariantKey.c_str(),
+                        variantStats.variants, variantStats.compileMs);
+            ImGui::Text("GPU: forward %.2f ms, deferred %.2f + %.2f ms", forwardTimer.GetMilliseconds(),
+                        geometryTimer.GetMilliseconds(), lightingTimer.GetMilliseconds());
+            const SoulsEngine::GeometryArenaStats arenaStats = SoulsEngine::GeometryArena::Get().GetStats();
+            ImGui::Text("Geometry: %u meshes, %u / %u KB", arenaStats.allocations,
+                        (arenaStats.vertexBytesUsed + arenaStats.indexBytesUsed) / 1024,
+                        (arenaStats.vertexBytesCapacity + arenaStats.indexBytesCapacity) / 1024);
+            if (shadowsEnabled) {
+                ImGui::Text("Shadows: %s, %d cascades @ %u", shadowPresets[shadowPreset].name,
+                            shadowMap.GetCascadeCount(), shadowMap.GetResolution());
+                uint32_t casters = 0;
+                int cachedCascades = 0;
+                for (int i = 0; i < shadowMap.GetCascadeCount(); ++i) {
+                    casters += shadowMap.GetCascadeStats(i).visible;
+                    if (shadowMap.IsCascadeCacheRebuilt(i)) {
+                        casters += shadowMap.GetCascadeStaticStats(i).visible;
+                    } else {
+                        cachedCascades++;
+                    }
+                }
+                if (shadowMap.GetSettings().cacheStatic) {
+                    ImGui::Text("Shadow casters: %u drawn, %d / %d cached", casters, cachedCascades, shadowMap.GetCascadeCount());
+                } else {
+                    ImGui::Text("Shadow casters: %u drawn, cache off", casters);
+                }
+            } else {
+                ImGui::Text("Shadows: off");
+            }
+
             ImGui::Separator();
             ImGui::Text("Controls:");
             ImGui::BulletText("WASD - Move");
@@ -513,6 +875,13 @@ int main() {
             ImGui::BulletText("Mouse - Rotate view");
             ImGui::BulletText("Right-click - Zoom");
             ImGui::BulletText("Left-click - Shoot");
+            ImGui::BulletText("K - Shadow quality");
+            ImGui::BulletText("L - Shadow caching");
+            ImGui::BulletText("N - Light field (256 lights)");
+            ImGui::BulletText("M - Forward / deferred");
+            ImGui::BulletText("I - Multi-draw indirect");
+            ImGui::BulletText("G - GPU culling");
+            ImGui::BulletText("B - Static batching");
             ImGui::BulletText("ESC - Exit");
             
             ImGui::End();
@@ -544,6 +913,7 @@ int main() {
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
     objectManager.Clear();
+    SoulsEngine::GeometryArena::Get().Shutdown();
 
     std::cout << "Game ended, closing..." << std::endl;
     
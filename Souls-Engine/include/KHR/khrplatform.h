@@ -39,6 +39,7 @@
  */
 
 #include <stddef.h>
+#include <stdint.h>
 
 #if defined(_WIN32) && !defined(APIENTRY) && !defined(__CYGWIN__) && !defined(__SCITECH_SNAP__)
 #ifndef WIN32_LEAN_AND_MEAN
@@ -69,8 +70,10 @@ typedef short        GLshort;
 typedef unsigned char GLubyte;
 typedef unsigned short GLushort;
 typedef unsigned int GLuint;
-typedef int          GLsizeiptr;
-typedef int          GLintptr;
+typedef ptrdiff_t    GLsizeiptr;
+typedef ptrdiff_t    GLintptr;
+typedef int64_t      GLint64;
+typedef uint64_t     GLuint64;
 typedef void*        (*GLADloadproc)(const char *name);
 typedef void*        GLADapiproc;
 typedef void*        (*GLADloadfunc)(void *userptr, const char *name);
@@ -37,6 +37,7 @@ typedef char GLchar;
 typedef const GLubyte* (*PFNGLGETSTRINGPROC)(GLenum name);
 typedef void (*PFNGLCLEARCOLORPROC)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
 typedef void (*PFNGLCLEARPROC)(GLbitfield mask);
+typedef void (*PFNGLFINISHPROC)(void);
 typedef void (*PFNGLVIEWPORTPROC)(GLint x, GLint y, GLsizei width, GLsizei height);
 typedef void (*PFNGLENABLEPROC)(GLenum cap);
 typedef void (*PFNGLDEPTHFUNCPROC)(GLenum func);
@@ -77,10 +78,90 @@ typedef void (*PFNGLDRAWELEMENTSPROC)(GLenum mode, GLsizei count, GLenum type, c
 typedef void (*PFNGLDRAWARRAYSPROC)(GLenum mode, GLint first, GLsizei count);
 typedef GLint (*PFNGLGETATTRIBLOCATIONPROC)(GLuint program, const char* name);
 
+// 实例化绘制相关函数指针类型
+typedef void (*PFNGLDRAWARRAYSINSTANCEDPROC)(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+typedef void (*PFNGLDRAWELEMENTSINSTANCEDPROC)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+typedef void (*PFNGLVERTEXATTRIBDIVISORPROC)(GLuint index, GLuint divisor);
+typedef void (*PFNGLDISABLEVERTEXATTRIBARRAYPROC)(GLuint index);
+
+// Uniform Buffer Object函数指针类型
+typedef void (*PFNGLBUFFERSUBDATAPROC)(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+typedef void (*PFNGLBINDBUFFERBASEPROC)(GLenum target, GLuint index, GLuint buffer);
+typedef GLuint (*PFNGLGETUNIFORMBLOCKINDEXPROC)(GLuint program, const GLchar* uniformBlockName);
+typedef void (*PFNGLUNIFORMBLOCKBINDINGPROC)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+
+// Uniform反射函数指针类型
+typedef void (*PFNGLGETACTIVEUNIFORMPROC)(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+
+// 纹理函数指针类型
+typedef void (*PFNGLGENTEXTURESPROC)(GLsizei n, GLuint* textures);
+typedef void (*PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint* textures);
+typedef void (*PFNGLBINDTEXTUREPROC)(GLenum target, GLuint texture);
+typedef void (*PFNGLACTIVETEXTUREPROC)(GLenum texture);
+typedef void (*PFNGLTEXIMAGE2DPROC)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+typedef void (*PFNGLTEXIMAGE3DPROC)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels);
+typedef void (*PFNGLTEXPARAMETERIPROC)(GLenum target, GLenum pname, GLint param);
+typedef void (*PFNGLTEXPARAMETERFVPROC)(GLenum target, GLenum pname, const GLfloat* params);
+typedef void (*PFNGLGENERATEMIPMAPPROC)(GLenum target);
+
+// 帧缓冲函数指针类型
+typedef void (*PFNGLGENFRAMEBUFFERSPROC)(GLsizei n, GLuint* framebuffers);
+typedef void (*PFNGLDELETEFRAMEBUFFERSPROC)(GLsizei n, const GLuint* framebuffers);
+typedef void (*PFNGLBINDFRAMEBUFFERPROC)(GLenum target, GLuint framebuffer);
+typedef void (*PFNGLFRAMEBUFFERTEXTURE2DPROC)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+typedef void (*PFNGLFRAMEBUFFERTEXTURELAYERPROC)(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer);
+typedef GLenum (*PFNGLCHECKFRAMEBUFFERSTATUSPROC)(GLenum target);
+typedef void (*PFNGLDRAWBUFFERPROC)(GLenum buf);
+typedef void (*PFNGLREADBUFFERPROC)(GLenum src);
+
+// 光栅化状态函数指针类型
+typedef void (*PFNGLDISABLEPROC)(GLenum cap);
+typedef void (*PFNGLCULLFACEPROC)(GLenum mode);
+typedef void (*PFNGLPOLYGONOFFSETPROC)(GLfloat factor, GLfloat units);
+typedef void (*PFNGLGETINTEGERVPROC)(GLenum pname, GLint* data);
+
+// 帧缓冲拷贝函数指针类型
+typedef void (*PFNGLBLITFRAMEBUFFERPROC)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+
+// 纹理缓冲函数指针类型
+typedef void (*PFNGLTEXBUFFERPROC)(GLenum target, GLenum internalformat, GLuint buffer);
+
+// 多渲染目标函数指针类型
+typedef void (*PFNGLDRAWBUFFERSPROC)(GLsizei n, const GLenum* bufs);
+typedef void (*PFNGLDEPTHMASKPROC)(GLboolean flag);
+
+// 计时查询函数指针类型
+typedef void (*PFNGLGENQUERIESPROC)(GLsizei n, GLuint* ids);
+typedef void (*PFNGLDELETEQUERIESPROC)(GLsizei n, const GLuint* ids);
+typedef void (*PFNGLBEGINQUERYPROC)(GLenum target, GLuint id);
+typedef void (*PFNGLENDQUERYPROC)(GLenum target);
+typedef void (*PFNGLGETQUERYOBJECTIVPROC)(GLuint id, GLenum pname, GLint* params);
+typedef void (*PFNGLGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, GLuint64* params);
+
+// 状态查询函数指针类型
+typedef void (*PFNGLCLEARBUFFERFVPROC)(GLenum buffer, GLint drawbuffer, const GLfloat *value);
+typedef GLboolean (*PFNGLISENABLEDPROC)(GLenum cap);
+typedef void (*PFNGLGETBOOLEANVPROC)(GLenum pname, GLboolean *data);
+
+// 基准顶点绘制函数指针类型
+typedef void (*PFNGLDRAWELEMENTSBASEVERTEXPROC)(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+typedef void (*PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC)(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex);
+typedef void (*PFNGLCOPYBUFFERSUBDATAPROC)(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+
+// 间接绘制函数指针类型
+typedef void (*PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride);
+
+// 计算着色器函数指针类型
+typedef void (*PFNGLDISPATCHCOMPUTEPROC)(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+typedef void (*PFNGLMEMORYBARRIERPROC)(GLbitfield barriers);
+typedef void (*PFNGLBINDIMAGETEXTUREPROC)(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
+typedef void (*PFNGLGETBUFFERSUBDATAPROC)(GLenum target, GLintptr offset, GLsizeiptr size, void *data);
+
 // OpenGL函数声明
 GLAPI const GLubyte* glGetString(GLenum name);
 GLAPI void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
 GLAPI void glClear(GLbitfield mask);
+GLAPI void glFinish(void);
 GLAPI void glViewport(GLint x, GLint y, GLsizei width, GLsizei height);
 GLAPI void glEnable(GLenum cap);
 GLAPI void glDepthFunc(GLenum func);
@@ -121,6 +202,85 @@ GLAPI void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* i
 GLAPI void glDrawArrays(GLenum mode, GLint first, GLsizei count);
 GLAPI GLint glGetAttribLocation(GLuint program, const char* name);
 
+// 实例化绘制相关函数声明
+GLAPI void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+GLAPI void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+GLAPI void glVertexAttribDivisor(GLuint index, GLuint divisor);
+GLAPI void glDisableVertexAttribArray(GLuint index);
+
+// Uniform Buffer Object函数声明
+GLAPI void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+GLAPI void glBindBufferBase(GLenum target, GLuint index, GLuint buffer);
+GLAPI GLuint glGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName);
+GLAPI void glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+
+// Uniform反射函数声明
+GLAPI void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+
+// 纹理函数声明
+GLAPI void glGenTextures(GLsizei n, GLuint* textures);
+GLAPI void glDeleteTextures(GLsizei n, const GLuint* textures);
+GLAPI void glBindTexture(GLenum target, GLuint texture);
+GLAPI void glActiveTexture(GLenum texture);
+GLAPI void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+GLAPI void glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels);
+GLAPI void glTexParameteri(GLenum target, GLenum pname, GLint param);
+GLAPI void glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params);
+GLAPI void glGenerateMipmap(GLenum target);
+
+// 帧缓冲函数声明
+GLAPI void glGenFramebuffers(GLsizei n, GLuint* framebuffers);
+GLAPI void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+GLAPI void glBindFramebuffer(GLenum target, GLuint framebuffer);
+GLAPI void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+GLAPI void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer);
+GLAPI GLenum glCheckFramebufferStatus(GLenum target);
+GLAPI void glDrawBuffer(GLenum buf);
+GLAPI void glReadBuffer(GLenum src);
+
+// 光栅化状态函数声明
+GLAPI void glDisable(GLenum cap);
+GLAPI void glCullFace(GLenum mode);
+GLAPI void glPolygonOffset(GLfloat factor, GLfloat units);
+GLAPI void glGetIntegerv(GLenum pname, GLint* data);
+
+// 帧缓冲拷贝函数声明
+GLAPI void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+
+// 纹理缓冲函数声明
+GLAPI void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer);
+
+// 多渲染目标函数声明
+GLAPI void glDrawBuffers(GLsizei n, const GLenum* bufs);
+GLAPI void glDepthMask(GLboolean flag);
+
+// 计时查询函数声明
+GLAPI void glGenQueries(GLsizei n, GLuint* ids);
+GLAPI void glDeleteQueries(GLsizei n, const GLuint* ids);
+GLAPI void glBeginQuery(GLenum target, GLuint id);
+GLAPI void glEndQuery(GLenum target);
+GLAPI void glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params);
+GLAPI void glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params);
+
+// 状态查询函数声明
+GLAPI void glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat *value);
+GLAPI GLboolean glIsEnabled(GLenum cap);
+GLAPI void glGetBooleanv(GLenum pname, GLboolean *data);
+
+// 基准顶点绘制函数声明
+GLAPI void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+GLAPI void glDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex);
+GLAPI void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+
+// 间接绘制函数声明
+GLAPI void glMultiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride);
+
+// 计算着色器函数声明
+GLAPI void glDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+GLAPI void glMemoryBarrier(GLbitfield barriers);
+GLAPI void glBindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
+GLAPI void glGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void *data);
+
 // OpenGL常量
 #define GL_VENDOR                         0x1F00
 #define GL_RENDERER                       0x1F01
@@ -142,8 +302,123 @@ GLAPI GLint glGetAttribLocation(GLuint program, const char* name);
 #define GL_ELEMENT_ARRAY_BUFFER           0x8893
 #define GL_STATIC_DRAW                    0x88E4
 #define GL_TRIANGLES                      0x0004
+#define GL_UNSIGNED_BYTE                  0x1401
+#define GL_SHORT                          0x1402
+#define GL_UNSIGNED_SHORT                 0x1403
 #define GL_UNSIGNED_INT                   0x1405
 #define GL_FLOAT                          0x1406
+#define GL_HALF_FLOAT                     0x140B
+#define GL_INT_2_10_10_10_REV             0x8D9F
+
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_DYNAMIC_DRAW                   0x88E8
+
+#define GL_UNIFORM_BUFFER                 0x8A11
+#define GL_INVALID_INDEX                  0xFFFFFFFFu
+
+#define GL_ACTIVE_UNIFORMS                0x8B86
+#define GL_ACTIVE_UNIFORM_MAX_LENGTH      0x8B87
+#define GL_INT                            0x1404
+#define GL_FLOAT_VEC2                     0x8B50
+#define GL_FLOAT_VEC3                     0x8B51
+#define GL_FLOAT_VEC4                     0x8B52
+#define GL_BOOL                           0x8B56
+#define GL_FLOAT_MAT3                     0x8B5B
+#define GL_FLOAT_MAT4                     0x8B5C
+#define GL_SAMPLER_2D                     0x8B5E
+#define GL_SAMPLER_2D_SHADOW              0x8B62
+
+#define GL_TEXTURE_2D                     0x0DE1
+#define GL_TEXTURE_2D_ARRAY               0x8C1A
+#define GL_TEXTURE0                       0x84C0
+#define GL_TEXTURE_MAG_FILTER             0x2800
+#define GL_TEXTURE_MIN_FILTER             0x2801
+#define GL_TEXTURE_WRAP_S                 0x2802
+#define GL_TEXTURE_WRAP_T                 0x2803
+#define GL_TEXTURE_WRAP_R                 0x8072
+#define GL_TEXTURE_BORDER_COLOR           0x1004
+#define GL_TEXTURE_COMPARE_MODE           0x884C
+#define GL_TEXTURE_COMPARE_FUNC           0x884D
+#define GL_COMPARE_REF_TO_TEXTURE         0x884E
+#define GL_NEAREST                        0x2600
+#define GL_LINEAR                         0x2601
+#define GL_LINEAR_MIPMAP_LINEAR           0x2703
+#define GL_REPEAT                         0x2901
+#define GL_CLAMP_TO_EDGE                  0x812F
+#define GL_CLAMP_TO_BORDER                0x812D
+#define GL_LEQUAL                         0x0203
+#define GL_RED                            0x1903
+#define GL_RGB                            0x1907
+#define GL_RGBA                           0x1908
+#define GL_RGBA8                          0x8058
+#define GL_DEPTH_COMPONENT                0x1902
+#define GL_DEPTH_COMPONENT24              0x81A6
+#define GL_DEPTH_COMPONENT32F             0x8CAC
+#define GL_SAMPLER_2D_ARRAY_SHADOW        0x8DC4
+
+#define GL_FRAMEBUFFER                    0x8D40
+#define GL_DEPTH_ATTACHMENT               0x8D00
+#define GL_COLOR_ATTACHMENT0              0x8CE0
+#define GL_FRAMEBUFFER_COMPLETE           0x8CD5
+#define GL_NONE                           0
+
+#define GL_CULL_FACE                      0x0B44
+#define GL_FRONT                          0x0404
+#define GL_BACK                           0x0405
+#define GL_POLYGON_OFFSET_FILL            0x8037
+#define GL_VIEWPORT                       0x0BA2
+#define GL_FRAMEBUFFER_BINDING            0x8CA6
+#define GL_CURRENT_PROGRAM                0x8B8D
+
+#define GL_READ_FRAMEBUFFER               0x8CA8
+#define GL_DRAW_FRAMEBUFFER               0x8CA9
+
+#define GL_TEXTURE_BUFFER                 0x8C2A
+#define GL_RGBA32F                        0x8814
+#define GL_RG32UI                         0x823C
+#define GL_R32UI                          0x8236
+#define GL_SAMPLER_BUFFER                 0x8DC2
+#define GL_UNSIGNED_INT_SAMPLER_BUFFER    0x8DD8
+
+#define GL_COLOR_ATTACHMENT1              0x8CE1
+#define GL_COLOR_ATTACHMENT2              0x8CE2
+#define GL_COLOR_ATTACHMENT3              0x8CE3
+#define GL_RGBA16F                        0x881A
+#define GL_DEPTH24_STENCIL8               0x88F0
+#define GL_DEPTH_STENCIL                  0x84F9
+#define GL_UNSIGNED_INT_24_8              0x84FA
+#define GL_DEPTH_STENCIL_ATTACHMENT       0x821A
+
+#define GL_TIME_ELAPSED                   0x88BF
+#define GL_QUERY_RESULT                   0x8866
+#define GL_QUERY_RESULT_AVAILABLE         0x8867
+
+#define GL_DEPTH_WRITEMASK                0x0B72
+#define GL_COLOR                          0x1800
+#define GL_DEPTH                          0x1801
+
+#define GL_COPY_READ_BUFFER               0x8F36
+#define GL_COPY_WRITE_BUFFER              0x8F37
+
+#define GL_DRAW_INDIRECT_BUFFER           0x8F3F
+#define GL_MAJOR_VERSION                  0x821B
+#define GL_MINOR_VERSION                  0x821C
+
+#define GL_COMPUTE_SHADER                 0x91B9
+#define GL_SHADER_STORAGE_BUFFER          0x90D2
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#define GL_TEXTURE_FETCH_BARRIER_BIT      0x00000008
+#define GL_SHADER_IMAGE_ACCESS_BARRIER_BIT 0x00000020
+#define GL_COMMAND_BARRIER_BIT            0x00000040
+#define GL_BUFFER_UPDATE_BARRIER_BIT      0x00000200
+#define GL_SHADER_STORAGE_BARRIER_BIT     0x00002000
+#define GL_READ_ONLY                      0x88B8
+#define GL_WRITE_ONLY                     0x88B9
+#define GL_R32F                           0x822E
+#define GL_TEXTURE_BASE_LEVEL             0x813C
+#define GL_TEXTURE_MAX_LEVEL              0x813D
+#define GL_STREAM_READ                    0x88E1
+#define GL_NEAREST_MIPMAP_NEAREST         0x2700
 
 #ifdef __cplusplus
 }
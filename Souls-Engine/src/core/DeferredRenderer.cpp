@@ -0,0 +1,168 @@
+#include "DeferredRenderer.h"
+#include "Shader.h"
+#include <iostream>
+
+namespace SoulsEngine {
+
+namespace {
+    // 颜色附件的内部格式（顺序与DeferredRenderer::Target一致）
+    const GLint TargetFormats[DeferredRenderer::TargetCount] = { GL_RGBA8, GL_RGBA8, GL_RGBA16F, GL_RGBA8 };
+
+    // 创建width x height的二维纹理（最近点过滤，光照通道按像素读取）
+    GLuint CreateTexture(int width, int height, GLint internalFormat, GLenum format, GLenum type) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+}
+
+DeferredRenderer::~DeferredRenderer() {
+    Shutdown();
+}
+
+bool DeferredRenderer::Initialize(int width, int height) {
+    Shutdown();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // 之后恢复调用方的帧缓冲
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    for (int i = 0; i < TargetCount; ++i) {
+        const GLenum type = TargetFormats[i] == GL_RGBA16F ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+        m_colorTextures[i] = CreateTexture(width, height, TargetFormats[i], GL_RGBA, type);
+    }
+    m_depthTexture = CreateTexture(width, height, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    GLenum drawBuffers[TargetCount];
+    for (int i = 0; i < TargetCount; ++i) {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, m_colorTextures[i], 0);
+        drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+    }
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+    glDrawBuffers(TargetCount, drawBuffers);
+
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    if (!complete) {
+        std::cerr << "ERROR::DEFERRED:: G-buffer framebuffer is not complete!" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    glGenVertexArrays(1, &m_emptyVAO);
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+void DeferredRenderer::Shutdown() {
+    if (m_framebuffer != 0) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    for (GLuint& texture : m_colorTextures) {
+        if (texture != 0) {
+            glDeleteTextures(1, &texture);
+            texture = 0;
+        }
+    }
+    if (m_depthTexture != 0) {
+        glDeleteTextures(1, &m_depthTexture);
+        m_depthTexture = 0;
+    }
+    if (m_emptyVAO != 0) {
+        glDeleteVertexArrays(1, &m_emptyVAO);
+        m_emptyVAO = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+bool DeferredRenderer::Resize(int width, int height) {
+    if (m_framebuffer != 0 && width == m_width && height == m_height) {
+        return true;
+    }
+    return Initialize(width, height);
+}
+
+void DeferredRenderer::BeginGeometryPass() {
+    if (m_framebuffer == 0) return;
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, m_previousViewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+
+    // 所有目标清零（不改变调用方的清屏颜色），深度清为最远
+    const GLfloat zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const GLfloat farDepth = 1.0f;
+    for (int i = 0; i < TargetCount; ++i) {
+        glClearBufferfv(GL_COLOR, i, zero);
+    }
+    glClearBufferfv(GL_DEPTH, 0, &farDepth);
+}
+
+void DeferredRenderer::EndGeometryPass() {
+    if (m_framebuffer == 0) return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_previousFramebuffer));
+    glViewport(m_previousViewport[0], m_previousViewport[1], m_previousViewport[2], m_previousViewport[3]);
+}
+
+void DeferredRenderer::LightingPass(const Shader& lightingShader, const glm::mat4& view, const glm::mat4& projection) {
+    if (m_framebuffer == 0) return;
+
+    BindTextures();
+    lightingShader.Use();
+    lightingShader.Set(lightingShader.GetUniformHandle<glm::mat4>("inverseViewProjection"),
+                       glm::inverse(projection * view));
+
+    // 全屏三角形不做深度测试也不写深度，背景像素（深度为1）在着色器中丢弃
+    const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean depthWrite = GL_TRUE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthWrite);
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+
+    glBindVertexArray(m_emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    glDepthMask(depthWrite);
+    if (depthTest) {
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    // 把几何通道的深度拷贝到当前帧缓冲，之后的前向绘制（线框、武器等）能与场景正确遮挡
+    GLint target = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(target));
+    glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(target));
+}
+
+void DeferredRenderer::BindTextures() const {
+    for (int i = 0; i < TargetCount; ++i) {
+        glActiveTexture(GL_TEXTURE0 + TextureUnit + i);
+        glBindTexture(GL_TEXTURE_2D, m_colorTextures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0 + TextureUnit + TargetCount);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+} // namespace SoulsEngine
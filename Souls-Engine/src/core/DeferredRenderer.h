@@ -0,0 +1,87 @@
+#pragma once
+
+#include "RenderPath.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Shader;
+
+// 延迟渲染 - 几何通道把材质参数写入G-buffer，光照通道对每个像素只计算一次光照，
+// 重叠绘制（overdraw）的片段不再重复计算所有光源
+//
+// G-buffer布局（材质参数与basic.frag的Phong模型一致，都已乘上顶点颜色）：
+//   RT0 RGBA8     rgb: 漫反射 k_d * Color
+//   RT1 RGBA8     rgb: 镜面反射 k_s * Color
+//   RT2 RGBA16F   xy: 八面体编码的世界空间法线，z: 光泽度 n
+//   RT3 RGBA8     rgb: 环境光 I_a * k_a * Color
+//   深度          DEPTH24_STENCIL8（与默认帧缓冲格式相同，光照通道后拷贝回去供后续前向绘制使用）
+// 世界空间位置由深度和逆视图投影矩阵重建，不单独存储
+//
+// 光照通道是一个全屏三角形：启用分簇光照时每个像素只计算所在簇的光源（屏幕瓦片 x 深度切片，见 LightClusters），
+// 否则计算LightData中的所有光源
+//
+// 一帧的流程：
+//   BeginGeometryPass   绑定并清空G-buffer（保存之前的帧缓冲和视口）
+//   绘制不透明物体      使用 basic.vert + gbuffer.frag
+//   EndGeometryPass     恢复之前的帧缓冲和视口
+//   LightingPass        deferred_light.frag写入当前帧缓冲，再把G-buffer深度拷贝到当前帧缓冲
+class DeferredRenderer {
+public:
+    // G-buffer使用的纹理单元：TextureUnit开始依次为漫反射、镜面反射、法线、环境光、深度
+    static constexpr GLuint TextureUnit = 8;
+
+    // 颜色附件
+    enum Target {
+        AlbedoTarget = 0,
+        SpecularTarget,
+        NormalTarget,
+        AmbientTarget,
+        TargetCount
+    };
+
+    DeferredRenderer() = default;
+    ~DeferredRenderer();
+
+    // 禁止拷贝（持有GL对象）
+    DeferredRenderer(const DeferredRenderer&) = delete;
+    DeferredRenderer& operator=(const DeferredRenderer&) = delete;
+
+    // 创建指定尺寸的G-buffer（需要有效的OpenGL上下文）
+    bool Initialize(int width, int height);
+    void Shutdown();
+
+    // 尺寸变化时重新创建G-buffer（尺寸相同时不做任何事）
+    bool Resize(int width, int height);
+
+    // 几何通道
+    void BeginGeometryPass();
+    void EndGeometryPass();
+
+    // 光照通道：写入当前帧缓冲（与G-buffer同尺寸），结束后当前帧缓冲的深度与G-buffer相同
+    // view/projection为几何通道使用的相机矩阵
+    void LightingPass(const Shader& lightingShader, const glm::mat4& view, const glm::mat4& projection);
+
+    // 把G-buffer纹理绑定到TextureUnit开始的纹理单元
+    void BindTextures() const;
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    bool IsInitialized() const { return m_framebuffer != 0; }
+
+private:
+    GLuint m_framebuffer = 0;
+    GLuint m_colorTextures[TargetCount] = {};
+    GLuint m_depthTexture = 0;
+    GLuint m_emptyVAO = 0;       // 全屏三角形的顶点由gl_VertexID生成，核心模式仍需要绑定VAO
+    int m_width = 0;
+    int m_height = 0;
+
+    // BeginGeometryPass时保存，EndGeometryPass时恢复
+    GLint m_previousFramebuffer = 0;
+    GLint m_previousViewport[4] = {};
+};
+
+} // namespace SoulsEngine
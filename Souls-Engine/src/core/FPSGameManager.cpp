@@ -1,11 +1,9 @@
 #include "FPSGameManager.h"
-#include "../geometry/Disk.h"
+#include "../geometry/MeshLOD.h"
 #include "../geometry/Cube.h"
 #include "Material.h"
 #include <GLFW/glfw3.h>
-#define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtx/intersect.hpp>
 #include <iostream>
 #include <algorithm>
 #include <limits>
@@ -82,6 +80,9 @@ void FPSGameManager::Initialize() {
     
     auto groundMesh = std::make_shared<Cube>(groundSize, groundColor);
     auto ground = m_objectManager->CreateNode("Ground", groundMesh);
+    ground->SetLayer(NodeLayer::Environment);
+    ground->SetOccluder(true);
+    ground->SetStatic(true);
     // 地面位置：y = -groundHeight/2，这样地面顶部在y=0
     ground->SetPosition(0.0f, -groundHeight / 2.0f, 0.0f);
     ground->SetScale(1.0f, groundHeight / groundSize, 1.0f);  // 缩放高度
@@ -321,13 +322,13 @@ void FPSGameManager::ProcessShoot(int windowWidth, int windowHeight) {
     glm::vec3 cameraFront = m_camera->GetFront();
     glm::vec3 rayDirection = glm::normalize(cameraFront);
 
-    // Perform raycast
-    std::shared_ptr<SceneNode> hitNode = Raycast(rayOrigin, rayDirection, 100.0f);
+    // Perform raycast (ground, walls and the weapon can't be shot)
+    SceneNode* hitNode = Raycast(rayOrigin, rayDirection, 100.0f, ~(NodeLayer::Environment | NodeLayer::ViewModel));
 
     if (hitNode) {
         // Find hit target
         for (auto& target : m_targets) {
-            if (target.node == hitNode && target.isActive) {
+            if (target.node.get() == hitNode && target.isActive) {
                 // Calculate intersection point between ray and disk plane
                 glm::vec3 targetPos = target.position;
                 glm::mat4 targetTransform = target.node->GetWorldTransform();
@@ -345,6 +346,11 @@ void FPSGameManager::ProcessShoot(int windowWidth, int windowHeight) {
                         hitPoint = rayOrigin + rayDirection * t;
                     }
                 }
+
+                // The raycast tests the disk's bounding square; shots through its corners miss
+                if (glm::length(hitPoint - target.position) > target.radius) {
+                    break;
+                }
                 
                 // Check if hit center
                 bool hitCenter = IsHitCenter(hitPoint, target.position, target.radius);
@@ -365,44 +371,13 @@ void FPSGameManager::ProcessShoot(int windowWidth, int windowHeight) {
     }
 }
 
-std::shared_ptr<SceneNode> FPSGameManager::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
-    std::shared_ptr<SceneNode> closestNode = nullptr;
-    float closestDistance = maxDistance;
-
-    // Get all nodes
-    auto allNodes = m_objectManager->GetAllNodes();
-
-    for (auto& node : allNodes) {
-        if (!node) continue;
-        
-        // Skip ground
-        if (node->GetName() == "Ground") continue;
-        
-        // Skip walls (all wall names start with "Wall_")
-        std::string nodeName = node->GetName();
-        if (nodeName.find("Wall_") == 0) continue;
-        
-        // Skip weapon nodes (they shouldn't be shot)
-        if (nodeName.find("Weapon") == 0) continue;
-
-        // Get node world transform
-        glm::mat4 worldTransform = node->GetWorldTransform();
-        glm::vec3 nodePos = glm::vec3(worldTransform[3]);
-        glm::vec3 scale = node->GetScale();
-
-        // Simplified ray-sphere intersection (assuming targets are disks, approximated as spheres)
-        float targetRadius = (std::max)(scale.x, scale.y) * 0.5f;  // Use larger scale value as radius
-        
-        float t;
-        if (glm::intersectRaySphere(origin, direction, nodePos, targetRadius * targetRadius, t)) {
-            if (t > 0.0f && t < closestDistance) {
-                closestDistance = t;
-                closestNode = node;
-            }
-        }
+SceneNode* FPSGameManager::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, uint32_t layerMask) const {
+    // Closest hit through the object manager's BVH; leaves test the node's oriented mesh bounds
+    RayHit hit;
+    if (m_objectManager->Raycast(origin, direction, maxDistance, layerMask, hit)) {
+        return hit.node;
     }
-
-    return closestNode;
+    return nullptr;
 }
 
 bool FPSGameManager::IsHitCenter(const glm::vec3& hitPoint, const glm::vec3& targetCenter, float targetRadius) const {
@@ -423,8 +398,13 @@ void FPSGameManager::SpawnTarget() {
 
     // Create disk target (red)
     float targetRadius = 1.0f;
-    auto targetMesh = std::make_shared<Disk>(targetRadius, 36, glm::vec3(1.0f, 0.0f, 0.0f));  // Red
-    auto targetNode = m_objectManager->CreateNode("Target_" + std::to_string(m_nextTargetId), targetMesh);
+    if (!m_targetLOD) {
+        // Targets share one set of disk meshes (36 down to 6 segments), so targets at the same
+        // level of detail are still drawn as one instanced batch
+        m_targetLOD = MeshLOD::CreateDisk(targetRadius, glm::vec3(1.0f, 0.0f, 0.0f));  // Red
+    }
+    auto targetNode = m_objectManager->CreateNode("Target_" + std::to_string(m_nextTargetId), nullptr);
+    targetNode->SetMeshLOD(m_targetLOD);
     targetNode->SetPosition(position);
     
     // Rotate target to face camera direction (make target face player initial position)
@@ -493,6 +473,9 @@ void FPSGameManager::CreateWalls() {
     // Wall colors (different color for better visibility)
     glm::vec3 wallColor(0.5f, 0.5f, 0.6f);
     
+    // All walls share one unit cube (scaled per wall) so they can be drawn as one instanced batch
+    auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
+
     // Create very rough material for walls (very low shininess = very rough surface)
     // Very rough materials have minimal shininess (1-2) and almost no specular reflection
     auto wallMaterial = std::make_shared<Material>();
@@ -509,8 +492,10 @@ void FPSGameManager::CreateWalls() {
         wall.min = wall.position - wall.size * 0.5f;
         wall.max = wall.position + wall.size * 0.5f;
         
-        auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
         wall.node = m_objectManager->CreateNode("Wall_North", wallMesh);
+        wall.node->SetLayer(NodeLayer::Environment);
+        wall.node->SetOccluder(true);
+        wall.node->SetStatic(true);
         wall.node->SetPosition(wall.position);
         wall.node->SetScale(wall.size.x, wall.size.y, wall.size.z);
         // Apply rough material to wall
@@ -530,8 +515,10 @@ void FPSGameManager::CreateWalls() {
         wall.min = wall.position - wall.size * 0.5f;
         wall.max = wall.position + wall.size * 0.5f;
         
-        auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
         wall.node = m_objectManager->CreateNode("Wall_South", wallMesh);
+        wall.node->SetLayer(NodeLayer::Environment);
+        wall.node->SetOccluder(true);
+        wall.node->SetStatic(true);
         wall.node->SetPosition(wall.position);
         wall.node->SetScale(wall.size.x, wall.size.y, wall.size.z);
         // Apply rough material to wall
@@ -551,8 +538,10 @@ void FPSGameManager::CreateWalls() {
         wall.min = wall.position - wall.size * 0.5f;
         wall.max = wall.position + wall.size * 0.5f;
         
-        auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
         wall.node = m_objectManager->CreateNode("Wall_East", wallMesh);
+        wall.node->SetLayer(NodeLayer::Environment);
+        wall.node->SetOccluder(true);
+        wall.node->SetStatic(true);
         wall.node->SetPosition(wall.position);
         wall.node->SetScale(wall.size.x, wall.size.y, wall.size.z);
         // Apply rough material to wall
@@ -572,8 +561,10 @@ void FPSGameManager::CreateWalls() {
         wall.min = wall.position - wall.size * 0.5f;
         wall.max = wall.position + wall.size * 0.5f;
         
-        auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
         wall.node = m_objectManager->CreateNode("Wall_West", wallMesh);
+        wall.node->SetLayer(NodeLayer::Environment);
+        wall.node->SetOccluder(true);
+        wall.node->SetStatic(true);
         wall.node->SetPosition(wall.position);
         wall.node->SetScale(wall.size.x, wall.size.y, wall.size.z);
         // Apply rough material to wall
@@ -594,8 +585,10 @@ void FPSGameManager::CreateWalls() {
         wall.min = wall.position - wall.size * 0.5f;
         wall.max = wall.position + wall.size * 0.5f;
         
-        auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
         wall.node = m_objectManager->CreateNode("Wall_Internal_1", wallMesh);
+        wall.node->SetLayer(NodeLayer::Environment);
+        wall.node->SetOccluder(true);
+        wall.node->SetStatic(true);
         wall.node->SetPosition(wall.position);
         wall.node->SetScale(wall.size.x, wall.size.y, wall.size.z);
         // Apply rough material to wall
@@ -615,8 +608,10 @@ void FPSGameManager::CreateWalls() {
         wall.min = wall.position - wall.size * 0.5f;
         wall.max = wall.position + wall.size * 0.5f;
         
-        auto wallMesh = std::make_shared<Cube>(1.0f, wallColor);
         wall.node = m_objectManager->CreateNode("Wall_Internal_2", wallMesh);
+        wall.node->SetLayer(NodeLayer::Environment);
+        wall.node->SetOccluder(true);
+        wall.node->SetStatic(true);
         wall.node->SetPosition(wall.position);
         wall.node->SetScale(wall.size.x, wall.size.y, wall.size.z);
         // Apply rough material to wall
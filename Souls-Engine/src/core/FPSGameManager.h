@@ -64,8 +64,8 @@ private:
     // Spawn target
     void SpawnTarget();
 
-    // Raycast (for shooting detection)
-    std::shared_ptr<SceneNode> Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+    // Raycast (for shooting detection), only nodes in layerMask are tested
+    SceneNode* Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, uint32_t layerMask) const;
 
     // Check if hit target center (small range)
     bool IsHitCenter(const glm::vec3& hitPoint, const glm::vec3& targetCenter, float targetRadius) const;
@@ -88,6 +88,7 @@ private:
     // Game objects
     std::vector<Target> m_targets;
     std::vector<Wall> m_walls;
+    std::shared_ptr<MeshLOD> m_targetLOD;  // Shared by all targets (tessellation picked per target by screen size)
 
     // Game state
     int m_score;
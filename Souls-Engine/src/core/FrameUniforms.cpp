@@ -0,0 +1,238 @@
+#include "FrameUniforms.h"
+#include "Light.h"
+#include "ShadowMap.h"
+#include "LightClusters.h"
+#include "DeferredRenderer.h"
+#include "HiZBuffer.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace SoulsEngine {
+
+// 与std140布局逐字节对应
+static_assert(sizeof(FrameUniforms::FrameData) == 160, "FrameData必须与std140布局一致");
+static_assert(offsetof(FrameUniforms::FrameData, viewPos) == 128, "FrameData必须与std140布局一致");
+static_assert(sizeof(FrameUniforms::LightEntry) == 48, "Light数组步长必须为48字节");
+static_assert(offsetof(FrameUniforms::LightEntry, color) == 16, "LightEntry必须与std140布局一致");
+static_assert(offsetof(FrameUniforms::LightData, numLights) == 48 * FrameUniforms::MaxLights, "LightData必须与std140布局一致");
+static_assert(offsetof(FrameUniforms::ShadowData, cascadeCount) == 64 * FrameUniforms::MaxCascades + 48, "ShadowData必须与std140布局一致");
+static_assert(FrameUniforms::MaxCascades == ShadowMap::MaxCascades, "级联数量上限必须一致");
+static_assert(sizeof(FrameUniforms::ClusterData) == 64, "ClusterData必须与std140布局一致");
+
+namespace {
+    const char* const FrameBlockName = "FrameData";
+    const char* const LightBlockName = "LightData";
+    const char* const ShadowBlockName = "ShadowData";
+    const char* const ClusterBlockName = "ClusterData";
+
+    // 采样器名称和纹理单元
+    struct SamplerBinding {
+        const char* name;
+        GLuint unit;
+    };
+    const SamplerBinding SamplerBindings[] = {
+        { "shadowMap", ShadowMap::TextureUnit },
+        { "clusterLights", LightClusters::TextureUnit },
+        { "clusterRanges", LightClusters::TextureUnit + 1 },
+        { "clusterLightIndices", LightClusters::TextureUnit + 2 },
+        { "gAlbedo", DeferredRenderer::TextureUnit + DeferredRenderer::AlbedoTarget },
+        { "gSpecular", DeferredRenderer::TextureUnit + DeferredRenderer::SpecularTarget },
+        { "gNormal", DeferredRenderer::TextureUnit + DeferredRenderer::NormalTarget },
+        { "gAmbient", DeferredRenderer::TextureUnit + DeferredRenderer::AmbientTarget },
+        { "gDepth", DeferredRenderer::TextureUnit + DeferredRenderer::TargetCount },
+        { "hiZ", HiZBuffer::TextureUnit },
+        { "hiZSourceDepth", HiZBuffer::TextureUnit + 1 }
+    };
+}
+
+FrameUniforms::FrameUniforms() {
+    m_frameData.globalAmbient = glm::vec4(0.2f, 0.2f, 0.2f, 0.0f);
+}
+
+FrameUniforms::~FrameUniforms() {
+    Shutdown();
+}
+
+bool FrameUniforms::Initialize() {
+    if (m_frameBuffer != 0) {
+        return true;
+    }
+
+    glGenBuffers(1, &m_frameBuffer);
+    glGenBuffers(1, &m_lightBuffer);
+    glGenBuffers(1, &m_shadowBuffer);
+    glGenBuffers(1, &m_clusterBuffer);
+    if (m_frameBuffer == 0 || m_lightBuffer == 0 || m_shadowBuffer == 0 || m_clusterBuffer == 0) {
+        std::cerr << "Failed to create frame uniform buffers" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    // 分配存储并绑定到固定绑定点，之后每帧只更新内容
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_lightBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_shadowBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(ShadowData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_clusterBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(ClusterData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, FrameBinding, m_frameBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, LightBinding, m_lightBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, ShadowBinding, m_shadowBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, ClusterBinding, m_clusterBuffer);
+
+    m_frameDirty = true;
+    m_lightDirty = true;
+    m_shadowDirty = true;
+    m_clusterDirty = true;
+    return true;
+}
+
+void FrameUniforms::Shutdown() {
+    if (m_frameBuffer != 0) {
+        glDeleteBuffers(1, &m_frameBuffer);
+        m_frameBuffer = 0;
+    }
+    if (m_lightBuffer != 0) {
+        glDeleteBuffers(1, &m_lightBuffer);
+        m_lightBuffer = 0;
+    }
+    if (m_shadowBuffer != 0) {
+        glDeleteBuffers(1, &m_shadowBuffer);
+        m_shadowBuffer = 0;
+    }
+    if (m_clusterBuffer != 0) {
+        glDeleteBuffers(1, &m_clusterBuffer);
+        m_clusterBuffer = 0;
+    }
+}
+
+void FrameUniforms::SetCamera(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos) {
+    m_frameData.view = view;
+    m_frameData.projection = projection;
+    m_frameData.viewPos = glm::vec4(viewPos, 1.0f);
+    m_frameDirty = true;
+}
+
+void FrameUniforms::SetGlobalAmbient(const glm::vec3& ambient) {
+    m_frameData.globalAmbient = glm::vec4(ambient, 0.0f);
+    m_frameDirty = true;
+}
+
+void FrameUniforms::SetAttenuation(float constant, float linear, float quadratic) {
+    m_constant = constant;
+    m_linear = linear;
+    m_quadratic = quadratic;
+}
+
+void FrameUniforms::SetLights(const std::vector<std::shared_ptr<Light>>& lights) {
+    int count = std::min(static_cast<int>(lights.size()), MaxLights);
+    for (int i = 0; i < count; ++i) {
+        const Light& light = *lights[i];
+        LightEntry& entry = m_lightData.lights[i];
+        entry.position = light.GetPosition();
+        entry.intensity = light.GetIntensity();
+        entry.color = light.GetColor();
+        entry.constant = m_constant;
+        entry.linear = m_linear;
+        entry.quadratic = m_quadratic;
+    }
+    m_lightData.numLights = count;
+    m_lightDirty = true;
+}
+
+void FrameUniforms::SetShadows(const ShadowMap* shadowMap) {
+    if (!shadowMap) {
+        m_shadowData.cascadeCount = 0;
+        m_shadowDirty = true;
+        return;
+    }
+
+    const int count = std::min(shadowMap->GetCascadeCount(), MaxCascades);
+    for (int i = 0; i < count; ++i) {
+        m_shadowData.cascadeMatrices[i] = shadowMap->GetCascadeMatrix(i);
+        m_shadowData.cascadeSplits[i] = shadowMap->GetCascadeSplit(i);
+        m_shadowData.cascadeTexelSizes[i] = shadowMap->GetCascadeTexelSize(i);
+    }
+    m_shadowData.lightDirection = glm::vec4(-shadowMap->GetLightDirection(), 0.0f);
+    m_shadowData.cascadeCount = count;
+    m_shadowDirty = true;
+}
+
+void FrameUniforms::SetLightClusters(const LightClusters* clusters) {
+    if (!clusters) {
+        m_clusterData.grid.w = 0;
+        m_clusterDirty = true;
+        return;
+    }
+
+    m_clusterData.grid = glm::uvec4(LightClusters::GridX, LightClusters::GridY, LightClusters::GridZ, 1);
+    m_clusterData.tileSize = glm::vec4(clusters->GetTileSize(), 0.0f, 0.0f);
+    m_clusterData.depthParams = glm::vec4(clusters->GetDepthScale(), clusters->GetDepthBias(), 0.0f, 0.0f);
+    m_clusterData.attenuation = glm::vec4(clusters->GetAttenuation(), 0.0f);
+    m_clusterDirty = true;
+}
+
+void FrameUniforms::Upload() {
+    if (m_frameDirty && m_frameBuffer != 0) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_frameBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &m_frameData);
+        m_frameDirty = false;
+    }
+    if (m_lightDirty && m_lightBuffer != 0) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_lightBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightData), &m_lightData);
+        m_lightDirty = false;
+    }
+    if (m_shadowDirty && m_shadowBuffer != 0) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_shadowBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ShadowData), &m_shadowData);
+        m_shadowDirty = false;
+    }
+    if (m_clusterDirty && m_clusterBuffer != 0) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_clusterBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ClusterData), &m_clusterData);
+        m_clusterDirty = false;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::BindProgramBlocks(GLuint program) {
+    GLuint frameIndex = glGetUniformBlockIndex(program, FrameBlockName);
+    if (frameIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, frameIndex, FrameBinding);
+    }
+    GLuint lightIndex = glGetUniformBlockIndex(program, LightBlockName);
+    if (lightIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, lightIndex, LightBinding);
+    }
+    GLuint shadowIndex = glGetUniformBlockIndex(program, ShadowBlockName);
+    if (shadowIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, shadowIndex, ShadowBinding);
+    }
+    GLuint clusterIndex = glGetUniformBlockIndex(program, ClusterBlockName);
+    if (clusterIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, clusterIndex, ClusterBinding);
+    }
+
+    // 采样器的纹理单元只能通过glUniform设置，需要临时切换到该程序
+    GLint previousProgram = -1;
+    for (const SamplerBinding& sampler : SamplerBindings) {
+        GLint location = glGetUniformLocation(program, sampler.name);
+        if (location == -1) continue;
+        if (previousProgram == -1) {
+            glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+            glUseProgram(program);
+        }
+        glUniform1i(location, static_cast<GLint>(sampler.unit));
+    }
+    if (previousProgram != -1) {
+        glUseProgram(static_cast<GLuint>(previousProgram));
+    }
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Light;
+class ShadowMap;
+class LightClusters;
+
+// 每帧uniform缓冲 - 相机、光源、阴影和分簇光照参数以std140布局写入四个UBO，绑定在固定的绑定点上，
+// 所有着色器程序共享（Shader链接时把同名uniform块绑定到这些绑定点）
+//
+// 对应的GLSL声明（见 assets/shaders/frame_uniforms.glsl，各着色器通过 #include 共用）：
+//   layout (std140) uniform FrameData { mat4 view; mat4 projection; vec3 viewPos; vec3 globalAmbient; };
+//   layout (std140) uniform LightData { Light lights[MAX_LIGHTS]; int numLights; };
+//   layout (std140) uniform ShadowData { mat4 cascadeMatrices[MAX_CASCADES]; vec4 cascadeSplits;
+//                                        vec4 cascadeTexelSizes; vec4 shadowLightDirection; int cascadeCount; };
+//   layout (std140) uniform ClusterData { uvec4 clusterGrid; vec4 clusterTileSize; vec4 clusterDepthParams;
+//                                         vec4 clusterAttenuation; };
+class FrameUniforms {
+public:
+    // uniform块的绑定点
+    static constexpr GLuint FrameBinding = 0;
+    static constexpr GLuint LightBinding = 1;
+    static constexpr GLuint ShadowBinding = 2;
+    static constexpr GLuint ClusterBinding = 3;
+
+    // 与着色器中的MAX_LIGHTS一致
+    static constexpr int MaxLights = 8;
+
+    // std140布局的FrameData块（vec3按16字节对齐，用vec4保存）
+    struct FrameData {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 viewPos;        // xyz
+        glm::vec4 globalAmbient;  // xyz
+    };
+
+    // std140布局的Light结构（数组步长48字节）
+    struct LightEntry {
+        glm::vec3 position;
+        float intensity;
+        glm::vec3 color;
+        float constant;
+        float linear;
+        float quadratic;
+        float padding[2];
+    };
+
+    struct LightData {
+        LightEntry lights[MaxLights];
+        int numLights;
+        int padding[3];
+    };
+
+    // 与着色器中的MAX_CASCADES一致
+    static constexpr int MaxCascades = 4;
+
+    // std140布局的ShadowData块
+    struct ShadowData {
+        glm::mat4 cascadeMatrices[MaxCascades];
+        glm::vec4 cascadeSplits;       // 每个级联覆盖的最远视图距离
+        glm::vec4 cascadeTexelSizes;   // 每个级联一个纹素的世界空间尺寸（法线偏移用）
+        glm::vec4 lightDirection;      // xyz: 指向光源的方向
+        int cascadeCount;              // 0表示不启用阴影
+        int padding[3];
+    };
+
+    // std140布局的ClusterData块（见 LightClusters）
+    struct ClusterData {
+        glm::uvec4 grid;          // xyz: 簇网格尺寸，w: 1表示启用分簇光照（否则使用LightData中的光源）
+        glm::vec4 tileSize;       // xy: 每个簇的屏幕尺寸（像素）
+        glm::vec4 depthParams;    // x: scale, y: bias，切片 = log(视图深度) * scale + bias
+        glm::vec4 attenuation;    // xyz: constant, linear, quadratic
+    };
+
+    FrameUniforms();
+    ~FrameUniforms();
+
+    // 禁止拷贝（持有GL缓冲）
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+    // 创建缓冲并绑定到固定绑定点（需要有效的OpenGL上下文）
+    bool Initialize();
+    void Shutdown();
+
+    // 相机数据
+    void SetCamera(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+
+    // 全局环境光（默认0.2）
+    void SetGlobalAmbient(const glm::vec3& ambient);
+
+    // 光源距离衰减参数（所有光源共用，默认 1, 0.09, 0.032）
+    void SetAttenuation(float constant, float linear, float quadratic);
+
+    // 写入光源数组，超过MaxLights的光源被忽略
+    void SetLights(const std::vector<std::shared_ptr<Light>>& lights);
+
+    // 写入级联阴影数据（需先ShadowMap::Update），nullptr关闭阴影
+    void SetShadows(const ShadowMap* shadowMap);
+
+    // 写入分簇光照参数（需先LightClusters::Build），启用后片段着色器从簇光源列表取光源，
+    // 不再受MaxLights限制；nullptr时使用SetLights写入的光源
+    void SetLightClusters(const LightClusters* clusters);
+
+    // 把本帧修改过的块上传到GPU（每个块一次glBufferSubData）
+    void Upload();
+
+    // 把程序中的FrameData/LightData/ShadowData/ClusterData块绑定到对应绑定点，
+    // shadowMap采样器绑定到ShadowMap::TextureUnit，分簇光照的三个采样器绑定到LightClusters::TextureUnit开始的单元，
+    // G-buffer的五个采样器绑定到DeferredRenderer::TextureUnit开始的单元，Hi-Z的两个采样器绑定到HiZBuffer::TextureUnit开始的单元
+    // （程序中不存在的块和采样器被忽略）
+    static void BindProgramBlocks(GLuint program);
+
+private:
+    GLuint m_frameBuffer = 0;
+    GLuint m_lightBuffer = 0;
+    GLuint m_shadowBuffer = 0;
+    GLuint m_clusterBuffer = 0;
+
+    FrameData m_frameData = {};
+    LightData m_lightData = {};
+    ShadowData m_shadowData = {};
+    ClusterData m_clusterData = {};
+    bool m_frameDirty = true;
+    bool m_lightDirty = true;
+    bool m_shadowDirty = true;
+    bool m_clusterDirty = true;
+
+    float m_constant = 1.0f;
+    float m_linear = 0.09f;
+    float m_quadratic = 0.032f;
+};
+
+} // namespace SoulsEngine
@@ -0,0 +1,89 @@
+#include "GLStateCache.h"
+#include <cstring>
+
+namespace SoulsEngine {
+
+void GLStateCache::Invalidate() {
+    m_programValid = false;
+    m_vertexArrayValid = false;
+    m_uniforms.clear();
+    m_currentUniforms = nullptr;
+}
+
+void GLStateCache::UseProgram(GLuint program) {
+    if (m_programValid && m_program == program) {
+        return;
+    }
+    glUseProgram(program);
+    m_program = program;
+    m_programValid = true;
+    m_currentUniforms = &m_uniforms[program];
+    ++m_stats.programChanges;
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (m_vertexArrayValid && m_vertexArray == vao) {
+        return;
+    }
+    glBindVertexArray(vao);
+    m_vertexArray = vao;
+    m_vertexArrayValid = true;
+    ++m_stats.vertexArrayChanges;
+}
+
+bool GLStateCache::UpdateCachedUniform(GLint location, const float* value, uint32_t size) {
+    if (location < 0) {
+        return false;
+    }
+
+    // 没有通过缓存设置程序时无法确定uniform归属，直接写入
+    if (!m_currentUniforms) {
+        ++m_stats.uniformsWritten;
+        return true;
+    }
+
+    std::vector<CachedUniform>& uniforms = *m_currentUniforms;
+    if (static_cast<size_t>(location) >= uniforms.size()) {
+        uniforms.resize(static_cast<size_t>(location) + 1);
+    }
+
+    CachedUniform& cached = uniforms[location];
+    if (cached.size == size && std::memcmp(cached.value, value, size * sizeof(float)) == 0) {
+        ++m_stats.uniformsSkipped;
+        return false;
+    }
+
+    std::memcpy(cached.value, value, size * sizeof(float));
+    cached.size = size;
+    ++m_stats.uniformsWritten;
+    return true;
+}
+
+void GLStateCache::SetUniform1i(GLint location, int value) {
+    // 整数按位存入缓存，只用于比较
+    float bits;
+    std::memcpy(&bits, &value, sizeof(float));
+    if (UpdateCachedUniform(location, &bits, 1)) {
+        glUniform1i(location, value);
+    }
+}
+
+void GLStateCache::SetUniform1f(GLint location, float value) {
+    if (UpdateCachedUniform(location, &value, 1)) {
+        glUniform1f(location, value);
+    }
+}
+
+void GLStateCache::SetUniform3f(GLint location, const glm::vec3& value) {
+    if (UpdateCachedUniform(location, &value.x, 3)) {
+        glUniform3f(location, value.x, value.y, value.z);
+    }
+}
+
+void GLStateCache::SetUniformMatrix4(GLint location, const float* value) {
+    if (UpdateCachedUniform(location, value, 16)) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, value);
+    }
+}
+
+} // namespace SoulsEngine
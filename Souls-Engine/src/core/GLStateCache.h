@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 每帧渲染统计（由渲染队列在提交时累计）
+struct RenderStats {
+    uint32_t drawItems = 0;           // 提交到队列的绘制项
+    uint32_t drawCalls = 0;           // 实际发出的绘制调用
+    uint32_t instancedDrawCalls = 0;  // 其中的实例化绘制调用
+    uint32_t instances = 0;           // 通过实例化绘制的绘制项
+    uint32_t multiDrawCalls = 0;      // 其中的多重间接绘制调用
+    uint32_t indirectCommands = 0;    // 多重间接绘制包含的绘制命令
+    uint32_t triangles = 0;           // 绘制的三角形数（含所有实例）
+    uint32_t programChanges = 0;      // glUseProgram 调用次数
+    uint32_t vertexArrayChanges = 0;  // glBindVertexArray 调用次数
+    uint32_t uniformsWritten = 0;     // 实际写入的uniform
+    uint32_t uniformsSkipped = 0;     // 因值未变化而跳过的uniform
+
+    uint32_t GetStateChanges() const { return programChanges + vertexArrayChanges; }
+};
+
+// OpenGL状态缓存 - 记录当前程序、VAO和各程序的uniform值，跳过冗余的状态切换
+// 缓存只在一次队列提交期间有效：其他代码可能直接修改GL状态，所以每次提交前调用Invalidate
+class GLStateCache {
+public:
+    GLStateCache() = default;
+
+    // 丢弃所有缓存的状态，下一次设置一定会发出GL调用
+    void Invalidate();
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+
+    // 写入当前程序的uniform，值与缓存相同时跳过（location为-1时忽略）
+    void SetUniform1i(GLint location, int value);
+    void SetUniform1f(GLint location, float value);
+    void SetUniform3f(GLint location, const glm::vec3& value);
+    void SetUniformMatrix4(GLint location, const float* value);
+
+    GLuint GetCurrentProgram() const { return m_program; }
+    GLuint GetCurrentVertexArray() const { return m_vertexArray; }
+
+    RenderStats& GetStats() { return m_stats; }
+    const RenderStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = RenderStats(); }
+
+private:
+    struct CachedUniform {
+        float value[16];
+        uint32_t size = 0;  // 已缓存的分量数，0表示未知
+    };
+
+    GLuint m_program = 0;
+    GLuint m_vertexArray = 0;
+    bool m_programValid = false;
+    bool m_vertexArrayValid = false;
+
+    // 按程序保存uniform值（uniform状态属于程序对象，切换程序后仍然有效）
+    std::unordered_map<GLuint, std::vector<CachedUniform>> m_uniforms;
+    std::vector<CachedUniform>* m_currentUniforms = nullptr;
+
+    RenderStats m_stats;
+
+    // 比较并更新缓存，返回true表示需要真正写入
+    bool UpdateCachedUniform(GLint location, const float* value, uint32_t size);
+};
+
+} // namespace SoulsEngine
@@ -23,6 +23,8 @@ GameManager::GameManager(ObjectManager* objectManager, Camera* camera)
     , m_obstacleSpawnInterval(5.0f)  // 每5秒生成一个障碍物
     , m_maxCollectibles(10)
     , m_maxObstacles(8)
+    , m_nextCollectibleId(0)
+    , m_nextObstacleId(0)
     , m_playerSpeed(5.0f)
     , m_gen(m_rd())
     , m_arenaMinX(-15.0f)
@@ -42,6 +44,8 @@ void GameManager::Initialize() {
     m_objectManager->Clear();
     m_collectibles.clear();
     m_obstacles.clear();
+    m_nextCollectibleId = 0;
+    m_nextObstacleId = 0;
 
     // 重置游戏状态
     m_score = 0;
@@ -166,9 +170,12 @@ void GameManager::SpawnCollectible() {
     glm::vec3 pos = GetRandomPosition(m_arenaMinX, m_arenaMaxX, 
                                       m_arenaMinY, m_arenaMaxY, 
                                       m_arenaMinZ, m_arenaMaxZ);
-    auto collectibleMesh = std::make_shared<Cube>(0.6f, glm::vec3(1.0f, 1.0f, 0.0f));
-    std::string name = "Collectible_" + std::to_string(m_collectibles.size());
-    auto collectible = m_objectManager->CreateNode(name, collectibleMesh);
+    // 所有收集物共用一个网格，便于实例化绘制
+    if (!m_collectibleMesh) {
+        m_collectibleMesh = std::make_shared<Cube>(0.6f, glm::vec3(1.0f, 1.0f, 0.0f));
+    }
+    std::string name = "Collectible_" + std::to_string(m_nextCollectibleId++);
+    auto collectible = m_objectManager->CreateNode(name, m_collectibleMesh);
     collectible->SetPosition(pos);
     m_collectibles.push_back(collectible);
 }
@@ -178,9 +185,11 @@ void GameManager::SpawnObstacle() {
     glm::vec3 pos = GetRandomPosition(m_arenaMinX, m_arenaMaxX, 
                                       m_arenaMinY, m_arenaMaxY, 
                                       m_arenaMinZ, m_arenaMaxZ);
-    auto obstacleMesh = std::make_shared<Cylinder>(0.5f, 1.5f, 36, glm::vec3(1.0f, 0.0f, 0.0f));
-    std::string name = "Obstacle_" + std::to_string(m_obstacles.size());
-    auto obstacle = m_objectManager->CreateNode(name, obstacleMesh);
+    if (!m_obstacleMesh) {
+        m_obstacleMesh = std::make_shared<Cylinder>(0.5f, 1.5f, 36, glm::vec3(1.0f, 0.0f, 0.0f));
+    }
+    std::string name = "Obstacle_" + std::to_string(m_nextObstacleId++);
+    auto obstacle = m_objectManager->CreateNode(name, m_obstacleMesh);
     obstacle->SetPosition(pos);
     m_obstacles.push_back(obstacle);
 }
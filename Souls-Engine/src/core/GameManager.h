@@ -41,6 +41,9 @@ public:
     bool IsGameOver() const { return m_gameOver; }
     bool IsGameWon() const { return m_gameWon; }
 
+    // 玩家节点句柄（每帧访问时用句柄查找，避免按名称查找）
+    NodeHandle GetPlayerHandle() const { return m_player ? m_player->GetHandle() : NodeHandle(); }
+
     // 重置游戏
     void ResetGame();
 
@@ -80,6 +83,10 @@ private:
     std::vector<std::shared_ptr<SceneNode>> m_collectibles;
     std::vector<std::shared_ptr<SceneNode>> m_obstacles;
 
+    // 收集物和障碍物各自共用的网格（首次生成时创建）
+    std::shared_ptr<Mesh> m_collectibleMesh;
+    std::shared_ptr<Mesh> m_obstacleMesh;
+
     // 游戏状态
     int m_score;
     float m_timeRemaining;
@@ -94,6 +101,8 @@ private:
     float m_obstacleSpawnInterval;
     int m_maxCollectibles;
     int m_maxObstacles;
+    int m_nextCollectibleId;  // 递增编号，保证节点名称唯一
+    int m_nextObstacleId;
 
     // 玩家移动速度
     float m_playerSpeed;
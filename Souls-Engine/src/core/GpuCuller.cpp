@@ -0,0 +1,333 @@
+#include "GpuCuller.h"
+#include "HiZBuffer.h"
+#include "JobSystem.h"
+#include "Material.h"
+#include "ObjectManager.h"
+#include "RenderQueue.h"
+#include "SceneNode.h"
+#include "Shader.h"
+#include "ViewFrustum.h"
+#include "../geometry/Mesh.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace SoulsEngine {
+
+namespace {
+    using Command = RenderQueue::DrawElementsIndirectCommand;
+
+    // 存储缓冲的绑定点（与gpu_cull.comp一致）
+    constexpr GLuint InstanceBinding = 0;
+    constexpr GLuint CommandBinding = 1;
+    constexpr GLuint VisibleBinding = 2;
+
+    const Material& GetDefaultMaterial() {
+        static Material defaultMat = Material::CreateDefault();
+        return defaultMat;
+    }
+
+    // 分组顺序：顶点格式和索引类型相同的网格相邻（可以合并为一次多重间接绘制），同一网格的实例相邻
+    bool GroupOrder(const SceneNode* a, const SceneNode* b) {
+        const Mesh* meshA = a->GetMesh().get();
+        const Mesh* meshB = b->GetMesh().get();
+        if (meshA->GetGeometry().format != meshB->GetGeometry().format) {
+            return meshA->GetGeometry().format < meshB->GetGeometry().format;
+        }
+        if (meshA->GetIndexType() != meshB->GetIndexType()) {
+            return meshA->GetIndexType() < meshB->GetIndexType();
+        }
+        return meshA->GetSortId() < meshB->GetSortId();
+    }
+
+    // 创建（或重新分配）缓冲并上传数据
+    void UploadBuffer(GLuint& buffer, GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        if (buffer == 0) {
+            glGenBuffers(1, &buffer);
+        }
+        glBindBuffer(target, buffer);
+        glBufferData(target, size, data, usage);
+        glBindBuffer(target, 0);
+    }
+}
+
+GpuCuller::~GpuCuller() {
+    Shutdown();
+}
+
+bool GpuCuller::IsSupported() {
+    // 计算着色器、存储缓冲和多重间接绘制都是GL 4.3核心功能
+    return RenderQueue::IsMultiDrawSupported();
+}
+
+void GpuCuller::Shutdown() {
+    for (GLuint* buffer : { &m_instanceBuffer, &m_templateBuffer, &m_commandBuffer, &m_visibleBuffer }) {
+        if (*buffer != 0) {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    for (GLuint& buffer : m_readbackBuffers) {
+        if (buffer != 0) {
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+    }
+    m_instances.clear();
+    m_nodes.clear();
+    m_ranges.clear();
+    m_groupCount = 0;
+    m_frame = 0;
+    m_synced = false;
+    m_stats = GpuCullingStats();
+    m_cullUniforms = CullUniforms();
+    m_drawProgram = 0;
+}
+
+void GpuCuller::Sync(ObjectManager& objects, uint32_t layerMask, bool meshesChanged) {
+    TransformSystem& transforms = TransformSystem::Get();
+    transforms.UpdateWorldTransforms(&JobSystem::Get());
+
+    m_stats.uploadedInstances = 0;
+    if (!m_synced || meshesChanged || layerMask != m_layerMask ||
+        objects.GetStructureVersion() != m_structureVersion) {
+        Rebuild(objects, layerMask);
+    } else {
+        const bool transformsChanged = transforms.GetVersion() != m_transformVersion;
+        const bool materialsChanged = Material::GetRevision() != m_materialRevision;
+        if (transformsChanged || materialsChanged) {
+            RefreshInstances(transformsChanged, materialsChanged);
+        }
+    }
+
+    m_structureVersion = objects.GetStructureVersion();
+    m_transformVersion = transforms.GetVersion();
+    m_materialRevision = Material::GetRevision();
+    m_layerMask = layerMask;
+    m_synced = true;
+}
+
+void GpuCuller::Rebuild(ObjectManager& objects, uint32_t layerMask) {
+    std::vector<SceneNode*> nodes;
+    objects.ForEachRenderable([&](SceneNode& node) {
+        const Mesh* mesh = node.GetMesh().get();
+        // 间接命令只有索引形式（生成器创建的网格都是索引网格）
+        if (mesh->IsIndexed() && mesh->GetInstancedVAO() != 0) {
+            nodes.push_back(&node);
+        }
+    }, layerMask);
+    std::stable_sort(nodes.begin(), nodes.end(), GroupOrder);
+
+    TransformSystem& transforms = TransformSystem::Get();
+    m_instances.clear();
+    m_nodes.clear();
+    m_ranges.clear();
+    std::vector<Command> commands;
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const SceneNode& node = *nodes[i];
+        const Mesh* mesh = node.GetMesh().get();
+
+        // 新的网格组：一条命令，baseInstance为该组在输出缓冲中的起点
+        if (i == 0 || nodes[i - 1]->GetMesh().get() != mesh) {
+            const GeometryAllocation& geometry = mesh->GetGeometry();
+            const uint32_t indexSize = mesh->GetIndexType() == GL_UNSIGNED_SHORT ? 2u : 4u;
+            Command command;
+            command.count = static_cast<GLuint>(mesh->GetIndexCount());
+            command.instanceCount = 0;
+            command.firstIndex = geometry.indexOffset / indexSize;
+            command.baseVertex = static_cast<GLint>(geometry.vertexOffset);
+            command.baseInstance = static_cast<GLuint>(i);
+
+            const DrawRange* previous = m_ranges.empty() ? nullptr : &m_ranges.back();
+            if (previous && previous->mesh->GetGeometry().format == geometry.format &&
+                previous->mesh->GetIndexType() == mesh->GetIndexType()) {
+                ++m_ranges.back().commandCount;
+            } else {
+                m_ranges.push_back({ mesh, static_cast<uint32_t>(commands.size()), 1 });
+            }
+            commands.push_back(command);
+        }
+
+        // 与CPU剔除相同，使用变换系统中的局部包围盒（LOD节点为所有层次的并集）
+        const BoundingBox& bounds = transforms.GetLocalBounds(node.GetTransformId());
+        GpuInstance instance;
+        instance.model = transforms.GetWorldMatrix(node.GetTransformId());
+        WriteMaterial(node, instance);
+        instance.boundsCenter = glm::vec4(bounds.center, 1.0f);
+        instance.boundsExtent = glm::vec4(bounds.extents, 0.0f);
+        instance.group = glm::uvec4(static_cast<uint32_t>(commands.size() - 1), 0u, 0u, 0u);
+        m_instances.push_back(instance);
+        m_nodes.push_back(&node);
+    }
+    m_groupCount = static_cast<uint32_t>(commands.size());
+
+    // 所有缓冲按当前实例数重新分配；空场景时保留一个命令大小，避免零大小的缓冲
+    const size_t instanceCount = std::max<size_t>(m_instances.size(), 1);
+    const size_t commandBytes = std::max<size_t>(commands.size(), 1) * sizeof(Command);
+    UploadBuffer(m_instanceBuffer, GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(instanceCount * sizeof(GpuInstance)),
+                 m_instances.empty() ? nullptr : m_instances.data(), GL_DYNAMIC_DRAW);
+    UploadBuffer(m_templateBuffer, GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(commandBytes),
+                 commands.empty() ? nullptr : commands.data(), GL_STATIC_DRAW);
+    UploadBuffer(m_commandBuffer, GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(commandBytes), nullptr, GL_DYNAMIC_DRAW);
+    UploadBuffer(m_visibleBuffer, GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(instanceCount * sizeof(RenderQueue::InstanceData)), nullptr, GL_DYNAMIC_DRAW);
+    for (GLuint& buffer : m_readbackBuffers) {
+        UploadBuffer(buffer, GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(commandBytes), nullptr, GL_STREAM_READ);
+    }
+    m_frame = 0;
+
+    m_stats.instances = static_cast<uint32_t>(m_instances.size());
+    m_stats.groups = m_groupCount;
+    m_stats.visible = 0;
+    m_stats.uploadedInstances = static_cast<uint32_t>(m_instances.size());
+}
+
+void GpuCuller::WriteMaterial(const SceneNode& node, GpuInstance& instance) {
+    const Material& material = node.GetMaterial() ? *node.GetMaterial() : GetDefaultMaterial();
+    instance.ambient = glm::vec4(material.GetAmbient(), 0.0f);
+    instance.diffuse = glm::vec4(material.GetDiffuse(), 0.0f);
+    instance.specular = glm::vec4(material.GetSpecular(), material.GetShininess());
+}
+
+void GpuCuller::RefreshInstances(bool transformsChanged, bool materialsChanged) {
+    TransformSystem& transforms = TransformSystem::Get();
+    size_t firstDirty = m_instances.size();
+    size_t lastDirty = 0;
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        GpuInstance& instance = m_instances[i];
+        bool changed = false;
+        if (transformsChanged) {
+            const glm::mat4& world = transforms.GetWorldMatrix(m_nodes[i]->GetTransformId());
+            if (std::memcmp(&world, &instance.model, sizeof(glm::mat4)) != 0) {
+                instance.model = world;
+                changed = true;
+            }
+        }
+        if (materialsChanged) {
+            GpuInstance updated = instance;
+            WriteMaterial(*m_nodes[i], updated);
+            // 材质参数在实例中连续存放（ambient、diffuse、specular）
+            if (std::memcmp(&updated.ambient, &instance.ambient, 3 * sizeof(glm::vec4)) != 0) {
+                instance = updated;
+                changed = true;
+            }
+        }
+        if (changed) {
+            firstDirty = std::min(firstDirty, i);
+            lastDirty = i;
+        }
+    }
+    if (firstDirty > lastDirty) return;
+
+    const size_t count = lastDirty - firstDirty + 1;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instanceBuffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(firstDirty * sizeof(GpuInstance)),
+                    static_cast<GLsizeiptr>(count * sizeof(GpuInstance)), &m_instances[firstDirty]);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    m_stats.uploadedInstances = static_cast<uint32_t>(count);
+}
+
+void GpuCuller::Cull(const Shader& cullShader, const ViewFrustum& frustum, const HiZBuffer* hiZ) {
+    if (m_instances.empty()) return;
+
+    // 命令的instanceCount清零（其余字段在重建时已经确定）
+    const GLsizeiptr commandBytes = static_cast<GLsizeiptr>(m_groupCount * sizeof(Command));
+    glBindBuffer(GL_COPY_READ_BUFFER, m_templateBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandBuffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, commandBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    cullShader.Use();
+    ResolveCullUniforms(cullShader);
+    cullShader.Set(m_cullUniforms.instanceCount, static_cast<int>(m_instances.size()));
+    for (int i = 0; i < ViewFrustum::PlaneCount; ++i) {
+        cullShader.Set(m_cullUniforms.frustumPlanes[i], frustum.GetPlane(i));
+    }
+
+    const bool useHiZ = hiZ && hiZ->IsValid();
+    cullShader.Set(m_cullUniforms.useHiZ, useHiZ);
+    if (useHiZ) {
+        cullShader.Set(m_cullUniforms.hiZViewProjection, hiZ->GetViewProjection());
+        cullShader.Set(m_cullUniforms.hiZLevels, hiZ->GetLevelCount());
+        hiZ->BindTexture();
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, InstanceBinding, m_instanceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CommandBinding, m_commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, VisibleBinding, m_visibleBuffer);
+    glDispatchCompute((static_cast<GLuint>(m_instances.size()) + WorkGroupSize - 1) / WorkGroupSize, 1, 1);
+
+    // 之后作为间接命令、顶点属性读取，并被拷贝到回读缓冲
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    UpdateVisibleCount();
+}
+
+void GpuCuller::ResolveCullUniforms(const Shader& cullShader) {
+    if (m_cullUniforms.program == cullShader.GetProgramID()) return;
+
+    m_cullUniforms.program = cullShader.GetProgramID();
+    m_cullUniforms.instanceCount = cullShader.GetUniformHandle<int>("instanceCount");
+    for (int i = 0; i < ViewFrustum::PlaneCount; ++i) {
+        m_cullUniforms.frustumPlanes[i] =
+            cullShader.GetUniformHandle<glm::vec4>("frustumPlanes[" + std::to_string(i) + "]");
+    }
+    m_cullUniforms.useHiZ = cullShader.GetUniformHandle<bool>("useHiZ");
+    m_cullUniforms.hiZViewProjection = cullShader.GetUniformHandle<glm::mat4>("hiZViewProjection");
+    m_cullUniforms.hiZLevels = cullShader.GetUniformHandle<int>("hiZLevels");
+}
+
+void GpuCuller::UpdateVisibleCount() {
+    const GLsizeiptr commandBytes = static_cast<GLsizeiptr>(m_groupCount * sizeof(Command));
+
+    // 最旧的一个回读缓冲是ReadbackFrames - 1帧之前写入的
+    if (m_frame >= ReadbackFrames - 1) {
+        std::vector<Command> commands(m_groupCount);
+        glBindBuffer(GL_COPY_READ_BUFFER, m_readbackBuffers[(m_frame + 1) % ReadbackFrames]);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, commandBytes, commands.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        m_stats.visible = 0;
+        for (const Command& command : commands) {
+            m_stats.visible += command.instanceCount;
+        }
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, m_commandBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_readbackBuffers[m_frame % ReadbackFrames]);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, commandBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    ++m_frame;
+}
+
+void GpuCuller::Draw(const Shader& shader) {
+    m_stats.drawCalls = 0;
+    if (m_instances.empty()) return;
+
+    // 模型矩阵和材质来自输出缓冲，每条命令的baseInstance选择自己组的起点
+    shader.Use();
+    if (m_drawProgram != shader.GetProgramID()) {
+        m_drawProgram = shader.GetProgramID();
+        m_useInstancing = shader.GetUniformHandle<bool>("useInstancing");
+    }
+    shader.Set(m_useInstancing, true);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+    for (const DrawRange& range : m_ranges) {
+        glBindVertexArray(range.mesh->GetInstancedVAO());
+        RenderQueue::BindInstanceAttributes(m_visibleBuffer, 0);
+        const size_t offset = static_cast<size_t>(range.firstCommand) * sizeof(Command);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, range.mesh->GetIndexType(), reinterpret_cast<const void*>(offset),
+                                    static_cast<GLsizei>(range.commandCount), 0);
+        ++m_stats.drawCalls;
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+
+    shader.Set(m_useInstancing, false);
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Shader.h"
+#include "TransformSystem.h"
+#include "ViewFrustum.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Mesh;
+class SceneNode;
+class ObjectManager;
+class HiZBuffer;
+
+// GPU剔除统计
+struct GpuCullingStats {
+    uint32_t instances = 0;      // 参与剔除的实例
+    uint32_t groups = 0;         // 网格组（每组一条间接命令）
+    uint32_t visible = 0;        // 通过剔除的实例（几帧之前的结果，异步回读，不等待GPU）
+    uint32_t drawCalls = 0;      // Draw发出的多重间接绘制调用
+    uint32_t uploadedInstances = 0;  // 本帧重新上传的实例（没有变化时为0）
+};
+
+// GPU剔除 - 所有实例的包围盒和绘制数据常驻在存储缓冲中，由计算着色器（gpu_cull.comp）每帧做
+// 视锥体测试和（可选的）Hi-Z遮挡测试，通过的实例用原子计数压缩到每个网格组的间接绘制命令中，
+// 之后一次glMultiDrawElementsIndirect绘制（每种顶点格式/索引类型一次）
+//
+// CPU每帧的可见性工作是常数：不再逐节点测试、排序或填充渲染队列。实例数据只在场景变化时更新：
+//   节点增删（ObjectManager的结构版本号）或调用方告知网格变化（如LOD切换）时重建整个实例列表
+//   只有变换（TransformSystem的版本号）或材质（Material的修改计数）变化时比较模型矩阵和材质参数，只上传变化的区间
+//
+// 实例按网格分组：组内实例在输出缓冲中占据连续区间（起点为命令的baseInstance），
+// 输出格式与RenderQueue::InstanceData相同，绘制时使用basic.vert的逐实例属性，不需要新的顶点着色器
+//
+// Hi-Z使用上一帧的深度和视图投影矩阵（见 HiZBuffer），相机快速移动时新露出的物体可能晚一帧出现
+// 需要GL 4.3（计算着色器、存储缓冲、多重间接绘制）
+class GpuCuller {
+public:
+    // 计算着色器的工作组大小（与gpu_cull.comp的local_size_x一致）
+    static constexpr uint32_t WorkGroupSize = 64;
+
+    GpuCuller() = default;
+    ~GpuCuller();
+
+    // 禁止拷贝（持有GL缓冲）
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    // 当前上下文是否支持GPU剔除（需要有效的OpenGL上下文）
+    static bool IsSupported();
+
+    // 删除所有GL缓冲，下一次Sync重新创建
+    void Shutdown();
+
+    // 与场景同步：只收集layerMask中的可渲染节点；meshesChanged为true时强制重建（节点换了网格，例如LOD切换）
+    void Sync(ObjectManager& objects, uint32_t layerMask, bool meshesChanged = false);
+
+    // 重置命令并派发剔除计算着色器；hiZ为nullptr或尚未构建时只做视锥体测试
+    void Cull(const Shader& cullShader, const ViewFrustum& frustum, const HiZBuffer* hiZ);
+
+    // 绘制通过剔除的实例（调用方需已设置好view/projection等每帧uniform），结束后解绑VAO并关闭useInstancing
+    void Draw(const Shader& shader);
+
+    const GpuCullingStats& GetStats() const { return m_stats; }
+
+private:
+    // 输入实例（std430布局，与gpu_cull.comp中的CullInstance一致）
+    struct GpuInstance {
+        glm::mat4 model;
+        glm::vec4 ambient;
+        glm::vec4 diffuse;
+        glm::vec4 specular;      // w: 光泽度
+        glm::vec4 boundsCenter;  // 局部包围盒
+        glm::vec4 boundsExtent;
+        glm::uvec4 group;        // x: 网格组（命令下标）
+    };
+
+    // 索引类型和VAO相同的一段连续命令，一次多重间接绘制
+    struct DrawRange {
+        const Mesh* mesh;        // 提供VAO和索引类型
+        uint32_t firstCommand;
+        uint32_t commandCount;
+    };
+
+    // 剔除着色器的uniform句柄，程序变化时（第一次使用或重新编译）才按名字解析
+    struct CullUniforms {
+        GLuint program = 0;
+        UniformHandle<int> instanceCount;
+        UniformHandle<glm::vec4> frustumPlanes[ViewFrustum::PlaneCount];
+        UniformHandle<bool> useHiZ;
+        UniformHandle<glm::mat4> hiZViewProjection;
+        UniformHandle<int> hiZLevels;
+    };
+
+    // 回读环的长度：读取的是几帧之前写入的结果，GPU早已完成，不会阻塞
+    static constexpr int ReadbackFrames = 3;
+
+    std::vector<GpuInstance> m_instances;
+    std::vector<const SceneNode*> m_nodes;    // 与m_instances一一对应（结构版本号不变时节点一直有效）
+    std::vector<DrawRange> m_ranges;
+    uint32_t m_groupCount = 0;
+
+    GLuint m_instanceBuffer = 0;   // 输入实例
+    GLuint m_templateBuffer = 0;   // instanceCount为0的命令，每帧拷贝到m_commandBuffer
+    GLuint m_commandBuffer = 0;    // 间接绘制命令（剔除时作为存储缓冲写入instanceCount）
+    GLuint m_visibleBuffer = 0;    // 通过剔除的实例（RenderQueue::InstanceData格式）
+    GLuint m_readbackBuffers[ReadbackFrames] = {};
+    uint32_t m_frame = 0;
+
+    uint64_t m_structureVersion = 0;
+    uint64_t m_transformVersion = 0;
+    uint64_t m_materialRevision = 0;
+    uint32_t m_layerMask = 0;
+    bool m_synced = false;
+
+    GpuCullingStats m_stats;
+
+    CullUniforms m_cullUniforms;
+    GLuint m_drawProgram = 0;              // m_useInstancing所属的程序
+    UniformHandle<bool> m_useInstancing;
+
+    // 重建实例列表、分组和所有缓冲
+    void Rebuild(ObjectManager& objects, uint32_t layerMask);
+
+    // 比较模型矩阵和材质参数（只比较发生过变化的一类），上传变化的区间
+    void RefreshInstances(bool transformsChanged, bool materialsChanged);
+
+    // 把节点的材质参数（没有材质时为默认材质）写入实例
+    static void WriteMaterial(const SceneNode& node, GpuInstance& instance);
+
+    // 剔除着色器的程序与缓存的句柄不一致时重新解析
+    void ResolveCullUniforms(const Shader& cullShader);
+
+    // 把上一次回读的命令求和为可见实例数，并把本帧的命令拷贝到回读环
+    void UpdateVisibleCount();
+};
+
+} // namespace SoulsEngine
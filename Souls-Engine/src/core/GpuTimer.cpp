@@ -0,0 +1,80 @@
+#include "GpuTimer.h"
+#include <iostream>
+
+namespace SoulsEngine {
+
+namespace {
+    // 新结果的平滑权重
+    const float SmoothingFactor = 0.1f;
+}
+
+GpuTimer::~GpuTimer() {
+    Shutdown();
+}
+
+bool GpuTimer::Initialize() {
+    if (m_queries[0] != 0) {
+        return true;
+    }
+    glGenQueries(QueryCount, m_queries);
+    if (m_queries[0] == 0) {
+        std::cerr << "Failed to create GPU timer queries" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void GpuTimer::Shutdown() {
+    if (m_queries[0] != 0) {
+        glDeleteQueries(QueryCount, m_queries);
+        for (int i = 0; i < QueryCount; ++i) {
+            m_queries[i] = 0;
+            m_pending[i] = false;
+        }
+    }
+    m_active = -1;
+}
+
+void GpuTimer::Begin() {
+    if (m_queries[0] == 0) return;
+
+    Collect();
+    if (m_pending[m_next]) {
+        // 所有查询都在等待GPU，跳过本次计时而不是等待
+        m_active = -1;
+        return;
+    }
+    m_active = m_next;
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_active]);
+}
+
+void GpuTimer::End() {
+    if (m_active < 0) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_pending[m_active] = true;
+    m_next = (m_active + 1) % QueryCount;
+    m_active = -1;
+}
+
+void GpuTimer::Collect() {
+    // 按发出顺序检查，较早的查询未完成时较晚的也不会完成
+    for (int i = 0; i < QueryCount; ++i) {
+        int query = (m_next + i) % QueryCount;
+        if (!m_pending[query]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(m_queries[query], GL_QUERY_RESULT, &nanoseconds);
+        m_pending[query] = false;
+
+        float milliseconds = static_cast<float>(nanoseconds) * 1.0e-6f;
+        m_milliseconds = m_hasResult ? m_milliseconds + (milliseconds - m_milliseconds) * SmoothingFactor : milliseconds;
+        m_hasResult = true;
+    }
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+
+namespace SoulsEngine {
+
+// GPU计时器 - 用GL_TIME_ELAPSED查询测量一段GL命令在GPU上的执行时间
+//
+// 查询结果要等GPU执行完才能读取，这里用QueryCount个查询轮流使用，
+// 每次Begin前只读取已经可用的结果，不会等待GPU。所有查询都未完成时跳过本次计时
+// 同一时刻只能有一个GL_TIME_ELAPSED查询处于活动状态，多个计时器不能嵌套使用
+class GpuTimer {
+public:
+    static constexpr int QueryCount = 4;
+
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    // 禁止拷贝（持有GL查询对象）
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // 创建查询对象（需要有效的OpenGL上下文）
+    bool Initialize();
+    void Shutdown();
+
+    // 开始/结束计时
+    void Begin();
+    void End();
+
+    // 最近结果的平滑值（毫秒），还没有结果时为0
+    float GetMilliseconds() const { return m_milliseconds; }
+    bool HasResult() const { return m_hasResult; }
+
+private:
+    // 读取所有已可用的查询结果
+    void Collect();
+
+    GLuint m_queries[QueryCount] = {};
+    bool m_pending[QueryCount] = {};
+    int m_next = 0;        // 下一个使用的查询（也是最早发出的查询）
+    int m_active = -1;     // 当前活动的查询，-1表示没有
+    float m_milliseconds = 0.0f;
+    bool m_hasResult = false;
+};
+
+} // namespace SoulsEngine
@@ -0,0 +1,139 @@
+#include "HiZBuffer.h"
+#include "Shader.h"
+#include <algorithm>
+#include <iostream>
+
+namespace SoulsEngine {
+
+namespace {
+    // 归约着色器的工作组尺寸（与hiz_downsample.comp的local_size一致）
+    constexpr int GroupSize = 8;
+}
+
+HiZBuffer::~HiZBuffer() {
+    Shutdown();
+}
+
+bool HiZBuffer::Initialize(int width, int height) {
+    Shutdown();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // 深度拷贝目标：格式与默认帧缓冲相同，glBlitFramebuffer才能拷贝深度
+    glGenTextures(1, &m_depthTexture);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // mip链：每级宽高减半（向下取整，至少为1），直到1x1
+    m_levelCount = 1;
+    while ((std::max(width, height) >> m_levelCount) > 0) {
+        ++m_levelCount;
+    }
+    glGenTextures(1, &m_pyramidTexture);
+    glBindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+    for (int level = 0; level < m_levelCount; ++level) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_R32F, std::max(1, width >> level), std::max(1, height >> level), 0,
+                     GL_RED, GL_FLOAT, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_levelCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGenFramebuffers(1, &m_depthFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_depthFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    if (!complete) {
+        std::cerr << "ERROR::HIZ:: Depth copy framebuffer is not complete!" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+void HiZBuffer::Shutdown() {
+    if (m_depthFramebuffer != 0) {
+        glDeleteFramebuffers(1, &m_depthFramebuffer);
+        m_depthFramebuffer = 0;
+    }
+    if (m_depthTexture != 0) {
+        glDeleteTextures(1, &m_depthTexture);
+        m_depthTexture = 0;
+    }
+    if (m_pyramidTexture != 0) {
+        glDeleteTextures(1, &m_pyramidTexture);
+        m_pyramidTexture = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+    m_levelCount = 0;
+    m_valid = false;
+}
+
+bool HiZBuffer::Resize(int width, int height) {
+    if (m_pyramidTexture != 0 && width == m_width && height == m_height) {
+        return true;
+    }
+    return Initialize(width, height);
+}
+
+void HiZBuffer::Build(const Shader& downsampleShader, const glm::mat4& viewProjection) {
+    if (m_pyramidTexture == 0) return;
+
+    // 拷贝当前帧缓冲的深度
+    GLint target = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(target));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_depthFramebuffer);
+    glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(target));
+
+    glActiveTexture(GL_TEXTURE0 + TextureUnit + 1);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    // 第0级从深度纹理拷贝，之后每级读上一级、写这一级（两级绑定到不同的图像单元）
+    downsampleShader.Use();
+    const UniformHandle<int> levelUniform = downsampleShader.GetUniformHandle<int>("level");
+    for (int level = 0; level < m_levelCount; ++level) {
+        const int width = std::max(1, m_width >> level);
+        const int height = std::max(1, m_height >> level);
+        downsampleShader.Set(levelUniform, level);
+        if (level > 0) {
+            glBindImageTexture(0, m_pyramidTexture, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        }
+        glBindImageTexture(1, m_pyramidTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute(static_cast<GLuint>((width + GroupSize - 1) / GroupSize),
+                          static_cast<GLuint>((height + GroupSize - 1) / GroupSize), 1);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    }
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(1, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+
+    // 剔除着色器之后通过采样器读取
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    m_viewProjection = viewProjection;
+    m_valid = true;
+}
+
+void HiZBuffer::BindTexture() const {
+    glActiveTexture(GL_TEXTURE0 + TextureUnit);
+    glBindTexture(GL_TEXTURE_2D, m_pyramidTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+} // namespace SoulsEngine
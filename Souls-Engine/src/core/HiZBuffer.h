@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Shader;
+
+// 层次深度缓冲（Hi-Z） - 场景深度的mip链，每一级的纹素保存上一级2x2（奇数尺寸时为3x3）区域中的最大深度，
+// 供GPU剔除（见 GpuCuller）用一次到四次读取判断包围盒是否完全在已绘制的遮挡物之后
+//
+// 一帧的流程：世界通道绘制完后调用Build，把当前帧缓冲的深度拷贝到自己的深度纹理，
+// 再由计算着色器（hiz_downsample.comp）逐级归约；下一帧剔除时使用这一帧的深度和视图投影矩阵，
+// 因此物体或相机快速移动时可能有一帧的延迟（只会把应该可见的物体晚一帧画出，不会错误地保留被遮挡物体）
+//
+// 需要GL 4.3（计算着色器和图像读写）
+class HiZBuffer {
+public:
+    // 纹理单元：TextureUnit为mip链（剔除时采样），TextureUnit + 1为拷贝来的深度纹理（构建第0级时采样）
+    static constexpr GLuint TextureUnit = 13;
+
+    HiZBuffer() = default;
+    ~HiZBuffer();
+
+    // 禁止拷贝（持有GL对象）
+    HiZBuffer(const HiZBuffer&) = delete;
+    HiZBuffer& operator=(const HiZBuffer&) = delete;
+
+    // 创建指定尺寸的深度纹理和mip链（需要有效的OpenGL上下文）
+    bool Initialize(int width, int height);
+    void Shutdown();
+
+    // 尺寸变化时重新创建（尺寸相同时不做任何事），重新创建后IsValid为false直到下一次Build
+    bool Resize(int width, int height);
+
+    // 从当前帧缓冲（与Hi-Z同尺寸）拷贝深度并构建mip链，viewProjection为绘制该深度时的相机矩阵
+    void Build(const Shader& downsampleShader, const glm::mat4& viewProjection);
+
+    // 把mip链绑定到TextureUnit
+    void BindTexture() const;
+
+    // 是否已经构建过（之前没有深度时剔除只做视锥体测试）
+    bool IsValid() const { return m_valid; }
+
+    const glm::mat4& GetViewProjection() const { return m_viewProjection; }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetLevelCount() const { return m_levelCount; }
+
+private:
+    GLuint m_depthTexture = 0;      // 与默认帧缓冲相同的DEPTH24_STENCIL8，深度拷贝的目标
+    GLuint m_depthFramebuffer = 0;
+    GLuint m_pyramidTexture = 0;    // R32F，m_levelCount级
+    int m_width = 0;
+    int m_height = 0;
+    int m_levelCount = 0;
+    bool m_valid = false;
+    glm::mat4 m_viewProjection = glm::mat4(1.0f);
+};
+
+} // namespace SoulsEngine
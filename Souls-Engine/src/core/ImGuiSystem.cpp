@@ -37,7 +37,9 @@ ImGuiSystem::ImGuiSystem()
     , m_showLightMenu(false)
     , m_showModelMenu(false)
     , m_lightAngle(45.0f)
-    , m_lightIntensity(1.0f) {
+    , m_lightIntensity(1.0f)
+    , m_renderPath(RenderPath::Forward)
+    , m_compareTiming(false) {
     InitMaterialPresets();
 }
 
@@ -346,6 +348,15 @@ void ImGuiSystem::RenderSidebar(ObjectManager* objectManager,
         ImGui::Unindent();
     }
 
+    ImGui::Spacing();
+
+    // 5. 渲染设置
+    if (ImGui::CollapsingHeader("5. 渲染设置", ImGuiTreeNodeFlags_None)) {
+        ImGui::Indent();
+        RenderSettingsMenu();
+        ImGui::Unindent();
+    }
+
     ImGui::Spacing();
     ImGui::Separator();
 
@@ -372,5 +383,38 @@ void ImGuiSystem::RenderSidebar(ObjectManager* objectManager,
     ImGui::End();
 }
 
+void ImGuiSystem::RenderSettingsMenu() {
+    int path = static_cast<int>(m_renderPath);
+    ImGui::RadioButton("前向渲染", &path, static_cast<int>(RenderPath::Forward));
+    ImGui::RadioButton("延迟渲染", &path, static_cast<int>(RenderPath::Deferred));
+    m_renderPath = static_cast<RenderPath>(path);
+
+    // 对比计时时两条路径每帧交替，两列耗时来自同一场景
+    ImGui::Checkbox("对比计时", &m_compareTiming);
+
+    ImGui::Spacing();
+    ImGui::Text("GPU耗时 (ms):");
+    ImGui::Columns(2, "RenderTimings", false);
+    ImGui::Text("前向");
+    ImGui::NextColumn();
+    ImGui::Text("延迟");
+    ImGui::NextColumn();
+    if (m_renderTimings.forwardValid) {
+        ImGui::Text("%.3f", m_renderTimings.forwardMs);
+    } else {
+        ImGui::TextDisabled("-");
+    }
+    ImGui::NextColumn();
+    if (m_renderTimings.deferredValid) {
+        ImGui::Text("%.3f", m_renderTimings.deferredGeometryMs + m_renderTimings.deferredLightingMs);
+        ImGui::Text("几何 %.3f", m_renderTimings.deferredGeometryMs);
+        ImGui::Text("光照 %.3f", m_renderTimings.deferredLightingMs);
+    } else {
+        ImGui::TextDisabled("-");
+    }
+    ImGui::NextColumn();
+    ImGui::Columns(1);
+}
+
 } // namespace SoulsEngine
 
@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 #include "Material.h"
+#include "RenderPath.h"
 #include <memory>
 #include <vector>
 
@@ -43,6 +44,13 @@ public:
     void RenderSidebar(ObjectManager* objectManager, SelectionSystem* selectionSystem, 
                        Camera* camera, LightManager* lightManager, float aspectRatio);
 
+    // 渲染设置：侧边栏选择的渲染路径，对比计时时每帧交替使用两条路径
+    RenderPath GetRenderPath() const { return m_renderPath; }
+    bool IsCompareTiming() const { return m_compareTiming; }
+
+    // 侧边栏显示的GPU耗时（由主循环每帧写入）
+    void SetRenderTimings(const RenderTimings& timings) { m_renderTimings = timings; }
+
 private:
     GLFWwindow* m_window;
     ImGuiContext* m_context;
@@ -61,11 +69,17 @@ private:
     float m_lightAngle;      // ????????0-360????
     float m_lightIntensity;  // ????????0-10??
 
+    // 渲染设置
+    RenderPath m_renderPath;
+    bool m_compareTiming;
+    RenderTimings m_renderTimings;
+
     // ??????
     void RenderGeometryMenu(ObjectManager* objectManager, SelectionSystem* selectionSystem, Camera* camera);
     void RenderMaterialMenu(SelectionSystem* selectionSystem);
     void RenderLightMenu();
     void RenderModelMenu();
+    void RenderSettingsMenu();
 
     // ????????
     void InitMaterialPresets();
@@ -0,0 +1,181 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace SoulsEngine {
+
+namespace {
+    // 当前线程所属的任务系统及其队列索引（非工作线程为nullptr）
+    thread_local JobSystem* t_ownerSystem = nullptr;
+    thread_local unsigned t_workerIndex = 0;
+}
+
+JobSystem& JobSystem::Get() {
+    static JobSystem instance(GetDefaultWorkerCount());
+    return instance;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    Start(workerCount);
+}
+
+JobSystem::~JobSystem() {
+    Stop();
+}
+
+unsigned JobSystem::GetDefaultWorkerCount() {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void JobSystem::SetWorkerCount(unsigned workerCount) {
+    if (workerCount == GetWorkerCount()) return;
+    Stop();
+    Start(workerCount);
+}
+
+void JobSystem::Start(unsigned workerCount) {
+    m_running = true;
+    m_queues.clear();
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_all();
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+    m_queues.clear();
+}
+
+void JobSystem::Submit(Job job, JobCounter& counter) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+    // 没有工作线程时直接在调用线程执行
+    if (m_queues.empty()) {
+        job();
+        counter.pending.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    // 工作线程提交到自己的队列，外部线程轮流分配到各个队列
+    unsigned queueIndex;
+    if (t_ownerSystem == this) {
+        queueIndex = t_workerIndex;
+    } else {
+        queueIndex = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queueIndex]->mutex);
+        m_queues[queueIndex]->jobs.push_back({ std::move(job), &counter });
+    }
+    m_queuedCount.fetch_add(1, std::memory_order_release);
+
+    // 先获取再释放睡眠锁，保证不会错过正在进入等待的工作线程
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wakeCondition.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& func) {
+    if (count == 0) return;
+    batchSize = std::max(batchSize, 1u);
+
+    // 只有一个批次或没有工作线程时不必经过队列
+    if (m_queues.empty() || count <= batchSize) {
+        func(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t begin = 0; begin < count; begin += batchSize) {
+        uint32_t end = std::min(begin + batchSize, count);
+        Submit([&func, begin, end]() { func(begin, end); }, counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::WorkerLoop(unsigned index) {
+    t_ownerSystem = this;
+    t_workerIndex = index;
+
+    while (true) {
+        QueuedJob queued;
+        if (PopLocal(index, queued) || Steal(index, queued)) {
+            Execute(queued);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]() {
+            return !m_running || m_queuedCount.load(std::memory_order_acquire) > 0;
+        });
+        if (!m_running && m_queuedCount.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+    }
+
+    t_ownerSystem = nullptr;
+}
+
+bool JobSystem::PopLocal(unsigned queueIndex, QueuedJob& out) {
+    WorkerQueue& queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    out = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::Steal(unsigned thiefIndex, QueuedJob& out) {
+    const size_t queueCount = m_queues.size();
+    for (size_t offset = 1; offset <= queueCount; ++offset) {
+        WorkerQueue& victim = *m_queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty()) continue;
+        out = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+        m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::TryRunOne() {
+    if (m_queues.empty()) return false;
+
+    QueuedJob queued;
+    unsigned index = (t_ownerSystem == this) ? t_workerIndex : 0;
+    if ((t_ownerSystem == this && PopLocal(index, queued)) || Steal(index, queued)) {
+        Execute(queued);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(QueuedJob& queued) {
+    queued.job();
+    queued.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 任务计数器：Submit时加一，任务完成时减一，Wait等待其归零
+struct JobCounter {
+    std::atomic<uint32_t> pending{0};
+};
+
+// 任务系统 - 每个工作线程一个双端队列，空闲线程从其他队列窃取任务
+// 自己的队列从尾部取（LIFO，缓存友好），窃取从头部取（FIFO，粒度更大）
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // 全局实例（默认工作线程数为硬件线程数-1，主线程在Wait时也参与执行）
+    static JobSystem& Get();
+
+    explicit JobSystem(unsigned workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 设置工作线程数量（0表示所有任务都在调用线程上直接执行）
+    // 调用时不能有未完成的任务
+    void SetWorkerCount(unsigned workerCount);
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_threads.size()); }
+    static unsigned GetDefaultWorkerCount();
+
+    // 提交任务
+    void Submit(Job job, JobCounter& counter);
+
+    // 等待计数器归零，等待期间调用线程也会执行任务
+    void Wait(JobCounter& counter);
+
+    // 把[0, count)按batchSize切分成任务并行执行，返回前全部完成
+    // 切分方式只取决于count和batchSize，与线程数无关
+    void ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+private:
+    struct QueuedJob {
+        Job job;
+        JobCounter* counter;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    void Start(unsigned workerCount);
+    void Stop();
+    void WorkerLoop(unsigned index);
+
+    bool PopLocal(unsigned queueIndex, QueuedJob& out);
+    bool Steal(unsigned thiefIndex, QueuedJob& out);
+    bool TryRunOne();
+    void Execute(QueuedJob& queued);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<uint32_t> m_queuedCount{0};
+    std::atomic<uint32_t> m_nextQueue{0};
+    bool m_running = false;
+};
+
+} // namespace SoulsEngine
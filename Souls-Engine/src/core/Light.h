@@ -30,6 +30,10 @@ public:
     void SetAngle(float angle) { m_angle = angle; }
     float GetAngle() const { return m_angle; }
 
+    // 影响范围（世界单位），超出范围的片段不受该光源影响；0表示由衰减参数推导（见 LightClusters）
+    void SetRange(float range) { m_range = range; }
+    float GetRange() const { return m_range; }
+
     // 光源名称
     void SetName(const std::string& name) { m_name = name; }
     std::string GetName() const { return m_name; }
@@ -40,6 +44,7 @@ private:
     glm::vec3 m_color;       // 光源颜色
     float m_intensity;       // 光照强度
     float m_angle;           // 光照张角（0-360度）
+    float m_range = 0.0f;    // 影响范围（0表示由衰减推导）
 };
 
 } // namespace SoulsEngine
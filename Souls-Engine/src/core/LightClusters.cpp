@@ -0,0 +1,284 @@
+#include "LightClusters.h"
+#include "Light.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+
+namespace SoulsEngine {
+
+namespace {
+    // 纹理缓冲的格式：光源数据、簇范围、光源下标
+    const GLenum BufferFormats[3] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+}
+
+LightClusters::LightClusters()
+    : m_clusterMin(ClusterCount)
+    , m_clusterMax(ClusterCount)
+    , m_slicePairs(GridZ)
+    , m_clusterRanges(ClusterCount, glm::uvec2(0))
+{
+}
+
+LightClusters::~LightClusters() {
+    Shutdown();
+}
+
+bool LightClusters::Initialize() {
+    if (m_buffers[0] != 0) {
+        return true;
+    }
+
+    glGenBuffers(3, m_buffers);
+    glGenTextures(3, m_textures);
+    for (int i = 0; i < 3; ++i) {
+        if (m_buffers[i] == 0 || m_textures[i] == 0) {
+            std::cerr << "Failed to create light cluster buffers" << std::endl;
+            Shutdown();
+            return false;
+        }
+    }
+
+    // 纹理缓冲只引用缓冲对象，之后每帧重新指定缓冲的数据即可
+    for (int i = 0; i < 3; ++i) {
+        glBindBuffer(GL_TEXTURE_BUFFER, m_buffers[i]);
+        glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::vec4), nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, BufferFormats[i], m_buffers[i]);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    return true;
+}
+
+void LightClusters::Shutdown() {
+    if (m_buffers[0] != 0) {
+        glDeleteBuffers(3, m_buffers);
+        std::fill(std::begin(m_buffers), std::end(m_buffers), 0u);
+    }
+    if (m_textures[0] != 0) {
+        glDeleteTextures(3, m_textures);
+        std::fill(std::begin(m_textures), std::end(m_textures), 0u);
+    }
+}
+
+void LightClusters::SetAttenuation(float constant, float linear, float quadratic) {
+    m_attenuation = glm::vec3(constant, linear, quadratic);
+}
+
+float LightClusters::GetLightRange(const Light& light) const {
+    if (light.GetRange() > 0.0f) {
+        return light.GetRange();
+    }
+
+    // 解 constant + linear * d + quadratic * d^2 = 最大亮度 / LightCutoff
+    const glm::vec3 color = light.GetColor();
+    const float brightness = light.GetIntensity() * std::max(color.r, std::max(color.g, color.b));
+    const float target = brightness / LightCutoff;
+    const float constant = m_attenuation.x;
+    const float linear = m_attenuation.y;
+    const float quadratic = m_attenuation.z;
+    if (target <= constant) {
+        return 0.0f;
+    }
+    if (quadratic > 0.0f) {
+        return (-linear + std::sqrt(linear * linear + 4.0f * quadratic * (target - constant))) / (2.0f * quadratic);
+    }
+    if (linear > 0.0f) {
+        return (target - constant) / linear;
+    }
+    return FLT_MAX;
+}
+
+void LightClusters::UpdateClusterBounds(const glm::mat4& projection, uint32_t viewportWidth, uint32_t viewportHeight) {
+    m_projection = projection;
+    m_viewportWidth = std::max(viewportWidth, 1u);
+    m_viewportHeight = std::max(viewportHeight, 1u);
+
+    // 从透视投影矩阵还原近/远平面
+    m_nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+    m_farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+
+    // 瓦片向上取整，最后一列/行可以超出视口
+    m_tileSize = glm::vec2(static_cast<float>((m_viewportWidth + GridX - 1) / GridX),
+                           static_cast<float>((m_viewportHeight + GridY - 1) / GridY));
+
+    // 指数切分：第k个切片覆盖 [near * (far/near)^(k/Z), near * (far/near)^((k+1)/Z)]
+    const float logRatio = std::log(m_farPlane / m_nearPlane);
+    m_depthScale = static_cast<float>(GridZ) / logRatio;
+    m_depthBias = -static_cast<float>(GridZ) * std::log(m_nearPlane) / logRatio;
+    for (uint32_t k = 0; k <= GridZ; ++k) {
+        m_sliceDepths[k] = m_nearPlane * std::pow(m_farPlane / m_nearPlane, static_cast<float>(k) / GridZ);
+    }
+
+    // 视图空间x = NDC x * 深度 / P00，包围盒取簇近端和远端的极值
+    const float invScaleX = 1.0f / projection[0][0];
+    const float invScaleY = 1.0f / projection[1][1];
+    for (uint32_t k = 0; k < GridZ; ++k) {
+        const float nearDepth = m_sliceDepths[k];
+        const float farDepth = m_sliceDepths[k + 1];
+        for (uint32_t j = 0; j < GridY; ++j) {
+            const float y0 = j * m_tileSize.y / m_viewportHeight * 2.0f - 1.0f;
+            const float y1 = (j + 1) * m_tileSize.y / m_viewportHeight * 2.0f - 1.0f;
+            for (uint32_t i = 0; i < GridX; ++i) {
+                const float x0 = i * m_tileSize.x / m_viewportWidth * 2.0f - 1.0f;
+                const float x1 = (i + 1) * m_tileSize.x / m_viewportWidth * 2.0f - 1.0f;
+                const uint32_t cluster = i + GridX * (j + GridY * k);
+                m_clusterMin[cluster] = glm::vec3(std::min(x0 * nearDepth, x0 * farDepth) * invScaleX,
+                                                  std::min(y0 * nearDepth, y0 * farDepth) * invScaleY,
+                                                  -farDepth);
+                m_clusterMax[cluster] = glm::vec3(std::max(x1 * nearDepth, x1 * farDepth) * invScaleX,
+                                                  std::max(y1 * nearDepth, y1 * farDepth) * invScaleY,
+                                                  -nearDepth);
+            }
+        }
+    }
+}
+
+void LightClusters::Build(const std::vector<std::shared_ptr<Light>>& lights, const glm::mat4& view,
+                          const glm::mat4& projection, uint32_t viewportWidth, uint32_t viewportHeight,
+                          JobSystem* jobSystem) {
+    if (projection != m_projection || viewportWidth != m_viewportWidth || viewportHeight != m_viewportHeight) {
+        UpdateClusterBounds(projection, viewportWidth, viewportHeight);
+    }
+
+    // 光源数据（按输入顺序，下标0为主光源）和视图空间包围球
+    m_lightData.resize(lights.size() * 2);
+    m_spheres.clear();
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const Light& light = *lights[i];
+        const float range = GetLightRange(light);
+        m_lightData[i * 2] = glm::vec4(light.GetPosition(), range);
+        m_lightData[i * 2 + 1] = glm::vec4(light.GetColor(), light.GetIntensity());
+
+        const glm::vec3 center = glm::vec3(view * glm::vec4(light.GetPosition(), 1.0f));
+        const float depth = -center.z;
+        if (range <= 0.0f || depth + range < m_nearPlane || depth - range > m_farPlane) continue;
+        m_spheres.push_back({ center, range, static_cast<uint32_t>(i) });
+    }
+
+    // 按深度切片分配
+    if (jobSystem) {
+        jobSystem->ParallelFor(GridZ, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t slice = begin; slice < end; ++slice) {
+                AssignSlice(slice);
+            }
+        });
+    } else {
+        for (uint32_t slice = 0; slice < GridZ; ++slice) {
+            AssignSlice(slice);
+        }
+    }
+
+    // 计数排序生成紧凑的下标列表
+    std::fill(m_clusterRanges.begin(), m_clusterRanges.end(), glm::uvec2(0));
+    for (const auto& pairs : m_slicePairs) {
+        for (const glm::uvec2& pair : pairs) {
+            m_clusterRanges[pair.x].y++;
+        }
+    }
+    m_stats = ClusterStats();
+    m_stats.lights = static_cast<uint32_t>(lights.size());
+    uint32_t offset = 0;
+    for (glm::uvec2& range : m_clusterRanges) {
+        range.x = offset;
+        offset += range.y;
+        if (range.y > 0) m_stats.activeClusters++;
+        m_stats.maxLightsPerCluster = std::max(m_stats.maxLightsPerCluster, range.y);
+        range.y = 0;
+    }
+    m_lightIndices.resize(offset);
+    std::vector<uint8_t> lightUsed(lights.size(), 0);
+    for (const auto& pairs : m_slicePairs) {
+        for (const glm::uvec2& pair : pairs) {
+            glm::uvec2& range = m_clusterRanges[pair.x];
+            m_lightIndices[range.x + range.y++] = pair.y;
+            lightUsed[pair.y] = 1;
+        }
+    }
+    m_stats.lightIndices = offset;
+    m_stats.visibleLights = static_cast<uint32_t>(std::count(lightUsed.begin(), lightUsed.end(), 1));
+}
+
+void LightClusters::AssignSlice(uint32_t slice) {
+    std::vector<glm::uvec2>& pairs = m_slicePairs[slice];
+    pairs.clear();
+
+    const float sliceNear = m_sliceDepths[slice];
+    const float sliceFar = m_sliceDepths[slice + 1];
+    const float scaleX = m_projection[0][0];
+    const float scaleY = m_projection[1][1];
+    const float tilesPerNdcX = 0.5f * m_viewportWidth / m_tileSize.x;
+    const float tilesPerNdcY = 0.5f * m_viewportHeight / m_tileSize.y;
+
+    for (const LightSphere& sphere : m_spheres) {
+        const float depth = -sphere.center.z;
+        if (depth + sphere.radius < sliceNear || depth - sphere.radius > sliceFar) continue;
+
+        // 包围球与切片重叠的深度范围内，x/深度 的极值在范围两端取得，得到保守的瓦片范围
+        const float nearDepth = std::max(sliceNear, depth - sphere.radius);
+        const float farDepth = std::min(sliceFar, depth + sphere.radius);
+        const float left = sphere.center.x - sphere.radius;
+        const float right = sphere.center.x + sphere.radius;
+        const float bottom = sphere.center.y - sphere.radius;
+        const float top = sphere.center.y + sphere.radius;
+        const float tileX0 = (std::min(left / nearDepth, left / farDepth) * scaleX + 1.0f) * tilesPerNdcX;
+        const float tileX1 = (std::max(right / nearDepth, right / farDepth) * scaleX + 1.0f) * tilesPerNdcX;
+        const float tileY0 = (std::min(bottom / nearDepth, bottom / farDepth) * scaleY + 1.0f) * tilesPerNdcY;
+        const float tileY1 = (std::max(top / nearDepth, top / farDepth) * scaleY + 1.0f) * tilesPerNdcY;
+        if (tileX1 < 0.0f || tileY1 < 0.0f || tileX0 >= GridX || tileY0 >= GridY) continue;
+
+        const uint32_t i0 = static_cast<uint32_t>(std::max(tileX0, 0.0f));
+        const uint32_t i1 = std::min(static_cast<uint32_t>(tileX1), GridX - 1);
+        const uint32_t j0 = static_cast<uint32_t>(std::max(tileY0, 0.0f));
+        const uint32_t j1 = std::min(static_cast<uint32_t>(tileY1), GridY - 1);
+
+        // 逐簇精确测试包围球与簇包围盒
+        const float radiusSquared = sphere.radius * sphere.radius;
+        for (uint32_t j = j0; j <= j1; ++j) {
+            for (uint32_t i = i0; i <= i1; ++i) {
+                const uint32_t cluster = i + GridX * (j + GridY * slice);
+                const glm::vec3 closest = glm::clamp(sphere.center, m_clusterMin[cluster], m_clusterMax[cluster]);
+                const glm::vec3 delta = closest - sphere.center;
+                if (glm::dot(delta, delta) <= radiusSquared) {
+                    pairs.push_back(glm::uvec2(cluster, sphere.index));
+                }
+            }
+        }
+    }
+}
+
+void LightClusters::Upload() {
+    if (m_buffers[0] == 0) return;
+
+    // 缓冲不能为空，没有数据时上传一个占位元素
+    const glm::vec4 emptyLight(0.0f);
+    const uint32_t emptyIndex = 0;
+    const void* data[3] = {
+        m_lightData.empty() ? static_cast<const void*>(&emptyLight) : m_lightData.data(),
+        m_clusterRanges.data(),
+        m_lightIndices.empty() ? static_cast<const void*>(&emptyIndex) : m_lightIndices.data()
+    };
+    const size_t sizes[3] = {
+        m_lightData.empty() ? sizeof(emptyLight) : m_lightData.size() * sizeof(glm::vec4),
+        m_clusterRanges.size() * sizeof(glm::uvec2),
+        m_lightIndices.empty() ? sizeof(emptyIndex) : m_lightIndices.size() * sizeof(uint32_t)
+    };
+
+    // 每帧重新指定数据存储（丢弃旧数据，避免等待上一帧的绘制）
+    for (int i = 0; i < 3; ++i) {
+        glBindBuffer(GL_TEXTURE_BUFFER, m_buffers[i]);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(sizes[i]), data[i], GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LightClusters::BindTextures() const {
+    for (GLuint i = 0; i < 3; ++i) {
+        glActiveTexture(GL_TEXTURE0 + TextureUnit + i);
+        glBindTexture(GL_TEXTURE_BUFFER, m_textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+} // namespace SoulsEngine
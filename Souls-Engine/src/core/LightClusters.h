@@ -0,0 +1,135 @@
+#pragma once
+
+#include "JobSystem.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Light;
+
+// 一帧分簇的统计
+struct ClusterStats {
+    uint32_t lights = 0;                // 输入的光源数
+    uint32_t visibleLights = 0;         // 至少影响一个簇的光源数
+    uint32_t lightIndices = 0;          // 所有簇的光源列表总长度
+    uint32_t activeClusters = 0;        // 至少有一个光源的簇
+    uint32_t maxLightsPerCluster = 0;   // 单个簇中最多的光源数
+};
+
+// 分簇光照（Clustered Forward） - 把视锥体按屏幕瓦片和指数分布的视图深度切分成三维簇网格，
+// 每帧在CPU上把光源按影响范围（包围球）分配到与之相交的簇，片段着色器只计算所在簇中的光源
+//
+// 光源数据、每个簇的(起始下标, 数量)和光源下标列表分别写入三个纹理缓冲（TBO），
+// 片段着色器通过samplerBuffer / usamplerBuffer读取（OpenGL 3.3没有SSBO）。
+// 网格参数和衰减参数由FrameUniforms::SetLightClusters写入ClusterData块
+//
+// 光源的影响范围取Light::GetRange()，为0时由衰减参数推导：直接光照衰减到1/256以下的距离。
+// 着色器在范围边缘做平滑过渡，截断不会产生可见的边界
+//
+// 一帧的流程：
+//   Build    光源变换到视图空间，按深度切片并行分配到簇（JobSystem），生成紧凑的下标列表
+//   Upload   上传三个纹理缓冲
+//   FrameUniforms::SetLightClusters + BindTextures   主通道使用
+class LightClusters {
+public:
+    // 簇网格尺寸（屏幕瓦片 x 深度切片）
+    static constexpr uint32_t GridX = 16;
+    static constexpr uint32_t GridY = 9;
+    static constexpr uint32_t GridZ = 24;
+    static constexpr uint32_t ClusterCount = GridX * GridY * GridZ;
+
+    // 三个纹理缓冲使用的纹理单元：TextureUnit（光源）、+1（簇范围）、+2（光源下标）
+    static constexpr GLuint TextureUnit = 5;
+
+    // 推导影响范围时的直接光照阈值
+    static constexpr float LightCutoff = 1.0f / 256.0f;
+
+    LightClusters();
+    ~LightClusters();
+
+    // 禁止拷贝（持有GL缓冲）
+    LightClusters(const LightClusters&) = delete;
+    LightClusters& operator=(const LightClusters&) = delete;
+
+    // 创建纹理缓冲（需要有效的OpenGL上下文）
+    bool Initialize();
+    void Shutdown();
+
+    // 光源距离衰减参数（所有光源共用，默认与FrameUniforms一致：1, 0.09, 0.032）
+    void SetAttenuation(float constant, float linear, float quadratic);
+    const glm::vec3& GetAttenuation() const { return m_attenuation; }
+
+    // 把光源分配到簇
+    // view/projection为相机矩阵（对称透视投影），viewportWidth/Height为主通道视口尺寸（像素）
+    // jobSystem非空时按深度切片并行分配
+    void Build(const std::vector<std::shared_ptr<Light>>& lights, const glm::mat4& view, const glm::mat4& projection,
+               uint32_t viewportWidth, uint32_t viewportHeight, JobSystem* jobSystem = nullptr);
+
+    // 上传Build的结果
+    void Upload();
+
+    // 把三个纹理缓冲绑定到TextureUnit开始的纹理单元
+    void BindTextures() const;
+
+    // 光源的影响范围（世界单位）
+    float GetLightRange(const Light& light) const;
+
+    // 着色器参数（Build之后有效）
+    const glm::vec2& GetTileSize() const { return m_tileSize; }
+    float GetDepthScale() const { return m_depthScale; }
+    float GetDepthBias() const { return m_depthBias; }
+
+    // CPU端结果（按簇的(起始下标, 数量)和光源下标列表）
+    const std::vector<glm::uvec2>& GetClusterRanges() const { return m_clusterRanges; }
+    const std::vector<uint32_t>& GetLightIndices() const { return m_lightIndices; }
+
+    const ClusterStats& GetStats() const { return m_stats; }
+
+private:
+    // 视图空间的光源包围球
+    struct LightSphere {
+        glm::vec3 center;
+        float radius;
+        uint32_t index;
+    };
+
+    // 投影或视口变化时重新计算每个簇的视图空间包围盒
+    void UpdateClusterBounds(const glm::mat4& projection, uint32_t viewportWidth, uint32_t viewportHeight);
+
+    // 分配一个深度切片，结果按(簇, 光源)对写入m_slicePairs[slice]
+    void AssignSlice(uint32_t slice);
+
+    glm::vec3 m_attenuation = glm::vec3(1.0f, 0.09f, 0.032f);
+
+    // 网格参数
+    glm::mat4 m_projection = glm::mat4(0.0f);
+    uint32_t m_viewportWidth = 0;
+    uint32_t m_viewportHeight = 0;
+    float m_nearPlane = 0.1f;
+    float m_farPlane = 100.0f;
+    glm::vec2 m_tileSize = glm::vec2(1.0f);
+    float m_depthScale = 0.0f;    // 切片 = log(视图深度) * scale + bias
+    float m_depthBias = 0.0f;
+    float m_sliceDepths[GridZ + 1] = {};
+    std::vector<glm::vec3> m_clusterMin;   // 簇的视图空间包围盒
+    std::vector<glm::vec3> m_clusterMax;
+
+    // 每帧数据
+    std::vector<LightSphere> m_spheres;
+    std::vector<glm::vec4> m_lightData;                   // 每个光源两个texel：(位置, 范围), (颜色, 强度)
+    std::vector<std::vector<glm::uvec2>> m_slicePairs;    // 每个切片的(簇, 光源)对
+    std::vector<glm::uvec2> m_clusterRanges;
+    std::vector<uint32_t> m_lightIndices;
+    ClusterStats m_stats;
+
+    // 纹理缓冲：光源数据、簇范围、光源下标
+    GLuint m_buffers[3] = { 0, 0, 0 };
+    GLuint m_textures[3] = { 0, 0, 0 };
+};
+
+} // namespace SoulsEngine
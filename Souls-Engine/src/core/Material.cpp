@@ -1,7 +1,21 @@
 #include "Material.h"
+#include <atomic>
 
 namespace SoulsEngine {
 
+namespace {
+    std::atomic<uint32_t> s_nextMaterialSortId{ 1 };
+    std::atomic<uint64_t> s_revision{ 0 };
+}
+
+uint64_t Material::GetRevision() {
+    return s_revision.load(std::memory_order_relaxed);
+}
+
+void Material::MarkChanged() {
+    s_revision.fetch_add(1, std::memory_order_relaxed);
+}
+
 Material::Material()
     : m_name("DefaultMaterial")
     , m_ambient(0.2f, 0.2f, 0.2f)
@@ -9,6 +23,7 @@ Material::Material()
     , m_specular(1.0f, 1.0f, 1.0f)
     , m_shininess(32.0f)
     , m_alpha(1.0f)
+    , m_sortId(s_nextMaterialSortId.fetch_add(1, std::memory_order_relaxed))
 {
 }
 
@@ -19,6 +34,7 @@ Material::Material(const glm::vec3& ambient, const glm::vec3& diffuse, const glm
     , m_specular(specular)
     , m_shininess(shininess)
     , m_alpha(alpha)
+    , m_sortId(s_nextMaterialSortId.fetch_add(1, std::memory_order_relaxed))
 {
 }
 
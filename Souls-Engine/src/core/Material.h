@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 
 namespace SoulsEngine {
@@ -13,32 +14,33 @@ public:
     ~Material() = default;
 
     // 环境光颜色（Ambient）
-    void SetAmbient(const glm::vec3& ambient) { m_ambient = ambient; }
-    void SetAmbient(float r, float g, float b) { m_ambient = glm::vec3(r, g, b); }
+    void SetAmbient(const glm::vec3& ambient) { m_ambient = ambient; MarkChanged(); }
+    void SetAmbient(float r, float g, float b) { SetAmbient(glm::vec3(r, g, b)); }
     glm::vec3 GetAmbient() const { return m_ambient; }
 
     // 漫反射颜色（Diffuse）
-    void SetDiffuse(const glm::vec3& diffuse) { m_diffuse = diffuse; }
-    void SetDiffuse(float r, float g, float b) { m_diffuse = glm::vec3(r, g, b); }
+    void SetDiffuse(const glm::vec3& diffuse) { m_diffuse = diffuse; MarkChanged(); }
+    void SetDiffuse(float r, float g, float b) { SetDiffuse(glm::vec3(r, g, b)); }
     glm::vec3 GetDiffuse() const { return m_diffuse; }
 
     // 镜面反射颜色（Specular）
-    void SetSpecular(const glm::vec3& specular) { m_specular = specular; }
-    void SetSpecular(float r, float g, float b) { m_specular = glm::vec3(r, g, b); }
+    void SetSpecular(const glm::vec3& specular) { m_specular = specular; MarkChanged(); }
+    void SetSpecular(float r, float g, float b) { SetSpecular(glm::vec3(r, g, b)); }
     glm::vec3 GetSpecular() const { return m_specular; }
 
     // 光泽度（Shininess）
-    void SetShininess(float shininess) { m_shininess = shininess; }
+    void SetShininess(float shininess) { m_shininess = shininess; MarkChanged(); }
     float GetShininess() const { return m_shininess; }
 
     // 透明度（0=完全透明，1=完全不透明）
-    void SetAlpha(float alpha) { m_alpha = alpha; }
+    void SetAlpha(float alpha) { m_alpha = alpha; MarkChanged(); }
     float GetAlpha() const { return m_alpha; }
 
     // 设置基础颜色（同时设置环境光和漫反射）
     void SetColor(const glm::vec3& color) {
         m_ambient = color * 0.2f;  // 环境光通常是基础颜色的20%
         m_diffuse = color;
+        MarkChanged();
     }
     void SetColor(float r, float g, float b) {
         SetColor(glm::vec3(r, g, b));
@@ -49,6 +51,14 @@ public:
     void SetName(const std::string& name) { m_name = name; }
     std::string GetName() const { return m_name; }
 
+    // 渲染队列排序键使用的材质编号（构造时分配；拷贝得到的材质沿用原编号，只影响排序分组）
+    uint32_t GetSortId() const { return m_sortId; }
+
+    // 全局修改计数：任何材质参数被修改（或节点更换材质）时递增，
+    // 缓存了材质数据的系统（如GpuCuller的实例缓冲）据此判断是否需要重新上传
+    static uint64_t GetRevision();
+    static void MarkChanged();
+
     // 创建预设材质
     static Material CreateDefault();
     static Material CreateEmerald();
@@ -66,6 +76,7 @@ private:
     glm::vec3 m_specular;     // 镜面反射颜色
     float m_shininess;        // 光泽度（0-128）
     float m_alpha;            // 透明度 0-1
+    uint32_t m_sortId;        // 排序编号
 };
 
 } // namespace SoulsEngine
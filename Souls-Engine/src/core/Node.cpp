@@ -7,11 +7,7 @@ namespace SoulsEngine {
 Node::Node(const std::string& name)
     : m_name(name)
     , m_parent(nullptr)
-    , m_position(0.0f, 0.0f, 0.0f)
-    , m_rotation(0.0f, 0.0f, 0.0f)
-    , m_scale(1.0f, 1.0f, 1.0f)
-    , m_localTransform(1.0f)
-    , m_transformDirty(true)
+    , m_transformId(TransformSystem::Get().Create())
 {
 }
 
@@ -24,10 +20,14 @@ Node::~Node() {
     // 清除所有子节点的父指针
     for (auto& child : m_children) {
         if (child) {
+            child->MarkWorldDirty();
             child->m_parent = nullptr;
+            TransformSystem::Get().SetParent(child->m_transformId, InvalidTransformId);
         }
     }
     m_children.clear();
+
+    TransformSystem::Get().Destroy(m_transformId);
 }
 
 void Node::AddChild(std::shared_ptr<Node> child) {
@@ -39,7 +39,9 @@ void Node::AddChild(std::shared_ptr<Node> child) {
     }
     
     m_children.push_back(child);
+    child->MarkWorldDirty();
     child->m_parent = this;
+    TransformSystem::Get().SetParent(child->m_transformId, m_transformId);
 }
 
 void Node::RemoveChild(std::shared_ptr<Node> child) {
@@ -56,11 +58,26 @@ void Node::RemoveChild(Node* child) {
         });
     
     if (it != m_children.end()) {
+        (*it)->MarkWorldDirty();
         (*it)->m_parent = nullptr;
+        TransformSystem::Get().SetParent((*it)->m_transformId, InvalidTransformId);
         m_children.erase(it);
     }
 }
 
+void Node::RemoveAllChildren() {
+    // 先整体移出列表再逐个断开，避免子节点析构时回调RemoveChild修改正在遍历的列表
+    std::vector<std::shared_ptr<Node>> children;
+    children.swap(m_children);
+    for (auto& child : children) {
+        if (child) {
+            child->MarkWorldDirty();
+            child->m_parent = nullptr;
+            TransformSystem::Get().SetParent(child->m_transformId, InvalidTransformId);
+        }
+    }
+}
+
 void Node::SetParent(Node* parent) {
     if (parent == m_parent) return;
     
@@ -77,44 +94,52 @@ void Node::SetParent(Node* parent) {
     }
     
     // 设置新父节点
+    MarkWorldDirty();
     m_parent = parent;
+    TransformSystem::Get().SetParent(m_transformId, parent ? parent->m_transformId : InvalidTransformId);
     // 注意：SetParent不应该自动添加到父节点的子节点列表
     // 应该由外部通过AddChild来管理，避免循环引用
 }
 
 glm::mat4 Node::GetLocalTransform() const {
-    if (m_transformDirty) {
-        // 计算局部变换矩阵：T * R * S
-        // 正确的顺序：先平移，再旋转，最后缩放
-        // 这样旋转会围绕物体自身的位置进行，而不是围绕原点
-        m_localTransform = glm::mat4(1.0f);
-        // 1. 先平移到物体位置
-        m_localTransform = glm::translate(m_localTransform, m_position);
-        // 2. 然后旋转（围绕物体位置，因为已经平移了）
-        m_localTransform = glm::rotate(m_localTransform, glm::radians(m_rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-        m_localTransform = glm::rotate(m_localTransform, glm::radians(m_rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-        m_localTransform = glm::rotate(m_localTransform, glm::radians(m_rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-        // 3. 最后缩放
-        m_localTransform = glm::scale(m_localTransform, m_scale);
-        m_transformDirty = false;
-    }
-    return m_localTransform;
+    return TransformSystem::Get().GetLocalMatrix(m_transformId);
 }
 
 glm::mat4 Node::GetWorldTransform() const {
-    glm::mat4 worldTransform = GetLocalTransform();
-    // 递归计算父节点变换
-    Node* parent = m_parent;
-    while (parent) {
-        worldTransform = parent->GetLocalTransform() * worldTransform;
-        parent = parent->m_parent;
+    // 世界矩阵缓存在TransformSystem中，沿父链只重新计算脏的部分
+    return TransformSystem::Get().GetWorldMatrix(m_transformId);
+}
+
+glm::mat4 Node::GetInverseWorldTransform() const {
+    return TransformSystem::Get().GetInverseWorldMatrix(m_transformId);
+}
+
+void Node::MarkWorldDirty() {
+    // 已经是脏的节点，其子树也必然是脏的（世界矩阵总是先计算父节点），可以提前返回
+    TransformSystem& transforms = TransformSystem::Get();
+    if (transforms.IsWorldDirty(m_transformId)) return;
+    transforms.MarkWorldDirty(m_transformId);
+    if (m_children.empty()) return;
+
+    // 用显式栈遍历子树，不递归（很深的层级也不会耗尽调用栈）
+    std::vector<Node*> pending;
+    for (auto& child : m_children) {
+        if (child) pending.push_back(child.get());
+    }
+    while (!pending.empty()) {
+        Node* node = pending.back();
+        pending.pop_back();
+        if (transforms.IsWorldDirty(node->m_transformId)) continue;
+        transforms.MarkWorldDirty(node->m_transformId);
+        for (auto& child : node->m_children) {
+            if (child) pending.push_back(child.get());
+        }
     }
-    return worldTransform;
 }
 
 void Node::Update() {
-    // 更新自己的变换矩阵
-    GetLocalTransform();
+    // 更新自己的变换矩阵（父节点已在递归中先行更新）
+    GetWorldTransform();
     
     // 更新所有子节点
     for (auto& child : m_children) {
@@ -131,9 +156,7 @@ glm::vec3 Node::LocalToWorld(const glm::vec3& localPoint) const {
 }
 
 glm::vec3 Node::WorldToLocal(const glm::vec3& worldPoint) const {
-    glm::mat4 worldTransform = GetWorldTransform();
-    glm::mat4 inverseMatrix = glm::inverse(worldTransform);
-    glm::vec4 localPoint = inverseMatrix * glm::vec4(worldPoint, 1.0f);
+    glm::vec4 localPoint = GetInverseWorldTransform() * glm::vec4(worldPoint, 1.0f);
     return glm::vec3(localPoint);
 }
 
@@ -147,12 +170,8 @@ glm::vec3 Node::LocalDirectionToWorld(const glm::vec3& localDirection) const {
 }
 
 glm::vec3 Node::WorldDirectionToLocal(const glm::vec3& worldDirection) const {
-    // 方向向量不考虑平移
-    glm::mat4 worldTransform = GetWorldTransform();
-    glm::mat4 rotationScaleMatrix = worldTransform;
-    rotationScaleMatrix[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-    glm::mat4 inverseMatrix = glm::inverse(rotationScaleMatrix);
-    glm::vec4 localDirection = inverseMatrix * glm::vec4(worldDirection, 0.0f);
+    // 方向向量不考虑平移（仿射矩阵逆的左上3x3即旋转缩放部分的逆）
+    glm::vec4 localDirection = GetInverseWorldTransform() * glm::vec4(worldDirection, 0.0f);
     return glm::normalize(glm::vec3(localDirection));
 }
 
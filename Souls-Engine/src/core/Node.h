@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "TransformSystem.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -10,6 +11,7 @@ namespace SoulsEngine {
 
 // 前向声明
 class Mesh;
+class SceneNode;
 
 // 场景节点类
 class Node {
@@ -21,43 +23,46 @@ public:
     Node(const Node&) = delete;
     Node& operator=(const Node&) = delete;
 
-    // 节点名称
+    // 节点名称（SceneNode重写SetName，注册后的节点改名时同步ObjectManager的名称索引）
     std::string GetName() const { return m_name; }
-    void SetName(const std::string& name) { m_name = name; }
+    virtual void SetName(const std::string& name) { m_name = name; }
 
     // 父子关系
     void AddChild(std::shared_ptr<Node> child);
     void RemoveChild(std::shared_ptr<Node> child);
     void RemoveChild(Node* child);
+    void RemoveAllChildren();
     void SetParent(Node* parent);
     Node* GetParent() const { return m_parent; }
     const std::vector<std::shared_ptr<Node>>& GetChildren() const { return m_children; }
     std::vector<std::shared_ptr<Node>>& GetChildren() { return m_children; }
 
-    // 变换 - 设置
-    void SetPosition(const glm::vec3& position) { m_position = position; m_transformDirty = true; }
-    void SetPosition(float x, float y, float z) { m_position = glm::vec3(x, y, z); m_transformDirty = true; }
-    void SetRotation(const glm::vec3& rotation) { m_rotation = rotation; m_transformDirty = true; }
-    void SetRotation(float x, float y, float z) { m_rotation = glm::vec3(x, y, z); m_transformDirty = true; }
-    void SetScale(const glm::vec3& scale) { m_scale = scale; m_transformDirty = true; }
-    void SetScale(float x, float y, float z) { m_scale = glm::vec3(x, y, z); m_transformDirty = true; }
-    void SetScale(float uniform) { m_scale = glm::vec3(uniform); m_transformDirty = true; }
+    // 变换 - 设置（数据存放在TransformSystem中，先传播脏标记再写入）
+    void SetPosition(const glm::vec3& position) { MarkWorldDirty(); TransformSystem::Get().SetPosition(m_transformId, position); }
+    void SetPosition(float x, float y, float z) { SetPosition(glm::vec3(x, y, z)); }
+    void SetRotation(const glm::vec3& rotation) { MarkWorldDirty(); TransformSystem::Get().SetRotation(m_transformId, rotation); }
+    void SetRotation(float x, float y, float z) { SetRotation(glm::vec3(x, y, z)); }
+    void SetOrientation(const glm::quat& orientation) { MarkWorldDirty(); TransformSystem::Get().SetOrientation(m_transformId, orientation); }
+    void SetScale(const glm::vec3& scale) { MarkWorldDirty(); TransformSystem::Get().SetScale(m_transformId, scale); }
+    void SetScale(float x, float y, float z) { SetScale(glm::vec3(x, y, z)); }
+    void SetScale(float uniform) { SetScale(glm::vec3(uniform)); }
     
     // 变换 - 获取
-    glm::vec3 GetPosition() const { return m_position; }
-    glm::vec3 GetRotation() const { return m_rotation; }
-    glm::vec3 GetScale() const { return m_scale; }
+    glm::vec3 GetPosition() const { return TransformSystem::Get().GetPosition(m_transformId); }
+    glm::vec3 GetRotation() const { return TransformSystem::Get().GetRotation(m_transformId); }
+    glm::quat GetOrientation() const { return TransformSystem::Get().GetOrientation(m_transformId); }
+    glm::vec3 GetScale() const { return TransformSystem::Get().GetScale(m_transformId); }
     
     // 变换 - 相对变换（增量）
-    void Translate(const glm::vec3& translation) { m_position += translation; m_transformDirty = true; }
-    void Translate(float x, float y, float z) { m_position += glm::vec3(x, y, z); m_transformDirty = true; }
-    void Rotate(const glm::vec3& rotation) { m_rotation += rotation; m_transformDirty = true; }
-    void Rotate(float x, float y, float z) { m_rotation += glm::vec3(x, y, z); m_transformDirty = true; }
-    void RotateX(float angle) { m_rotation.x += angle; m_transformDirty = true; }
-    void RotateY(float angle) { m_rotation.y += angle; m_transformDirty = true; }
-    void RotateZ(float angle) { m_rotation.z += angle; m_transformDirty = true; }
-    void Scale(const glm::vec3& scale) { m_scale *= scale; m_transformDirty = true; }
-    void Scale(float uniform) { m_scale *= uniform; m_transformDirty = true; }
+    void Translate(const glm::vec3& translation) { SetPosition(GetPosition() + translation); }
+    void Translate(float x, float y, float z) { Translate(glm::vec3(x, y, z)); }
+    void Rotate(const glm::vec3& rotation) { SetRotation(GetRotation() + rotation); }
+    void Rotate(float x, float y, float z) { Rotate(glm::vec3(x, y, z)); }
+    void RotateX(float angle) { Rotate(glm::vec3(angle, 0.0f, 0.0f)); }
+    void RotateY(float angle) { Rotate(glm::vec3(0.0f, angle, 0.0f)); }
+    void RotateZ(float angle) { Rotate(glm::vec3(0.0f, 0.0f, angle)); }
+    void Scale(const glm::vec3& scale) { SetScale(GetScale() * scale); }
+    void Scale(float uniform) { SetScale(GetScale() * uniform); }
     
     // 坐标转换
     glm::vec3 LocalToWorld(const glm::vec3& localPoint) const;
@@ -68,24 +73,26 @@ public:
     // 变换矩阵
     glm::mat4 GetLocalTransform() const;
     glm::mat4 GetWorldTransform() const;
+    glm::mat4 GetInverseWorldTransform() const;
+    TransformId GetTransformId() const { return m_transformId; }
+
+    // 类型查询：渲染遍历按此区分可绘制节点，不使用dynamic_cast（SceneNode返回自身）
+    virtual const SceneNode* AsSceneNode() const { return nullptr; }
 
     // 更新和渲染
     virtual void Update();
     virtual void Render(const glm::mat4& parentTransform, class Shader* shader) {}
 
 protected:
+    // 使整棵子树的世界变换失效
+    void MarkWorldDirty();
+
     std::string m_name;
     Node* m_parent;
     mutable std::vector<std::shared_ptr<Node>> m_children;
 
-    // 局部变换
-    glm::vec3 m_position;
-    glm::vec3 m_rotation;  // 欧拉角（度）
-    glm::vec3 m_scale;
-
-    // 变换矩阵缓存
-    mutable glm::mat4 m_localTransform;
-    mutable bool m_transformDirty;
+    // 变换数据句柄（局部TRS与矩阵缓存都在TransformSystem中）
+    TransformId m_transformId;
 };
 
 } // namespace SoulsEngine
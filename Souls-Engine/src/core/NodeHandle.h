@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace SoulsEngine {
+
+// 节点句柄 - 32位代数句柄（低20位为槽位索引，高12位为代数）
+// 节点被移除后槽位的代数加一，旧句柄因代数不匹配而失效；值0保留为空句柄
+struct NodeHandle {
+    static constexpr uint32_t IndexBits = 20;
+    static constexpr uint32_t IndexMask = (1u << IndexBits) - 1u;
+    static constexpr uint32_t GenerationMask = (1u << (32 - IndexBits)) - 1u;
+
+    uint32_t value = 0;
+
+    NodeHandle() = default;
+    NodeHandle(uint32_t index, uint32_t generation)
+        : value((generation << IndexBits) | (index & IndexMask)) {}
+
+    uint32_t GetIndex() const { return value & IndexMask; }
+    uint32_t GetGeneration() const { return value >> IndexBits; }
+    bool IsNull() const { return value == 0; }
+    explicit operator bool() const { return value != 0; }
+
+    bool operator==(const NodeHandle& other) const { return value == other.value; }
+    bool operator!=(const NodeHandle& other) const { return value != other.value; }
+};
+
+} // namespace SoulsEngine
+
+namespace std {
+template <>
+struct hash<SoulsEngine::NodeHandle> {
+    size_t operator()(const SoulsEngine::NodeHandle& handle) const noexcept {
+        return std::hash<uint32_t>()(handle.value);
+    }
+};
+} // namespace std
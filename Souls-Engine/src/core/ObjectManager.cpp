@@ -1,10 +1,13 @@
 #include "ObjectManager.h"
 #include "Shader.h"
 #include "../geometry/Mesh.h"
+#include <iostream>
 
 namespace SoulsEngine {
 
-ObjectManager::ObjectManager() {
+ObjectManager::ObjectManager()
+    : m_nameIndexEnabled(true)
+{
 }
 
 ObjectManager::~ObjectManager() {
@@ -15,71 +18,270 @@ std::shared_ptr<SceneNode> ObjectManager::CreateNode(const std::string& name, st
     auto node = std::make_shared<SceneNode>(name);
     node->SetMesh(mesh);
     
-    // 添加到场景和映射表
-    m_scene.AddNode(node);
-    m_nodes[name] = node;
+    // 添加到场景和槽位表
+    AddNode(node);
     
     return node;
 }
 
-void ObjectManager::AddNode(std::shared_ptr<SceneNode> node) {
-    if (!node) return;
-    
-    std::string name = node->GetName();
+NodeHandle ObjectManager::AddNode(std::shared_ptr<SceneNode> node) {
+    if (!node) return NodeHandle();
+
+    // 已经注册过的节点直接返回原句柄
+    if (GetNode(node->GetHandle()) == node.get()) {
+        return node->GetHandle();
+    }
+
+    uint32_t index;
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_slots.size());
+        if (index > NodeHandle::IndexMask) {
+            std::cerr << "ObjectManager: 节点数量超出句柄索引范围" << std::endl;
+            return NodeHandle();
+        }
+        m_slots.emplace_back();
+    }
+
+    NodeSlot& slot = m_slots[index];
+    slot.node = node;
+    slot.denseIndex = static_cast<uint32_t>(m_denseNodes.size());
+    m_denseNodes.push_back(node.get());
+    m_denseToSlot.push_back(index);
+
+    NodeHandle handle(index, slot.generation);
+    node->SetHandle(handle, this);
+
     m_scene.AddNode(node);
-    m_nodes[name] = node;
+    m_bvhDirty = true;
+    ++m_structureVersion;
+    if (m_nameIndexEnabled) {
+        m_nameIndex[node->GetName()] = handle;
+    }
+    return handle;
 }
 
 void ObjectManager::RemoveNode(const std::string& name) {
-    auto it = m_nodes.find(name);
-    if (it != m_nodes.end()) {
-        m_scene.RemoveNode(it->second);
-        m_nodes.erase(it);
-    }
+    RemoveNode(FindHandle(name));
 }
 
 void ObjectManager::RemoveNode(std::shared_ptr<SceneNode> node) {
     if (!node) return;
     
-    std::string name = node->GetName();
+    if (GetNode(node->GetHandle()) == node.get()) {
+        RemoveNode(node->GetHandle());
+    } else {
+        m_scene.RemoveNode(node);
+    }
+}
+
+void ObjectManager::RemoveNode(NodeHandle handle) {
+    if (!IsValid(handle)) return;
+
+    uint32_t index = handle.GetIndex();
+    NodeSlot& slot = m_slots[index];
+    std::shared_ptr<SceneNode> node = std::move(slot.node);
+
+    // 从紧凑数组中移除（与末尾交换）
+    uint32_t denseIndex = slot.denseIndex;
+    uint32_t lastIndex = static_cast<uint32_t>(m_denseNodes.size()) - 1;
+    if (denseIndex != lastIndex) {
+        m_denseNodes[denseIndex] = m_denseNodes[lastIndex];
+        m_denseToSlot[denseIndex] = m_denseToSlot[lastIndex];
+        m_slots[m_denseToSlot[denseIndex]].denseIndex = denseIndex;
+    }
+    m_denseNodes.pop_back();
+    m_denseToSlot.pop_back();
+
+    // 代数加一使旧句柄失效（跳过0以保证句柄值不为空）
+    slot.generation = (slot.generation + 1) & NodeHandle::GenerationMask;
+    if (slot.generation == 0) slot.generation = 1;
+    m_freeSlots.push_back(index);
+
+    RemoveFromNameIndex(node->GetName(), handle);
+    node->SetHandle(NodeHandle());
     m_scene.RemoveNode(node);
-    m_nodes.erase(name);
+    m_bvhDirty = true;
+    ++m_structureVersion;
+}
+
+SceneNode* ObjectManager::GetNode(NodeHandle handle) const {
+    if (handle.IsNull()) return nullptr;
+    uint32_t index = handle.GetIndex();
+    if (index >= m_slots.size()) return nullptr;
+    const NodeSlot& slot = m_slots[index];
+    if (slot.generation != handle.GetGeneration() || !slot.node) return nullptr;
+    return slot.node.get();
+}
+
+std::shared_ptr<SceneNode> ObjectManager::GetSharedNode(NodeHandle handle) const {
+    if (!GetNode(handle)) return nullptr;
+    return m_slots[handle.GetIndex()].node;
+}
+
+bool ObjectManager::IsValid(NodeHandle handle) const {
+    return GetNode(handle) != nullptr;
+}
+
+NodeHandle ObjectManager::FindHandle(const std::string& name) const {
+    if (m_nameIndexEnabled) {
+        auto it = m_nameIndex.find(name);
+        return (it != m_nameIndex.end() && IsValid(it->second)) ? it->second : NodeHandle();
+    }
+
+    // 未启用名称索引时遍历已注册的节点
+    for (SceneNode* node : m_denseNodes) {
+        if (node->GetName() == name) {
+            return node->GetHandle();
+        }
+    }
+    return NodeHandle();
 }
 
 std::shared_ptr<SceneNode> ObjectManager::FindNode(const std::string& name) const {
-    auto it = m_nodes.find(name);
-    if (it != m_nodes.end()) {
-        return it->second;
+    NodeHandle handle = FindHandle(name);
+    if (IsValid(handle)) {
+        return m_slots[handle.GetIndex()].node;
     }
     
-    // 如果映射表中没有，尝试从场景中查找
+    // 如果槽位表中没有，尝试从场景中查找
     auto sceneNode = m_scene.FindNodeByName(name);
     return std::dynamic_pointer_cast<SceneNode>(sceneNode);
 }
 
+void ObjectManager::SetNameIndexEnabled(bool enabled) {
+    if (m_nameIndexEnabled == enabled) return;
+    m_nameIndexEnabled = enabled;
+    m_nameIndex.clear();
+    if (enabled) {
+        for (SceneNode* node : m_denseNodes) {
+            m_nameIndex[node->GetName()] = node->GetHandle();
+        }
+    }
+}
+
+void ObjectManager::OnNodeRenamed(const std::string& oldName, SceneNode& node) {
+    if (!m_nameIndexEnabled || GetNode(node.GetHandle()) != &node) return;
+    RemoveFromNameIndex(oldName, node.GetHandle());
+    m_nameIndex[node.GetName()] = node.GetHandle();
+}
+
+void ObjectManager::RemoveFromNameIndex(const std::string& name, NodeHandle handle) {
+    if (!m_nameIndexEnabled) return;
+    auto it = m_nameIndex.find(name);
+    if (it == m_nameIndex.end() || it->second != handle) return;
+
+    // 重名时让索引指向剩下的同名节点
+    m_nameIndex.erase(it);
+    for (SceneNode* node : m_denseNodes) {
+        if (node->GetName() == name) {
+            m_nameIndex[name] = node->GetHandle();
+            break;
+        }
+    }
+}
+
 std::vector<std::shared_ptr<SceneNode>> ObjectManager::GetAllNodes() const {
     std::vector<std::shared_ptr<SceneNode>> nodes;
-    nodes.reserve(m_nodes.size());
+    nodes.reserve(m_denseToSlot.size());
     
-    for (const auto& pair : m_nodes) {
-        nodes.push_back(pair.second);
+    for (uint32_t index : m_denseToSlot) {
+        nodes.push_back(m_slots[index].node);
     }
     
     return nodes;
 }
 
+LODStats ObjectManager::UpdateLODs(const LODContext& context) {
+    LODStats stats;
+    for (SceneNode* node : m_denseNodes) {
+        const auto& meshLOD = node->GetMeshLOD();
+        if (!meshLOD) continue;
+        stats.nodes++;
+        if (node->SelectLOD(context)) {
+            stats.levelChanges++;
+        }
+        stats.triangles += static_cast<uint32_t>(node->GetMesh()->GetDrawCount() / 3);
+        stats.fullDetailTriangles += static_cast<uint32_t>(meshLOD->GetLevel(0).mesh->GetDrawCount() / 3);
+    }
+    return stats;
+}
+
+BoundingBox ObjectManager::ComputeWorldBounds(uint32_t layerMask) {
+    TransformSystem& transforms = TransformSystem::Get();
+    BoundingBox result;
+    for (SceneNode* node : m_denseNodes) {
+        if (!node->GetMesh() || !node->IsInLayer(layerMask)) continue;
+        BoundingBox bounds = transforms.GetWorldBounds(node->GetTransformId());
+        if (!bounds.IsValid()) continue;
+        if (result.IsValid()) {
+            result = BoundingBox::FromMinMax(glm::min(result.GetMin(), bounds.GetMin()),
+                                             glm::max(result.GetMax(), bounds.GetMax()));
+        } else {
+            result = bounds;
+        }
+    }
+    return result;
+}
+
 void ObjectManager::Clear() {
-    m_scene.GetRoot()->GetChildren().clear();
-    m_nodes.clear();
+    m_scene.GetRoot()->RemoveAllChildren();
+
+    // 所有槽位代数加一，之前发出的句柄全部失效
+    for (uint32_t index : m_denseToSlot) {
+        NodeSlot& slot = m_slots[index];
+        slot.node->SetHandle(NodeHandle());
+        slot.node.reset();
+        slot.generation = (slot.generation + 1) & NodeHandle::GenerationMask;
+        if (slot.generation == 0) slot.generation = 1;
+        m_freeSlots.push_back(index);
+    }
+    m_denseNodes.clear();
+    m_denseToSlot.clear();
+    m_nameIndex.clear();
+    m_bvh.Clear();
+    m_bvhDirty = true;
+    ++m_structureVersion;
 }
 
 void ObjectManager::Update() {
     m_scene.Update();
 }
 
-void ObjectManager::Render(Shader* shader) {
-    m_scene.Render(shader);
+void ObjectManager::Render(Shader* shader, const glm::mat4& view, const ViewFrustum* frustum) {
+    m_scene.Render(shader, view, frustum);
 }
 
-} // namespace SoulsEngine
+bool ObjectManager::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                            uint32_t layerMask, RayHit& hit) {
+    SyncBVH();
+    return m_bvh.Raycast(origin, direction, maxDistance, layerMask, hit);
+}
+
+bool ObjectManager::RaycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                               uint32_t layerMask) {
+    SyncBVH();
+    return m_bvh.RaycastAny(origin, direction, maxDistance, layerMask);
+}
+
+const SceneBVH& ObjectManager::GetBVH() {
+    SyncBVH();
+    return m_bvh;
+}
 
+void ObjectManager::SyncBVH() {
+    TransformSystem& transforms = TransformSystem::Get();
+    const uint64_t version = transforms.GetVersion();
+    if (m_bvhDirty) {
+        m_bvh.Build(m_denseNodes);
+    } else if (version != m_bvhTransformVersion && !m_bvh.Refit()) {
+        // 节点移动太多，拟合后的树质量太差，重新构建
+        m_bvh.Build(m_denseNodes);
+    }
+    m_bvhDirty = false;
+    m_bvhTransformVersion = version;
+}
+
+} // namespace SoulsEngine
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "Scene.h"
+#include "JobSystem.h"
+#include "OcclusionCuller.h"
+#include "SceneBVH.h"
 #include "SceneNode.h"
+#include "NodeHandle.h"
+#include "../geometry/MeshLOD.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace SoulsEngine {
 
@@ -28,31 +34,175 @@ public:
     // 创建场景节点（带Mesh）
     std::shared_ptr<SceneNode> CreateNode(const std::string& name, std::shared_ptr<Mesh> mesh);
 
-    // 添加节点到场景
-    void AddNode(std::shared_ptr<SceneNode> node);
+    // 添加节点到场景，返回其句柄
+    NodeHandle AddNode(std::shared_ptr<SceneNode> node);
 
     // 移除节点
     void RemoveNode(const std::string& name);
     void RemoveNode(std::shared_ptr<SceneNode> node);
+    void RemoveNode(NodeHandle handle);
 
-    // 查找节点
+    // 句柄访问（O(1)，不增加引用计数；句柄失效时返回nullptr）
+    SceneNode* GetNode(NodeHandle handle) const;
+    std::shared_ptr<SceneNode> GetSharedNode(NodeHandle handle) const;
+    bool IsValid(NodeHandle handle) const;
+
+    // 按名称查找（名称索引是可选的二级索引，重名时指向最后注册的节点）
+    NodeHandle FindHandle(const std::string& name) const;
     std::shared_ptr<SceneNode> FindNode(const std::string& name) const;
 
-    // 获取所有节点
+    // 节点改名后更新名称索引（由SceneNode::SetName调用，改名后的节点在重名时优先）
+    void OnNodeRenamed(const std::string& oldName, SceneNode& node);
+
+    // 启用/禁用名称索引（禁用后按名称查找会退化为场景遍历）
+    void SetNameIndexEnabled(bool enabled);
+    bool IsNameIndexEnabled() const { return m_nameIndexEnabled; }
+
+    // 节点数量
+    size_t GetNodeCount() const { return m_denseNodes.size(); }
+
+    // 节点集合的版本号：添加、移除或清空节点时递增，缓存节点列表的系统（如GpuCuller）据此判断是否需要重建
+    uint64_t GetStructureVersion() const { return m_structureVersion; }
+
+    // 获取所有节点（会复制整个列表并增加引用计数，每帧遍历请使用下面的迭代接口）
     std::vector<std::shared_ptr<SceneNode>> GetAllNodes() const;
 
+    // 无分配遍历：直接访问已注册节点的紧凑数组，不复制也不触碰引用计数
+    // 遍历期间不能添加或移除节点
+    struct NodeRange {
+        SceneNode* const* first;
+        SceneNode* const* last;
+        SceneNode* const* begin() const { return first; }
+        SceneNode* const* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+    NodeRange GetNodes() const {
+        return { m_denseNodes.data(), m_denseNodes.data() + m_denseNodes.size() };
+    }
+
+    // 访问者形式的遍历：func(SceneNode&)
+    template <typename Func>
+    void ForEachNode(Func&& func) const {
+        for (SceneNode* node : m_denseNodes) {
+            func(*node);
+        }
+    }
+
+    // 只遍历属于layerMask中任一层的节点
+    template <typename Func>
+    void ForEachNodeInLayer(uint32_t layerMask, Func&& func) const {
+        for (SceneNode* node : m_denseNodes) {
+            if (node->IsInLayer(layerMask)) {
+                func(*node);
+            }
+        }
+    }
+
+    // 只遍历带Mesh的可渲染节点
+    template <typename Func>
+    void ForEachRenderable(Func&& func, uint32_t layerMask = NodeLayer::All) const {
+        for (SceneNode* node : m_denseNodes) {
+            if (node->GetMesh() && node->IsInLayer(layerMask)) {
+                func(*node);
+            }
+        }
+    }
+
+    // 只遍历世界包围盒与视锥体相交的可渲染节点，返回测试/可见数量
+    // 所有变换的世界包围盒先由SIMD批量测试一次，遍历时按节点查表
+    // 传入occlusion时（本帧已调用BeginFrame），视锥体内的包围盒再并行做一次遮挡测试
+    template <typename Func>
+    CullingStats ForEachVisibleRenderable(const ViewFrustum& frustum, Func&& func, uint32_t layerMask = NodeLayer::All,
+                                          OcclusionCuller* occlusion = nullptr) {
+        TransformSystem& transforms = TransformSystem::Get();
+        transforms.UpdateWorldTransforms(&JobSystem::Get());
+        transforms.CullWorldBounds(frustum, m_visibility);
+        if (occlusion) {
+            occlusion->Wait();
+            transforms.CullOccludedBounds(*occlusion, m_visibility, &JobSystem::Get());
+        }
+
+        CullingStats stats;
+        for (SceneNode* node : m_denseNodes) {
+            if (node->GetMesh() && node->IsInLayer(layerMask)) {
+                stats.tested++;
+                if (transforms.IsVisible(m_visibility, node->GetTransformId())) {
+                    stats.visible++;
+                    func(*node);
+                } else if (transforms.IsOccluded(m_visibility, node->GetTransformId())) {
+                    stats.occluded++;
+                }
+            }
+        }
+        return stats;
+    }
+
+    // 为所有使用细节层次组的节点重新选择层次（在渲染前、世界变换更新后调用）
+    LODStats UpdateLODs(const LODContext& context);
+
+    // layerMask中所有可渲染节点的世界包围盒的并集（没有节点时返回无效包围盒）
+    BoundingBox ComputeWorldBounds(uint32_t layerMask = NodeLayer::All);
+
     // 清空所有节点
     void Clear();
 
     // 更新场景
     void Update();
 
-    // 渲染场景
-    void Render(class Shader* shader);
+    // 渲染场景（经渲染队列排序提交，view用于按深度排序，frustum非空时做视锥体剔除）
+    void Render(class Shader* shader, const glm::mat4& view = glm::mat4(1.0f), const ViewFrustum* frustum = nullptr);
+
+    // 射线查询（direction应为单位向量），只命中layerMask中任一层的节点
+    // 基于SceneBVH：节点增删后在下一次查询时重建，变换变化后重新拟合
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 uint32_t layerMask, RayHit& hit);
+    bool RaycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                    uint32_t layerMask);
+
+    // 与当前节点和变换同步后的层次包围盒
+    const SceneBVH& GetBVH();
+
+    // 上一次Render的统计信息（绘制调用、状态切换、uniform写入）
+    const RenderStats& GetRenderStats() const { return m_scene.GetRenderStats(); }
+
+    // 上一次Render的剔除统计
+    const CullingStats& GetCullingStats() const { return m_scene.GetCullingStats(); }
 
 private:
+    // 槽位表：持有节点的所有权，代数用于检测过期句柄
+    struct NodeSlot {
+        std::shared_ptr<SceneNode> node;
+        uint32_t generation = 1;
+        uint32_t denseIndex = 0;
+    };
+
+    void RemoveFromNameIndex(const std::string& name, NodeHandle handle);
+
+    // 按需重建或重新拟合m_bvh
+    void SyncBVH();
+
     Scene m_scene;
-    std::unordered_map<std::string, std::shared_ptr<SceneNode>> m_nodes;
+
+    std::vector<NodeSlot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+
+    // 紧凑数组：所有存活节点连续存放，移除时与末尾交换
+    std::vector<SceneNode*> m_denseNodes;
+    std::vector<uint32_t> m_denseToSlot;
+
+    // ForEachVisibleRenderable使用的可见性表（按变换槽位）
+    std::vector<uint8_t> m_visibility;
+
+    // 射线查询用的层次包围盒
+    SceneBVH m_bvh;
+    bool m_bvhDirty = true;
+    uint64_t m_structureVersion = 0;
+    uint64_t m_bvhTransformVersion = 0;
+
+    // 名称 -> 句柄（可选的二级索引）
+    std::unordered_map<std::string, NodeHandle> m_nameIndex;
+    bool m_nameIndexEnabled;
 };
 
 } // namespace SoulsEngine
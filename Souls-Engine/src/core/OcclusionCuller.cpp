@@ -0,0 +1,290 @@
+#include "OcclusionCuller.h"
+#include "ObjectManager.h"
+#include "TransformMath.h"
+#include "../geometry/Mesh.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef SOULS_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace SoulsEngine {
+
+namespace {
+    // 每个光栅化任务处理的行数
+    constexpr uint32_t RowsPerBand = 16;
+
+    // 包围盒的8个角：第k位为1表示第k个轴取最大值
+    // 6个面，从外侧看为逆时针
+    constexpr int BoxFaces[6][4] = {
+        { 0, 4, 6, 2 },  // -X
+        { 1, 3, 7, 5 },  // +X
+        { 0, 1, 5, 4 },  // -Y
+        { 2, 6, 7, 3 },  // +Y
+        { 0, 2, 3, 1 },  // -Z
+        { 4, 5, 7, 6 },  // +Z
+    };
+}
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+    : m_width((std::max(width, 4u) + 3u) & ~3u)
+    , m_height(std::max(height, 1u)) {
+    // 预先分配Hi-Z各级
+    uint32_t levelWidth = m_width;
+    uint32_t levelHeight = m_height;
+    while (true) {
+        m_levelSizes.emplace_back(levelWidth, levelHeight);
+        m_levels.emplace_back(static_cast<size_t>(levelWidth) * levelHeight, 1.0f);
+        if (levelWidth == 1 && levelHeight == 1) break;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    Wait();
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection, const ObjectManager& objects) {
+    // 上一帧的任务可能还在使用三角形列表
+    Wait();
+
+    m_viewProjection = viewProjection;
+    m_triangles.clear();
+    m_occluderCount = 0;
+
+    // 主线程只做顶点变换和裁剪（遮挡体通常只有几十个），之后的工作不再访问场景数据
+    objects.ForEachNode([this](SceneNode& node) {
+        if (!node.IsOccluder() || !node.GetMesh()) return;
+        const BoundingBox& bounds = node.GetMesh()->GetLocalBounds();
+        if (!bounds.IsValid()) return;
+        AddBox(bounds, node.GetWorldTransform());
+        m_occluderCount++;
+    });
+
+    JobSystem::Get().Submit([this]() {
+        std::fill(m_levels[0].begin(), m_levels[0].end(), 1.0f);
+        const uint32_t bandCount = (m_height + RowsPerBand - 1) / RowsPerBand;
+        JobSystem::Get().ParallelFor(bandCount, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t band = begin; band < end; ++band) {
+                RasterizeRows(band * RowsPerBand, std::min((band + 1) * RowsPerBand, m_height));
+            }
+        });
+        BuildHierarchy();
+    }, m_counter);
+}
+
+void OcclusionCuller::Wait() {
+    JobSystem::Get().Wait(m_counter);
+}
+
+void OcclusionCuller::AddBox(const BoundingBox& localBounds, const glm::mat4& model) {
+    const glm::mat4 modelViewProjection = m_viewProjection * model;
+
+    glm::vec4 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 sign((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+        corners[i] = modelViewProjection * glm::vec4(localBounds.center + localBounds.extents * sign, 1.0f);
+    }
+
+    // 镜像变换会翻转绕序
+    const bool mirrored = glm::determinant(glm::mat3(model)) < 0.0f;
+
+    for (const auto& face : BoxFaces) {
+        // 裁剪到近平面内侧（z + w >= 0），一个四边形最多变成五边形
+        glm::vec4 polygon[5];
+        int count = 0;
+        for (int i = 0; i < 4; ++i) {
+            const glm::vec4& a = corners[face[i]];
+            const glm::vec4& b = corners[face[(i + 1) % 4]];
+            const float da = a.z + a.w;
+            const float db = b.z + b.w;
+            if (da >= 0.0f) {
+                polygon[count++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                polygon[count++] = a + (b - a) * (da / (da - db));
+            }
+        }
+        if (count < 3) continue;
+
+        // 透视除法并映射到像素坐标
+        glm::vec3 screen[5];
+        for (int i = 0; i < count; ++i) {
+            const float invW = 1.0f / polygon[i].w;
+            screen[i].x = (polygon[i].x * invW * 0.5f + 0.5f) * static_cast<float>(m_width);
+            screen[i].y = (polygon[i].y * invW * 0.5f + 0.5f) * static_cast<float>(m_height);
+            screen[i].z = polygon[i].z * invW * 0.5f + 0.5f;
+        }
+
+        // 剔除背面（逆时针为正面）
+        float area = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            const glm::vec3& p = screen[i];
+            const glm::vec3& q = screen[(i + 1) % count];
+            area += p.x * q.y - q.x * p.y;
+        }
+        if (mirrored) area = -area;
+        if (area <= 0.0f) continue;
+
+        // 扇形三角化，统一输出为逆时针
+        for (int i = 1; i + 1 < count; ++i) {
+            const int second = mirrored ? i + 1 : i;
+            const int third = mirrored ? i : i + 1;
+            ScreenTriangle triangle;
+            triangle.x[0] = screen[0].x; triangle.y[0] = screen[0].y; triangle.z[0] = screen[0].z;
+            triangle.x[1] = screen[second].x; triangle.y[1] = screen[second].y; triangle.z[1] = screen[second].z;
+            triangle.x[2] = screen[third].x; triangle.y[2] = screen[third].y; triangle.z[2] = screen[third].z;
+            m_triangles.push_back(triangle);
+        }
+    }
+}
+
+void OcclusionCuller::RasterizeRows(uint32_t rowBegin, uint32_t rowEnd) {
+    float* depth = m_levels[0].data();
+    const float maxX = static_cast<float>(m_width - 1);
+
+    for (const ScreenTriangle& triangle : m_triangles) {
+        const float* x = triangle.x;
+        const float* y = triangle.y;
+        const float* z = triangle.z;
+
+        // 包围矩形
+        const float minYf = std::min({ y[0], y[1], y[2] });
+        const float maxYf = std::max({ y[0], y[1], y[2] });
+        const int rowMin = std::max(static_cast<int>(rowBegin), static_cast<int>(std::floor(minYf)));
+        const int rowMax = std::min(static_cast<int>(rowEnd) - 1, static_cast<int>(std::floor(maxYf)));
+        if (rowMin > rowMax) continue;
+        const float minXf = std::max(0.0f, std::min({ x[0], x[1], x[2] }));
+        const float maxXf = std::min(maxX, std::max({ x[0], x[1], x[2] }));
+        if (minXf > maxXf) continue;
+        const int colMin = static_cast<int>(std::floor(minXf)) & ~3;
+        const int colMax = static_cast<int>(std::floor(maxXf));
+
+        // 边函数 E(px, py) = A * px + B * py + C，逆时针三角形内部三条边都非负
+        // 为了保守，只写入完全被三角形覆盖的像素：C减去半个像素在边法线方向上的投影，
+        // 在像素中心求值就等价于在像素最不利的角上求值
+        float edgeA[3], edgeB[3], edgeC[3];
+        for (int i = 0; i < 3; ++i) {
+            const int j = (i + 1) % 3;
+            edgeA[i] = y[i] - y[j];
+            edgeB[i] = x[j] - x[i];
+            edgeC[i] = -(edgeA[i] * x[i] + edgeB[i] * y[i]) - 0.5f * (std::abs(edgeA[i]) + std::abs(edgeB[i]));
+        }
+
+        // 深度平面 z(px, py) = zA * px + zB * py + zC（NDC深度在屏幕空间是线性的）
+        // 同理取像素范围内最远的深度
+        const float area2 = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (area2 <= 0.0f) continue;
+        const float zA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area2;
+        const float zB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area2;
+        const float zC = z[0] - zA * x[0] - zB * y[0] + 0.5f * (std::abs(zA) + std::abs(zB));
+
+        for (int row = rowMin; row <= rowMax; ++row) {
+            const float py = static_cast<float>(row) + 0.5f;
+            float* rowDepth = depth + static_cast<size_t>(row) * m_width;
+            const float rowE0 = edgeB[0] * py + edgeC[0];
+            const float rowE1 = edgeB[1] * py + edgeC[1];
+            const float rowE2 = edgeB[2] * py + edgeC[2];
+            const float rowZ = zB * py + zC;
+
+#ifdef SOULS_SIMD_SSE
+            // 每次4个像素：计算三条边函数和深度，只在三角形内部取较小深度
+            const __m128 a0 = _mm_set1_ps(edgeA[0]), a1 = _mm_set1_ps(edgeA[1]), a2 = _mm_set1_ps(edgeA[2]);
+            const __m128 r0 = _mm_set1_ps(rowE0), r1 = _mm_set1_ps(rowE1), r2 = _mm_set1_ps(rowE2);
+            const __m128 za = _mm_set1_ps(zA), zr = _mm_set1_ps(rowZ);
+            const __m128 zero = _mm_setzero_ps();
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(colMin)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+            const __m128 step = _mm_set1_ps(4.0f);
+            for (int col = colMin; col <= colMax; col += 4) {
+                __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), r0);
+                __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), r1);
+                __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), r2);
+                __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+                if (_mm_movemask_ps(inside) != 0) {
+                    __m128 pixelDepth = _mm_add_ps(_mm_mul_ps(za, px), zr);
+                    __m128 current = _mm_loadu_ps(rowDepth + col);
+                    __m128 nearer = _mm_min_ps(current, pixelDepth);
+                    _mm_storeu_ps(rowDepth + col, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+                }
+                px = _mm_add_ps(px, step);
+            }
+#else
+            for (int col = colMin; col <= colMax; ++col) {
+                const float px = static_cast<float>(col) + 0.5f;
+                if (edgeA[0] * px + rowE0 >= 0.0f && edgeA[1] * px + rowE1 >= 0.0f && edgeA[2] * px + rowE2 >= 0.0f) {
+                    rowDepth[col] = std::min(rowDepth[col], zA * px + rowZ);
+                }
+            }
+#endif
+        }
+    }
+}
+
+void OcclusionCuller::BuildHierarchy() {
+    for (size_t level = 1; level < m_levels.size(); ++level) {
+        const std::vector<float>& source = m_levels[level - 1];
+        const glm::uvec2 sourceSize = m_levelSizes[level - 1];
+        const glm::uvec2 size = m_levelSizes[level];
+        std::vector<float>& target = m_levels[level];
+
+        for (uint32_t y = 0; y < size.y; ++y) {
+            const uint32_t y0 = y * 2;
+            const uint32_t y1 = std::min(y0 + 1, sourceSize.y - 1);
+            for (uint32_t x = 0; x < size.x; ++x) {
+                const uint32_t x0 = x * 2;
+                const uint32_t x1 = std::min(x0 + 1, sourceSize.x - 1);
+                target[y * size.x + x] = std::max(
+                    std::max(source[y0 * sourceSize.x + x0], source[y0 * sourceSize.x + x1]),
+                    std::max(source[y1 * sourceSize.x + x0], source[y1 * sourceSize.x + x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::IsVisible(const BoundingBox& worldBounds) const {
+    if (!worldBounds.IsValid()) return false;
+
+    // 投影8个角，取屏幕空间包围矩形和最近深度
+    glm::vec2 ndcMin(FLT_MAX);
+    glm::vec2 ndcMax(-FLT_MAX);
+    float nearestDepth = FLT_MAX;
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 sign((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+        glm::vec4 clip = m_viewProjection * glm::vec4(worldBounds.center + worldBounds.extents * sign, 1.0f);
+        // 跨越近平面时无法得到可靠的屏幕矩形，保守地视为可见
+        if (clip.z < -clip.w || clip.w <= 0.0f) return true;
+        const float invW = 1.0f / clip.w;
+        ndcMin = glm::min(ndcMin, glm::vec2(clip) * invW);
+        ndcMax = glm::max(ndcMax, glm::vec2(clip) * invW);
+        nearestDepth = std::min(nearestDepth, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    auto toPixel = [](float ndc, uint32_t size) {
+        float pixel = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(size));
+        return static_cast<int>(std::min(std::max(pixel, 0.0f), static_cast<float>(size - 1)));
+    };
+    const int x0 = toPixel(ndcMin.x, m_width), x1 = toPixel(ndcMax.x, m_width);
+    const int y0 = toPixel(ndcMin.y, m_height), y1 = toPixel(ndcMax.y, m_height);
+
+    // 选择矩形最多覆盖2x2个像素的层级
+    size_t level = 0;
+    while (level + 1 < m_levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        ++level;
+    }
+
+    const std::vector<float>& depth = m_levels[level];
+    const uint32_t levelWidth = m_levelSizes[level].x;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            // 该区域内最远的遮挡深度比物体最近点还远，说明物体可能露出来
+            if (nearestDepth <= depth[static_cast<size_t>(y) * levelWidth + x]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "../geometry/Bounds.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class ObjectManager;
+
+// 软件遮挡剔除 - 在CPU上把遮挡体（SceneNode::SetOccluder标记的墙、地面等盒状物体）光栅化到
+// 低分辨率深度缓冲，再逐级取最大值生成层次深度（Hi-Z）金字塔，渲染前用它测试物体的屏幕空间包围矩形
+// 只写入被完全覆盖的像素并取像素范围内最远的深度，因此低分辨率不会把实际可见的物体剔除
+//
+// 遮挡体按网格的局部包围盒（12个三角形）光栅化，因此只应标记本身就是盒子的物体，
+// 否则包围盒会遮住实际上能看见的东西。深度缓冲存放NDC深度映射到[0,1]后的值（越小越近）
+//
+// 一帧的流程：
+//   BeginFrame  主线程拷贝遮挡体的三角形，光栅化和Hi-Z构建作为任务提交到JobSystem后立即返回
+//   ...         主线程继续做场景更新、uniform上传等工作
+//   Wait        等待光栅化完成（ObjectManager::ForEachVisibleRenderable会自动调用）
+//   IsVisible   测试世界包围盒（可以在多个线程上同时调用）
+class OcclusionCuller {
+public:
+    // 深度缓冲尺寸（宽度向上取整到4的倍数，SIMD每次处理一行中相邻的4个像素）
+    explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    // 开始新的一帧：收集objects中的遮挡体并在工作线程上异步光栅化
+    void BeginFrame(const glm::mat4& viewProjection, const ObjectManager& objects);
+
+    // 等待本帧的光栅化和Hi-Z构建完成
+    void Wait();
+
+    // 世界包围盒是否可能可见（跨越近平面或屏幕外的包围盒总是可见），需先Wait
+    bool IsVisible(const BoundingBox& worldBounds) const;
+
+    // 统计
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+    size_t GetOccluderCount() const { return m_occluderCount; }
+    size_t GetTriangleCount() const { return m_triangles.size(); }
+
+    // 深度缓冲（Hi-Z第0级），用于调试显示
+    const std::vector<float>& GetDepthBuffer() const { return m_levels[0]; }
+
+private:
+    // 屏幕空间三角形（像素坐标，y向上；z为[0,1]深度），已剔除背面并按逆时针排列
+    struct ScreenTriangle {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    // 把一个包围盒的可见面裁剪到近平面之后转换为屏幕空间三角形
+    void AddBox(const BoundingBox& localBounds, const glm::mat4& model);
+
+    // 光栅化落在[rowBegin, rowEnd)行内的所有三角形
+    void RasterizeRows(uint32_t rowBegin, uint32_t rowEnd);
+
+    // 由第0级逐级生成Hi-Z
+    void BuildHierarchy();
+
+    uint32_t m_width;
+    uint32_t m_height;
+    glm::mat4 m_viewProjection = glm::mat4(1.0f);
+
+    std::vector<ScreenTriangle> m_triangles;
+    size_t m_occluderCount = 0;
+
+    // Hi-Z金字塔：每一级的每个像素是上一级对应2x2像素中的最大（最远）深度
+    std::vector<std::vector<float>> m_levels;
+    std::vector<glm::uvec2> m_levelSizes;
+
+    JobCounter m_counter;
+};
+
+} // namespace SoulsEngine
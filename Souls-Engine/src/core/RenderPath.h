@@ -0,0 +1,20 @@
+#pragma once
+
+namespace SoulsEngine {
+
+// 主通道的渲染路径
+enum class RenderPath {
+    Forward,    // basic.frag：每个片段直接计算光照
+    Deferred    // gbuffer.frag写入G-buffer，deferred_light.frag每个像素计算一次光照（见 DeferredRenderer）
+};
+
+// 两条渲染路径的GPU耗时（毫秒，见 GpuTimer），valid为false表示还没有结果
+struct RenderTimings {
+    float forwardMs = 0.0f;              // 前向渲染的主通道
+    float deferredGeometryMs = 0.0f;     // 延迟渲染的几何通道
+    float deferredLightingMs = 0.0f;     // 延迟渲染的光照通道
+    bool forwardValid = false;
+    bool deferredValid = false;
+};
+
+} // namespace SoulsEngine
@@ -0,0 +1,400 @@
+#include "RenderQueue.h"
+#include "SceneNode.h"
+#include "Shader.h"
+#include "Material.h"
+#include "../geometry/Mesh.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace SoulsEngine {
+
+namespace {
+    // 少量绘制项时基数排序的直方图开销不划算
+    constexpr size_t RadixSortThreshold = 64;
+
+    const Material& GetDefaultMaterial() {
+        static Material defaultMat = Material::CreateDefault();
+        return defaultMat;
+    }
+
+    // 一个着色器中渲染队列用到的uniform位置（通过类型检查的句柄解析，着色器中不存在的为-1）
+    struct ShaderUniforms {
+        GLint model = -1;
+        GLint ambient = -1;
+        GLint diffuse = -1;
+        GLint specular = -1;
+        GLint shininess = -1;
+        GLint alpha = -1;
+        GLint useInstancing = -1;
+
+        explicit ShaderUniforms(const Shader& shader)
+            : model(shader.GetUniformHandle<glm::mat4>("model").location)
+            , ambient(shader.GetUniformHandle<glm::vec3>("material.ambient").location)
+            , diffuse(shader.GetUniformHandle<glm::vec3>("material.diffuse").location)
+            , specular(shader.GetUniformHandle<glm::vec3>("material.specular").location)
+            , shininess(shader.GetUniformHandle<float>("material.shininess").location)
+            , alpha(shader.GetUniformHandle<float>("material.alpha").location)
+            , useInstancing(shader.GetUniformHandle<bool>("useInstancing").location)
+        {
+        }
+    };
+}
+
+RenderQueue::~RenderQueue() {
+    if (m_instanceBuffer != 0) {
+        glDeleteBuffers(1, &m_instanceBuffer);
+        m_instanceBuffer = 0;
+    }
+    if (m_indirectBuffer != 0) {
+        glDeleteBuffers(1, &m_indirectBuffer);
+        m_indirectBuffer = 0;
+    }
+}
+
+bool RenderQueue::IsMultiDrawSupported() {
+    // glMultiDrawElementsIndirect（带baseInstance）是GL 4.3核心功能
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    return major > 4 || (major == 4 && minor >= 3);
+}
+
+void RenderQueue::Begin(const glm::mat4& view, float depthRange) {
+    m_items.clear();
+    m_entries.clear();
+    m_view = view;
+    m_inverseDepthRange = depthRange > 0.0f ? 1.0f / depthRange : 0.0f;
+    m_sorted = false;
+}
+
+void RenderQueue::Submit(const Mesh* mesh, const Material* material, const glm::mat4& model, const Shader* shader) {
+    if (!mesh || mesh->GetVAO() == 0 || mesh->GetVertexCount() == 0) return;
+
+    DrawItem item;
+    item.mesh = mesh;
+    item.material = material;
+    item.shader = shader;
+    item.model = model;
+
+    m_entries.push_back({ MakeKey(item), static_cast<uint32_t>(m_items.size()) });
+    m_items.push_back(item);
+    m_sorted = false;
+}
+
+void RenderQueue::Submit(const SceneNode& node, const Shader* shader) {
+    const auto& mesh = node.GetMesh();
+    if (!mesh) return;
+    Submit(mesh.get(), node.GetMaterial().get(), node.GetWorldTransform(), shader);
+}
+
+uint64_t RenderQueue::MakeKey(const DrawItem& item) const {
+    const Material& material = item.material ? *item.material : GetDefaultMaterial();
+
+    uint64_t program = item.shader ? (item.shader->GetProgramID() & 0xFFu) : 0u;
+    uint64_t materialId = material.GetSortId() & 0xFFFFFu;
+    uint64_t meshId = item.mesh->GetSortId() & 0x7FFFFu;
+
+    // 物体原点在观察空间中的深度，量化到16位
+    const glm::mat4& model = item.model;
+    float viewZ = m_view[0][2] * model[3][0] + m_view[1][2] * model[3][1] + m_view[2][2] * model[3][2] + m_view[3][2];
+    float normalized = std::clamp(-viewZ * m_inverseDepthRange, 0.0f, 1.0f);
+    uint64_t depth = static_cast<uint64_t>(normalized * 65535.0f);
+
+    if (material.GetAlpha() < 1.0f) {
+        uint64_t farToNear = 0xFFFFu - depth;
+        return (1ull << 63) | (farToNear << 47) | (program << 39) | (meshId << 20) | materialId;
+    }
+    return (program << 55) | (meshId << 36) | (materialId << 16) | depth;
+}
+
+void RenderQueue::Sort() {
+    if (m_sorted) return;
+    m_sorted = true;
+
+    const size_t count = m_entries.size();
+    if (count < RadixSortThreshold) {
+        std::sort(m_entries.begin(), m_entries.end(),
+                  [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+        return;
+    }
+
+    // LSD基数排序：每趟8位，一次遍历统计全部8趟的直方图
+    uint32_t histograms[8][256];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (const SortEntry& entry : m_entries) {
+        uint64_t key = entry.key;
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    m_sortScratch.resize(count);
+    SortEntry* source = m_entries.data();
+    SortEntry* destination = m_sortScratch.data();
+
+    for (int pass = 0; pass < 8; ++pass) {
+        uint32_t* histogram = histograms[pass];
+        const int shift = pass * 8;
+
+        // 所有键在这一字节上相同时这一趟不改变顺序，直接跳过
+        if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const SortEntry& entry = source[i];
+            destination[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != m_entries.data()) {
+        std::memcpy(m_entries.data(), source, count * sizeof(SortEntry));
+    }
+}
+
+uint32_t RenderQueue::AppendInstances(uint32_t firstEntry, uint32_t endEntry) {
+    const uint32_t firstInstance = static_cast<uint32_t>(m_instanceData.size());
+    for (uint32_t i = firstEntry; i < endEntry; ++i) {
+        const DrawItem& item = m_items[m_entries[i].index];
+        const Material& material = item.material ? *item.material : GetDefaultMaterial();
+        InstanceData instance;
+        instance.model = item.model;
+        instance.ambient = material.GetAmbient();
+        instance.diffuse = material.GetDiffuse();
+        instance.specular = glm::vec4(material.GetSpecular(), material.GetShininess());
+        m_instanceData.push_back(instance);
+    }
+    return firstInstance;
+}
+
+void RenderQueue::BuildBatches(const Shader& defaultShader, bool multiDraw) {
+    m_batches.clear();
+    m_instanceData.clear();
+    m_commands.clear();
+
+    const uint32_t entryCount = static_cast<uint32_t>(m_entries.size());
+    uint32_t runStart = 0;
+    while (runStart < entryCount) {
+        // 找出使用同一着色器和同一网格的连续绘制项
+        const DrawItem& first = m_items[m_entries[runStart].index];
+        const Shader* shader = first.shader ? first.shader : &defaultShader;
+        uint32_t runEnd = runStart + 1;
+        while (runEnd < entryCount) {
+            const DrawItem& item = m_items[m_entries[runEnd].index];
+            const Shader* itemShader = item.shader ? item.shader : &defaultShader;
+            if (item.mesh != first.mesh || itemShader != shader) break;
+            ++runEnd;
+        }
+
+        const uint32_t runLength = runEnd - runStart;
+        const Mesh* mesh = first.mesh;
+        if (multiDraw && mesh->IsIndexed() && mesh->GetInstancedVAO() != 0) {
+            // 整段作为一条间接命令（单个绘制项也是instanceCount为1的实例）
+            const GeometryAllocation& geometry = mesh->GetGeometry();
+            const uint32_t indexSize = mesh->GetIndexType() == GL_UNSIGNED_SHORT ? 2u : 4u;
+            DrawElementsIndirectCommand command;
+            command.count = static_cast<GLuint>(mesh->GetIndexCount());
+            command.instanceCount = runLength;
+            command.firstIndex = geometry.indexOffset / indexSize;
+            command.baseVertex = static_cast<GLint>(geometry.vertexOffset);
+            command.baseInstance = AppendInstances(runStart, runEnd);
+
+            // 与前一个多重绘制批次的着色器、VAO和索引类型都相同时追加到该批次（保持排序顺序）
+            bool merged = false;
+            if (!m_batches.empty() && m_batches.back().commandCount > 0) {
+                Batch& previous = m_batches.back();
+                const DrawItem& previousItem = m_items[m_entries[previous.firstEntry].index];
+                const Shader* previousShader = previousItem.shader ? previousItem.shader : &defaultShader;
+                if (previousShader == shader &&
+                    previousItem.mesh->GetInstancedVAO() == mesh->GetInstancedVAO() &&
+                    previousItem.mesh->GetIndexType() == mesh->GetIndexType()) {
+                    ++previous.commandCount;
+                    merged = true;
+                }
+            }
+            if (!merged) {
+                m_batches.push_back({ runStart, 0, 0, static_cast<uint32_t>(m_commands.size()), 1 });
+            }
+            m_commands.push_back(command);
+        } else if (m_instancingEnabled && runLength >= m_minInstanceCount && mesh->GetInstancedVAO() != 0) {
+            const uint32_t firstInstance = AppendInstances(runStart, runEnd);
+            m_batches.push_back({ runStart, runLength, firstInstance });
+        } else {
+            for (uint32_t i = runStart; i < runEnd; ++i) {
+                m_batches.push_back({ i, 0, 0 });
+            }
+        }
+        runStart = runEnd;
+    }
+}
+
+void RenderQueue::UploadInstanceData() {
+    if (m_instanceData.empty()) return;
+
+    if (m_instanceBuffer == 0) {
+        glGenBuffers(1, &m_instanceBuffer);
+    }
+
+    // 每帧整体重新分配（孤立旧存储），避免等待GPU仍在读取的上一帧数据
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(m_instanceData.size() * sizeof(InstanceData)),
+                 m_instanceData.data(),
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderQueue::UploadCommands() {
+    if (m_commands.empty()) return;
+
+    if (m_indirectBuffer == 0) {
+        glGenBuffers(1, &m_indirectBuffer);
+    }
+
+    // 与实例缓冲相同，每帧孤立旧存储；间接缓冲绑定不属于VAO，提交期间保持绑定
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                 static_cast<GLsizeiptr>(m_commands.size() * sizeof(DrawElementsIndirectCommand)),
+                 m_commands.data(),
+                 GL_STREAM_DRAW);
+}
+
+void RenderQueue::BindInstanceAttributes(GLuint buffer, uint32_t firstInstance) {
+    // GL 3.3没有baseInstance，通过属性指针的偏移选择批次在实例缓冲中的起点
+    // （多重间接绘制传入0，由每条命令的baseInstance选择）
+    const GLsizei stride = static_cast<GLsizei>(sizeof(InstanceData));
+    const size_t base = static_cast<size_t>(firstInstance) * sizeof(InstanceData);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint location = InstanceAttributeLocation + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+
+    const GLuint ambientLocation = InstanceAttributeLocation + 4;
+    glEnableVertexAttribArray(ambientLocation);
+    glVertexAttribPointer(ambientLocation, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(InstanceData, ambient)));
+    glVertexAttribDivisor(ambientLocation, 1);
+
+    const GLuint diffuseLocation = InstanceAttributeLocation + 5;
+    glEnableVertexAttribArray(diffuseLocation);
+    glVertexAttribPointer(diffuseLocation, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(InstanceData, diffuse)));
+    glVertexAttribDivisor(diffuseLocation, 1);
+
+    const GLuint specularLocation = InstanceAttributeLocation + 6;
+    glEnableVertexAttribArray(specularLocation);
+    glVertexAttribPointer(specularLocation, 4, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(InstanceData, specular)));
+    glVertexAttribDivisor(specularLocation, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderQueue::Execute(const Shader& defaultShader) {
+    Sort();
+
+    m_stateCache.Invalidate();
+    m_stateCache.ResetStats();
+    RenderStats& stats = m_stateCache.GetStats();
+    stats.drawItems = static_cast<uint32_t>(m_items.size());
+    if (m_items.empty()) return;
+
+    if (m_multiDrawSupported < 0) {
+        m_multiDrawSupported = IsMultiDrawSupported() ? 1 : 0;
+    }
+    BuildBatches(defaultShader, m_multiDrawEnabled && m_multiDrawSupported == 1);
+    UploadInstanceData();
+    UploadCommands();
+
+    const Shader* currentShader = nullptr;
+    const Material* currentMaterial = nullptr;
+    const Shader* uniformsOwner = &defaultShader;
+    ShaderUniforms uniforms(defaultShader);
+
+    for (const Batch& batch : m_batches) {
+        const DrawItem& item = m_items[m_entries[batch.firstEntry].index];
+        const Shader* shader = item.shader ? item.shader : &defaultShader;
+
+        if (shader != currentShader) {
+            m_stateCache.UseProgram(shader->GetProgramID());
+            if (shader != uniformsOwner) {
+                uniforms = ShaderUniforms(*shader);
+                uniformsOwner = shader;
+            }
+            currentShader = shader;
+            currentMaterial = nullptr;
+        }
+
+        if (batch.commandCount > 0) {
+            // 每条命令的baseInstance选择自己的模型矩阵和材质
+            m_stateCache.SetUniform1i(uniforms.useInstancing, 1);
+            m_stateCache.BindVertexArray(item.mesh->GetInstancedVAO());
+            BindInstanceAttributes(m_instanceBuffer, 0);
+            const size_t offset = static_cast<size_t>(batch.firstCommand) * sizeof(DrawElementsIndirectCommand);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, item.mesh->GetIndexType(), reinterpret_cast<const void*>(offset),
+                                        static_cast<GLsizei>(batch.commandCount), 0);
+            ++stats.drawCalls;
+            ++stats.multiDrawCalls;
+            stats.indirectCommands += batch.commandCount;
+            for (uint32_t i = 0; i < batch.commandCount; ++i) {
+                const DrawElementsIndirectCommand& command = m_commands[batch.firstCommand + i];
+                stats.instances += command.instanceCount;
+                stats.triangles += command.count / 3 * command.instanceCount;
+            }
+            continue;
+        }
+
+        if (batch.instanceCount > 0) {
+            // 模型矩阵和材质都来自实例缓冲
+            m_stateCache.SetUniform1i(uniforms.useInstancing, 1);
+            m_stateCache.BindVertexArray(item.mesh->GetInstancedVAO());
+            BindInstanceAttributes(m_instanceBuffer, batch.firstInstance);
+            item.mesh->DrawInstancedBound(static_cast<GLsizei>(batch.instanceCount));
+            ++stats.drawCalls;
+            ++stats.instancedDrawCalls;
+            stats.instances += batch.instanceCount;
+            stats.triangles += static_cast<uint32_t>(item.mesh->GetDrawCount() / 3) * batch.instanceCount;
+            continue;
+        }
+
+        m_stateCache.SetUniform1i(uniforms.useInstancing, 0);
+
+        // 材质uniform只在材质对象变化时检查，值相同的分量由状态缓存跳过
+        const Material* material = item.material ? item.material : &GetDefaultMaterial();
+        if (material != currentMaterial) {
+            m_stateCache.SetUniform3f(uniforms.ambient, material->GetAmbient());
+            m_stateCache.SetUniform3f(uniforms.diffuse, material->GetDiffuse());
+            m_stateCache.SetUniform3f(uniforms.specular, material->GetSpecular());
+            m_stateCache.SetUniform1f(uniforms.shininess, material->GetShininess());
+            m_stateCache.SetUniform1f(uniforms.alpha, material->GetAlpha());
+            currentMaterial = material;
+        }
+
+        m_stateCache.SetUniformMatrix4(uniforms.model, &item.model[0][0]);
+        m_stateCache.BindVertexArray(item.mesh->GetVAO());
+        item.mesh->DrawBound();
+        ++stats.drawCalls;
+        stats.triangles += static_cast<uint32_t>(item.mesh->GetDrawCount() / 3);
+    }
+
+    // 恢复普通绘制状态，之后直接调用SceneNode::Render等的代码不受影响
+    m_stateCache.SetUniform1i(uniforms.useInstancing, 0);
+    m_stateCache.BindVertexArray(0);
+    if (!m_commands.empty()) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "GLStateCache.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Mesh;
+class Material;
+class Shader;
+class SceneNode;
+
+// 渲染队列 - 遍历场景时收集绘制项，按64位排序键排序后通过状态缓存统一提交
+//
+// 排序键布局（高位优先）：
+//   不透明:  [63]=0 | [62..55] 程序 | [54..36] 网格 | [35..16] 材质 | [15..0] 深度（由近到远）
+//   半透明:  [63]=1 | [62..47] 反向深度（由远到近） | [46..39] 程序 | [38..20] 网格 | [19..0] 材质
+// 不透明物体按状态分组以减少切换，同一状态内由近到远绘制以利用提前深度测试；
+// 半透明物体必须从远到近绘制，深度优先于状态
+//
+// 实例化：排序后相邻、使用同一着色器和同一网格的绘制项合并为一次实例化绘制，
+// 模型矩阵和材质参数写入实例缓冲（材质作为逐实例属性，所以不同材质的物体也可以合并）
+//
+// 多重间接绘制（GL 4.3+，运行时检测，否则回退到上面的逐批次提交）：所有索引网格的绘制项都写入实例缓冲，
+// 每个批次成为间接缓冲中的一条DrawElementsIndirectCommand，baseInstance指向该批次在实例缓冲中的起点；
+// 排序后相邻、着色器/VAO/索引类型都相同的批次合并为一次glMultiDrawElementsIndirect。
+// 逐绘制数据仍通过逐实例属性读取（由baseInstance偏移），着色器不需要SSBO或gl_DrawID，保持GLSL 330
+class RenderQueue {
+public:
+    // 逐实例数据，与basic.vert中location 3-9的属性对应
+    struct InstanceData {
+        glm::mat4 model;
+        glm::vec3 ambient;
+        glm::vec3 diffuse;
+        glm::vec4 specular;  // xyz: 镜面反射颜色, w: 光泽度
+    };
+
+    // 逐实例属性的起始location（0-2为顶点属性，见VertexLayout；mat4占4个location，之后依次为ambient/diffuse/specular）
+    static constexpr GLuint InstanceAttributeLocation = 3;
+    static constexpr GLuint InstanceAttributeCount = 7;
+
+    // 间接绘制命令，布局由GL规定（glMultiDrawElementsIndirect）
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    struct DrawItem {
+        const Mesh* mesh = nullptr;
+        const Material* material = nullptr;  // nullptr使用默认材质
+        const Shader* shader = nullptr;      // nullptr使用Execute传入的着色器
+        glm::mat4 model = glm::mat4(1.0f);
+    };
+
+    RenderQueue() = default;
+    ~RenderQueue();
+
+    // 禁止拷贝（持有GL缓冲）
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // 实例化开关：相同网格的绘制项数量达到minInstances时合并为一次实例化绘制
+    void SetInstancingEnabled(bool enabled) { m_instancingEnabled = enabled; }
+    bool IsInstancingEnabled() const { return m_instancingEnabled; }
+    void SetMinInstanceCount(uint32_t minInstances) { m_minInstanceCount = minInstances < 2 ? 2 : minInstances; }
+
+    // 多重间接绘制开关（默认开启），上下文不支持时（低于GL 4.3）始终使用逐批次提交
+    void SetMultiDrawEnabled(bool enabled) { m_multiDrawEnabled = enabled; }
+    bool IsMultiDrawEnabled() const { return m_multiDrawEnabled; }
+
+    // 当前上下文是否支持多重间接绘制（需要有效的OpenGL上下文）
+    static bool IsMultiDrawSupported();
+
+    // 开始新的一帧：清空绘制项，view用于计算深度，depthRange为深度量化范围
+    void Begin(const glm::mat4& view, float depthRange = 100.0f);
+
+    // 添加绘制项
+    void Submit(const Mesh* mesh, const Material* material, const glm::mat4& model, const Shader* shader = nullptr);
+
+    // 添加场景节点（使用其缓存的世界矩阵），没有Mesh的节点被忽略
+    void Submit(const SceneNode& node, const Shader* shader = nullptr);
+
+    // 基数排序绘制项
+    void Sort();
+
+    // 按排序后的顺序提交，结束后解绑VAO并关闭useInstancing；调用方需已设置好view/projection等每帧uniform
+    void Execute(const Shader& defaultShader);
+
+    // 把当前绑定的实例化VAO的逐实例属性指向buffer（InstanceData数组）中从firstInstance开始的数据
+    static void BindInstanceAttributes(GLuint buffer, uint32_t firstInstance);
+
+    size_t GetItemCount() const { return m_items.size(); }
+    const RenderStats& GetStats() const { return m_stateCache.GetStats(); }
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // 一次绘制调用：commandCount大于0时是从firstCommand开始的多重间接绘制，
+    // 否则instanceCount为0时是普通绘制，大于0时从firstInstance开始实例化绘制
+    struct Batch {
+        uint32_t firstEntry;
+        uint32_t instanceCount;
+        uint32_t firstInstance;
+        uint32_t firstCommand = 0;
+        uint32_t commandCount = 0;
+    };
+
+    std::vector<DrawItem> m_items;
+    std::vector<SortEntry> m_entries;
+    std::vector<SortEntry> m_sortScratch;
+    std::vector<Batch> m_batches;
+    std::vector<InstanceData> m_instanceData;
+    std::vector<DrawElementsIndirectCommand> m_commands;
+    glm::mat4 m_view = glm::mat4(1.0f);
+    float m_inverseDepthRange = 0.01f;
+    bool m_sorted = false;
+
+    bool m_instancingEnabled = true;
+    uint32_t m_minInstanceCount = 2;
+    GLuint m_instanceBuffer = 0;
+
+    bool m_multiDrawEnabled = true;
+    int m_multiDrawSupported = -1;  // -1表示尚未检测
+    GLuint m_indirectBuffer = 0;
+
+    GLStateCache m_stateCache;
+
+    uint64_t MakeKey(const DrawItem& item) const;
+
+    // 把排序后的绘制项划分为绘制批次，并填充实例数据（multiDraw为true时同时生成间接绘制命令）
+    void BuildBatches(const Shader& defaultShader, bool multiDraw);
+
+    // 把一段连续的绘制项加入实例数据，返回第一个实例的下标
+    uint32_t AppendInstances(uint32_t firstEntry, uint32_t endEntry);
+
+    // 上传实例数据到实例缓冲
+    void UploadInstanceData();
+
+    // 上传间接绘制命令并保持间接缓冲绑定
+    void UploadCommands();
+};
+
+} // namespace SoulsEngine
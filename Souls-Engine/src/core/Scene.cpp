@@ -1,5 +1,7 @@
 #include "Scene.h"
 #include "Shader.h"
+#include "TransformSystem.h"
+#include "JobSystem.h"
 #include <algorithm>
 
 namespace SoulsEngine {
@@ -25,22 +27,53 @@ void Scene::RemoveNode(std::shared_ptr<Node> node) {
 }
 
 void Scene::Update() {
-    if (m_root) {
-        m_root->Update();
-    }
+    // 所有变换按深度连续存放在TransformSystem中，一次线性遍历即可更新全部世界矩阵；
+    // 根节点下的各子树互不依赖，由任务系统并行处理（工作线程数通过JobSystem::SetWorkerCount配置）
+    TransformSystem::Get().UpdateWorldTransforms(&JobSystem::Get());
 }
 
-void Scene::Render(Shader* shader) {
+void Scene::Render(Shader* shader, const glm::mat4& view, const ViewFrustum* frustum) {
     if (!shader || !m_root) return;
 
-    glm::mat4 identity = glm::mat4(1.0f);
+    m_renderQueue.Begin(view);
+    CollectDrawItems(m_renderQueue, NodeLayer::All, frustum);
+    m_renderQueue.Sort();
+    m_renderQueue.Execute(*shader);
+}
+
+void Scene::CollectDrawItems(RenderQueue& queue, uint32_t layerMask, const ViewFrustum* frustum) {
+    m_cullingStats = CullingStats();
+    if (!m_root) return;
+
+    // 世界包围盒连续存放在TransformSystem中，先批量测试一遍，遍历时只查表
+    // （Update之后又移动过的节点在这里补算，没有脏数据时只是一次线性扫描）
+    const std::vector<uint8_t>* visibility = nullptr;
+    if (frustum) {
+        TransformSystem& transforms = TransformSystem::Get();
+        transforms.UpdateWorldTransforms(&JobSystem::Get());
+        transforms.CullWorldBounds(*frustum, m_visibility);
+        visibility = &m_visibility;
+    }
+    CollectDrawItemsRecursive(*m_root, queue, layerMask, visibility, m_cullingStats);
+}
 
-    // 遍历所有子节点并渲染
-    for (auto& child : m_root->GetChildren()) {
-        auto sceneNode = std::dynamic_pointer_cast<SceneNode>(child);
-        if (sceneNode) {
-            sceneNode->Render(identity, shader);
+void Scene::CollectDrawItemsRecursive(const Node& node, RenderQueue& queue, uint32_t layerMask,
+                                      const std::vector<uint8_t>* visibility, CullingStats& stats) {
+    for (const auto& child : node.GetChildren()) {
+        // 世界矩阵已由TransformSystem缓存，这里不再逐层相乘
+        const SceneNode* sceneNode = child->AsSceneNode();
+        if (sceneNode && sceneNode->GetMesh() && sceneNode->IsInLayer(layerMask)) {
+            if (!visibility) {
+                queue.Submit(*sceneNode);
+            } else {
+                stats.tested++;
+                if (TransformSystem::Get().IsVisible(*visibility, sceneNode->GetTransformId())) {
+                    stats.visible++;
+                    queue.Submit(*sceneNode);
+                }
+            }
         }
+        CollectDrawItemsRecursive(*child, queue, layerMask, visibility, stats);
     }
 }
 
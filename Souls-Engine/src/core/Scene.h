@@ -2,6 +2,8 @@
 
 #include "Node.h"
 #include "SceneNode.h"
+#include "RenderQueue.h"
+#include "ViewFrustum.h"
 #include <memory>
 #include <vector>
 
@@ -29,13 +31,34 @@ public:
 
     // 场景遍历
     void Update();
-    void Render(Shader* shader);
+
+    // 收集场景中的可渲染节点并经渲染队列排序提交，view用于按深度排序
+    // frustum非空时跳过世界包围盒在视锥体外的节点
+    void Render(Shader* shader, const glm::mat4& view = glm::mat4(1.0f), const ViewFrustum* frustum = nullptr);
+
+    // 把层掩码内的可渲染节点加入渲染队列（使用缓存的世界矩阵和世界包围盒）
+    void CollectDrawItems(RenderQueue& queue, uint32_t layerMask = NodeLayer::All, const ViewFrustum* frustum = nullptr);
+
+    // 上一次Render的统计信息
+    const RenderStats& GetRenderStats() const { return m_renderQueue.GetStats(); }
+
+    // 上一次CollectDrawItems的剔除统计（未传视锥体时测试数为0）
+    const CullingStats& GetCullingStats() const { return m_cullingStats; }
 
     // 查找节点
     std::shared_ptr<Node> FindNodeByName(const std::string& name) const;
 
 private:
     std::shared_ptr<Node> m_root;
+    RenderQueue m_renderQueue;
+
+    // 按槽位记录的可见性（CullWorldBounds的输出）和剔除统计
+    std::vector<uint8_t> m_visibility;
+    CullingStats m_cullingStats;
+
+    // 递归收集绘制项，visibility为空时不剔除
+    static void CollectDrawItemsRecursive(const Node& node, RenderQueue& queue, uint32_t layerMask,
+                                          const std::vector<uint8_t>* visibility, CullingStats& stats);
 
     // 递归查找节点
     std::shared_ptr<Node> FindNodeRecursive(std::shared_ptr<Node> node, const std::string& name) const;
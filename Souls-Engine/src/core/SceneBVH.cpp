@@ -0,0 +1,374 @@
+#include "SceneBVH.h"
+#include "SceneNode.h"
+#include "../geometry/Mesh.h"
+#include <algorithm>
+#include <numeric>
+
+namespace SoulsEngine {
+
+namespace {
+    // SAH分桶数
+    constexpr int BinCount = 12;
+
+    // 遍历一个内部节点相对测试一个图元的代价
+    constexpr float TraversalCost = 1.0f;
+
+    // 拟合后总表面积超过构建时的倍数时要求重建
+    constexpr float RebuildAreaRatio = 2.0f;
+
+    // 遍历栈的固定容量（更深的树改用堆上的栈）
+    constexpr uint32_t LocalStackSize = 64;
+
+    float SurfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        glm::vec3 size = boundsMax - boundsMin;
+        if (size.x < 0.0f || size.y < 0.0f || size.z < 0.0f) return 0.0f;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+}
+
+void SceneBVH::Build(const std::vector<SceneNode*>& nodes) {
+    Clear();
+    if (nodes.empty()) return;
+
+    // 没有Mesh的节点也作为图元加入（包围盒为空，永远不会命中），
+    // 之后设置了Mesh只需要重新拟合，不必重建
+    TransformSystem& transforms = TransformSystem::Get();
+    m_primitives.reserve(nodes.size());
+    for (SceneNode* node : nodes) {
+        Primitive primitive;
+        primitive.node = node;
+        primitive.transformId = node->GetTransformId();
+        BoundingBox bounds = transforms.GetWorldBounds(primitive.transformId);
+        primitive.boundsMin = bounds.IsValid() ? bounds.GetMin() : glm::vec3(FLT_MAX);
+        primitive.boundsMax = bounds.IsValid() ? bounds.GetMax() : glm::vec3(-FLT_MAX);
+        primitive.centroid = bounds.IsValid() ? bounds.center : glm::vec3(0.0f);
+        m_primitives.push_back(primitive);
+    }
+
+    const uint32_t primitiveCount = static_cast<uint32_t>(m_primitives.size());
+    m_primitiveIndices.resize(primitiveCount);
+    std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0u);
+
+    // 最多2N-1个节点，预留后构建过程中引用不会失效
+    m_nodes.reserve(static_cast<size_t>(primitiveCount) * 2);
+    Node root = {};
+    root.leftOrFirst = 0;
+    root.count = primitiveCount;
+    m_nodes.push_back(root);
+    UpdateNodeBounds(0);
+
+    // 用显式栈代替递归，退化的输入也不会栈溢出
+    std::vector<std::pair<uint32_t, uint32_t>> pending;  // (节点, 深度)
+    pending.emplace_back(0u, 0u);
+    while (!pending.empty()) {
+        auto [nodeIndex, depth] = pending.back();
+        pending.pop_back();
+        m_maxDepth = std::max(m_maxDepth, depth);
+
+        const size_t before = m_nodes.size();
+        Subdivide(nodeIndex);
+        if (m_nodes.size() != before) {
+            pending.emplace_back(m_nodes[nodeIndex].leftOrFirst + 1, depth + 1);
+            pending.emplace_back(m_nodes[nodeIndex].leftOrFirst, depth + 1);
+        }
+    }
+
+    m_builtArea = ComputeTotalArea();
+}
+
+void SceneBVH::Clear() {
+    m_nodes.clear();
+    m_primitives.clear();
+    m_primitiveIndices.clear();
+    m_builtArea = 0.0f;
+    m_maxDepth = 0;
+}
+
+bool SceneBVH::Refit() {
+    if (m_nodes.empty()) return true;
+
+    TransformSystem& transforms = TransformSystem::Get();
+    for (Primitive& primitive : m_primitives) {
+        BoundingBox bounds = transforms.GetWorldBounds(primitive.transformId);
+        primitive.boundsMin = bounds.IsValid() ? bounds.GetMin() : glm::vec3(FLT_MAX);
+        primitive.boundsMax = bounds.IsValid() ? bounds.GetMax() : glm::vec3(-FLT_MAX);
+        primitive.centroid = bounds.IsValid() ? bounds.center : glm::vec3(0.0f);
+    }
+
+    // 子节点总在父节点之后，从后往前一次遍历即可
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        Node& node = m_nodes[i];
+        if (node.count > 0) {
+            UpdateNodeBounds(static_cast<uint32_t>(i));
+        } else {
+            const Node& left = m_nodes[node.leftOrFirst];
+            const Node& right = m_nodes[node.leftOrFirst + 1];
+            node.boundsMin = glm::min(left.boundsMin, right.boundsMin);
+            node.boundsMax = glm::max(left.boundsMax, right.boundsMax);
+            node.layers = left.layers | right.layers;
+        }
+    }
+
+    return ComputeTotalArea() <= m_builtArea * RebuildAreaRatio;
+}
+
+void SceneBVH::UpdateNodeBounds(uint32_t nodeIndex) {
+    Node& node = m_nodes[nodeIndex];
+    node.boundsMin = glm::vec3(FLT_MAX);
+    node.boundsMax = glm::vec3(-FLT_MAX);
+    node.layers = 0;
+    for (uint32_t i = 0; i < node.count; ++i) {
+        const Primitive& primitive = m_primitives[m_primitiveIndices[node.leftOrFirst + i]];
+        node.boundsMin = glm::min(node.boundsMin, primitive.boundsMin);
+        node.boundsMax = glm::max(node.boundsMax, primitive.boundsMax);
+        if (primitive.boundsMin.x <= primitive.boundsMax.x) {
+            node.layers |= primitive.node->GetLayer();
+        }
+    }
+}
+
+float SceneBVH::FindBestSplit(const Node& node, int& axis, float& position) const {
+    // 按图元中心的范围分桶
+    glm::vec3 centroidMin(FLT_MAX);
+    glm::vec3 centroidMax(-FLT_MAX);
+    for (uint32_t i = 0; i < node.count; ++i) {
+        const glm::vec3& centroid = m_primitives[m_primitiveIndices[node.leftOrFirst + i]].centroid;
+        centroidMin = glm::min(centroidMin, centroid);
+        centroidMax = glm::max(centroidMax, centroid);
+    }
+
+    struct Bin {
+        glm::vec3 boundsMin = glm::vec3(FLT_MAX);
+        glm::vec3 boundsMax = glm::vec3(-FLT_MAX);
+        uint32_t count = 0;
+    };
+
+    float bestCost = FLT_MAX;
+    for (int a = 0; a < 3; ++a) {
+        const float extent = centroidMax[a] - centroidMin[a];
+        if (extent <= 0.0f) continue;
+
+        Bin bins[BinCount];
+        const float scale = BinCount / extent;
+        for (uint32_t i = 0; i < node.count; ++i) {
+            const Primitive& primitive = m_primitives[m_primitiveIndices[node.leftOrFirst + i]];
+            int binIndex = std::min(BinCount - 1, static_cast<int>((primitive.centroid[a] - centroidMin[a]) * scale));
+            Bin& bin = bins[binIndex];
+            bin.count++;
+            bin.boundsMin = glm::min(bin.boundsMin, primitive.boundsMin);
+            bin.boundsMax = glm::max(bin.boundsMax, primitive.boundsMax);
+        }
+
+        // 两趟扫描得到每个切分平面左右两侧的表面积和图元数
+        float leftArea[BinCount - 1], rightArea[BinCount - 1];
+        uint32_t leftCount[BinCount - 1], rightCount[BinCount - 1];
+        glm::vec3 leftMin(FLT_MAX), leftMax(-FLT_MAX), rightMin(FLT_MAX), rightMax(-FLT_MAX);
+        uint32_t leftSum = 0, rightSum = 0;
+        for (int i = 0; i < BinCount - 1; ++i) {
+            leftSum += bins[i].count;
+            leftCount[i] = leftSum;
+            leftMin = glm::min(leftMin, bins[i].boundsMin);
+            leftMax = glm::max(leftMax, bins[i].boundsMax);
+            leftArea[i] = SurfaceArea(leftMin, leftMax);
+
+            rightSum += bins[BinCount - 1 - i].count;
+            rightCount[BinCount - 2 - i] = rightSum;
+            rightMin = glm::min(rightMin, bins[BinCount - 1 - i].boundsMin);
+            rightMax = glm::max(rightMax, bins[BinCount - 1 - i].boundsMax);
+            rightArea[BinCount - 2 - i] = SurfaceArea(rightMin, rightMax);
+        }
+
+        for (int i = 0; i < BinCount - 1; ++i) {
+            if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+            float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+            if (cost < bestCost) {
+                bestCost = cost;
+                axis = a;
+                position = centroidMin[a] + (i + 1) / scale;
+            }
+        }
+    }
+    return bestCost;
+}
+
+void SceneBVH::Subdivide(uint32_t nodeIndex) {
+    Node& node = m_nodes[nodeIndex];
+    if (node.count <= 1) return;
+
+    int axis = 0;
+    float position = 0.0f;
+    const float splitCost = FindBestSplit(node, axis, position);
+
+    // SAH：切分后的期望代价不低于直接作为叶子时停止
+    const float nodeArea = SurfaceArea(node.boundsMin, node.boundsMax);
+    const float leafCost = node.count * nodeArea;
+    if (splitCost == FLT_MAX || splitCost + TraversalCost * nodeArea >= leafCost) return;
+
+    // 按切分平面原地划分图元
+    uint32_t i = node.leftOrFirst;
+    uint32_t j = i + node.count;
+    while (i < j) {
+        if (m_primitives[m_primitiveIndices[i]].centroid[axis] < position) {
+            ++i;
+        } else {
+            std::swap(m_primitiveIndices[i], m_primitiveIndices[--j]);
+        }
+    }
+
+    const uint32_t leftCount = i - node.leftOrFirst;
+    if (leftCount == 0 || leftCount == node.count) return;
+
+    const uint32_t leftIndex = static_cast<uint32_t>(m_nodes.size());
+    Node left = {};
+    left.leftOrFirst = node.leftOrFirst;
+    left.count = leftCount;
+    Node right = {};
+    right.leftOrFirst = i;
+    right.count = node.count - leftCount;
+    m_nodes.push_back(left);
+    m_nodes.push_back(right);
+
+    // push_back前已预留容量，node引用仍然有效
+    node.leftOrFirst = leftIndex;
+    node.count = 0;
+    UpdateNodeBounds(leftIndex);
+    UpdateNodeBounds(leftIndex + 1);
+}
+
+float SceneBVH::IntersectBounds(const Ray& ray, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxDistance) {
+    // 平板法
+    glm::vec3 t1 = (boundsMin - ray.origin) * ray.invDirection;
+    glm::vec3 t2 = (boundsMax - ray.origin) * ray.invDirection;
+    glm::vec3 tMin = glm::min(t1, t2);
+    glm::vec3 tMax = glm::max(t1, t2);
+    float tNear = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+    float tFar = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+    return tNear <= tFar ? tNear : FLT_MAX;
+}
+
+bool SceneBVH::IntersectPrimitive(const Ray& ray, const Primitive& primitive, float maxDistance, float& distance) {
+    if (primitive.boundsMin.x > primitive.boundsMax.x) return false;
+    if (IntersectBounds(ray, primitive.boundsMin, primitive.boundsMax, maxDistance) == FLT_MAX) return false;
+
+    const auto& mesh = primitive.node->GetMesh();
+    if (!mesh) return false;
+    const BoundingBox& localBounds = mesh->GetLocalBounds();
+    if (!localBounds.IsValid()) return false;
+
+    // 仿射变换保持射线参数不变：局部空间的t就是世界空间的t
+    const glm::mat4& inverseWorld = TransformSystem::Get().GetInverseWorldMatrix(primitive.transformId);
+    Ray localRay;
+    localRay.origin = glm::vec3(inverseWorld * glm::vec4(ray.origin, 1.0f));
+    localRay.direction = glm::vec3(inverseWorld * glm::vec4(ray.direction, 0.0f));
+    localRay.invDirection = 1.0f / localRay.direction;
+
+    float t = IntersectBounds(localRay, localBounds.GetMin(), localBounds.GetMax(), maxDistance);
+    if (t == FLT_MAX) return false;
+    distance = t;
+    return true;
+}
+
+template <bool AnyHit>
+bool SceneBVH::Traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                        uint32_t layerMask, RayHit* hit) const {
+    if (m_nodes.empty() || !(m_nodes[0].layers & layerMask)) return false;
+
+    Ray ray;
+    ray.origin = origin;
+    ray.direction = direction;
+    ray.invDirection = 1.0f / direction;
+
+    float closest = maxDistance;
+    SceneNode* closestNode = nullptr;
+    if (IntersectBounds(ray, m_nodes[0].boundsMin, m_nodes[0].boundsMax, closest) == FLT_MAX) return false;
+
+    // 栈中记录进入距离，出栈时已经比当前最近命中更远的子树直接跳过
+    struct StackEntry {
+        uint32_t node;
+        float distance;
+    };
+    StackEntry localStack[LocalStackSize];
+    std::vector<StackEntry> heapStack;
+    StackEntry* stack = localStack;
+    if (m_maxDepth >= LocalStackSize) {
+        heapStack.resize(m_maxDepth + 1);
+        stack = heapStack.data();
+    }
+    uint32_t stackSize = 0;
+    uint32_t nodeIndex = 0;
+
+    while (true) {
+        const Node& node = m_nodes[nodeIndex];
+        if (node.count > 0) {
+            for (uint32_t i = 0; i < node.count; ++i) {
+                const Primitive& primitive = m_primitives[m_primitiveIndices[node.leftOrFirst + i]];
+                if (!primitive.node->IsInLayer(layerMask)) continue;
+                float distance;
+                if (IntersectPrimitive(ray, primitive, closest, distance)) {
+                    if (AnyHit) return true;
+                    closest = distance;
+                    closestNode = primitive.node;
+                }
+            }
+        } else {
+            // 近的子节点先访问，远的压栈
+            uint32_t first = node.leftOrFirst;
+            uint32_t second = node.leftOrFirst + 1;
+            float firstDistance = (m_nodes[first].layers & layerMask)
+                ? IntersectBounds(ray, m_nodes[first].boundsMin, m_nodes[first].boundsMax, closest) : FLT_MAX;
+            float secondDistance = (m_nodes[second].layers & layerMask)
+                ? IntersectBounds(ray, m_nodes[second].boundsMin, m_nodes[second].boundsMax, closest) : FLT_MAX;
+            if (secondDistance < firstDistance) {
+                std::swap(first, second);
+                std::swap(firstDistance, secondDistance);
+            }
+            if (firstDistance != FLT_MAX) {
+                if (secondDistance != FLT_MAX) {
+                    stack[stackSize++] = { second, secondDistance };
+                }
+                nodeIndex = first;
+                continue;
+            }
+        }
+
+        // 出栈
+        bool found = false;
+        while (stackSize > 0) {
+            const StackEntry& entry = stack[--stackSize];
+            if (entry.distance <= closest) {
+                nodeIndex = entry.node;
+                found = true;
+                break;
+            }
+        }
+        if (!found) break;
+    }
+
+    if (!closestNode) return false;
+    if (hit) {
+        hit->node = closestNode;
+        hit->distance = closest;
+        hit->point = origin + direction * closest;
+    }
+    return true;
+}
+
+bool SceneBVH::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                       uint32_t layerMask, RayHit& hit) const {
+    return Traverse<false>(origin, direction, maxDistance, layerMask, &hit);
+}
+
+bool SceneBVH::RaycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                          uint32_t layerMask) const {
+    return Traverse<true>(origin, direction, maxDistance, layerMask, nullptr);
+}
+
+float SceneBVH::ComputeTotalArea() const {
+    float area = 0.0f;
+    for (const Node& node : m_nodes) {
+        area += SurfaceArea(node.boundsMin, node.boundsMax);
+    }
+    return area;
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "TransformSystem.h"
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class SceneNode;
+
+// 射线查询结果
+struct RayHit {
+    SceneNode* node = nullptr;
+    float distance = FLT_MAX;  // 沿射线方向的参数t（方向为单位向量时即世界空间距离）
+    glm::vec3 point = glm::vec3(0.0f);
+};
+
+// 场景层次包围盒 - 以节点的世界包围盒为图元，按表面积启发式（SAH，分桶近似）自顶向下构建
+//
+// 节点以深度优先顺序存放在一个数组中，两个子节点相邻且总在父节点之后，
+// 因此重新拟合（Refit）只需从后往前遍历一次。节点移动后重新拟合即可，
+// 拟合后的总表面积比构建时增长过多（树的质量明显下降）时改为重新构建
+//
+// 射线查询先用世界包围盒剪枝，叶子中再把射线变换到节点局部空间，
+// 与网格的局部包围盒做精确的有向包围盒测试
+class SceneBVH {
+public:
+    SceneBVH() = default;
+
+    // 用一组节点构建；节点指针在下一次Build/Clear之前必须保持有效
+    // 子树的层掩码在Build/Refit时记录，之后修改节点的层要到下一次Build/Refit才影响剪枝
+    void Build(const std::vector<SceneNode*>& nodes);
+    void Clear();
+
+    // 从TransformSystem读取最新的世界包围盒并自底向上更新节点包围盒
+    // 返回false表示树的质量下降过多，调用方应当重新Build
+    bool Refit();
+
+    // 最近命中：返回maxDistance之内、属于layerMask中任一层的最近节点
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 uint32_t layerMask, RayHit& hit) const;
+
+    // 任意命中：找到第一个命中就返回（用于遮挡/视线检测）
+    bool RaycastAny(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                    uint32_t layerMask) const;
+
+    // 统计
+    size_t GetPrimitiveCount() const { return m_primitives.size(); }
+    size_t GetNodeCount() const { return m_nodes.size(); }
+    bool IsEmpty() const { return m_nodes.empty(); }
+
+private:
+    // 32字节节点 + 层掩码：叶子的leftOrFirst为第一个图元在m_primitiveIndices中的位置，
+    // 内部节点的leftOrFirst为左子节点下标（右子节点紧随其后），count为0
+    struct Node {
+        glm::vec3 boundsMin;
+        uint32_t leftOrFirst;
+        glm::vec3 boundsMax;
+        uint32_t count;
+        uint32_t layers;  // 子树中所有图元的层的并集，用于按层剪枝
+    };
+
+    struct Primitive {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        glm::vec3 centroid;
+        SceneNode* node;
+        TransformId transformId;
+    };
+
+    // 射线与节点的预计算数据
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        glm::vec3 invDirection;
+    };
+
+    void UpdateNodeBounds(uint32_t nodeIndex);
+    void Subdivide(uint32_t nodeIndex);
+
+    // 返回切分代价，axis/position为最佳切分
+    float FindBestSplit(const Node& node, int& axis, float& position) const;
+
+    // 射线与包围盒求交，返回进入距离（不相交时返回FLT_MAX）
+    static float IntersectBounds(const Ray& ray, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxDistance);
+
+    // 叶子中的精确测试：射线变换到节点局部空间后与网格包围盒求交
+    static bool IntersectPrimitive(const Ray& ray, const Primitive& primitive, float maxDistance, float& distance);
+
+    template <bool AnyHit>
+    bool Traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  uint32_t layerMask, RayHit* hit) const;
+
+    float ComputeTotalArea() const;
+
+    std::vector<Node> m_nodes;
+    std::vector<Primitive> m_primitives;
+    std::vector<uint32_t> m_primitiveIndices;
+    float m_builtArea = 0.0f;  // 构建时所有节点的表面积之和
+    uint32_t m_maxDepth = 0;   // 树的最大深度（决定遍历栈的大小）
+};
+
+} // namespace SoulsEngine
@@ -1,10 +1,13 @@
 #include "SceneNode.h"
+#include "ObjectManager.h"
 #include "Shader.h"
 #include "Material.h"
 #include "../geometry/Mesh.h"
+#include "../geometry/MeshLOD.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 
 namespace SoulsEngine {
 
@@ -12,9 +15,61 @@ SceneNode::SceneNode(const std::string& name)
     : Node(name)
     , m_mesh(nullptr)
     , m_material(nullptr)
+    , m_layer(NodeLayer::Default)
 {
 }
 
+void SceneNode::SetName(const std::string& name) {
+    if (!m_owner || name == m_name) {
+        m_name = name;
+        return;
+    }
+    std::string oldName = std::move(m_name);
+    m_name = name;
+    m_owner->OnNodeRenamed(oldName, *this);
+}
+
+void SceneNode::SetMaterial(std::shared_ptr<Material> material) {
+    m_material = material;
+    // 更换材质对缓存材质数据的系统来说与修改材质参数相同
+    Material::MarkChanged();
+}
+
+void SceneNode::SetMesh(std::shared_ptr<Mesh> mesh) {
+    m_mesh = mesh;
+    m_meshLOD.reset();
+    m_lodLevel = 0;
+    TransformSystem::Get().SetLocalBounds(m_transformId, m_mesh ? m_mesh->GetLocalBounds() : BoundingBox());
+}
+
+void SceneNode::SetMeshLOD(std::shared_ptr<MeshLOD> meshLOD) {
+    if (!meshLOD || meshLOD->GetLevelCount() == 0) {
+        SetMesh(nullptr);
+        return;
+    }
+    m_meshLOD = meshLOD;
+    m_lodLevel = 0;
+    m_mesh = m_meshLOD->GetLevel(0).mesh;
+    TransformSystem::Get().SetLocalBounds(m_transformId, m_meshLOD->GetLocalBounds());
+}
+
+bool SceneNode::SelectLOD(const LODContext& context) {
+    if (!m_meshLOD) return false;
+
+    // 局部包围球变换到世界空间（非均匀缩放时取最大缩放，保证包含）
+    const BoundingSphere& sphere = m_meshLOD->GetBoundingSphere();
+    const glm::mat4 world = GetWorldTransform();
+    const glm::vec3 center(world * glm::vec4(sphere.center, 1.0f));
+    const float scale = std::max(glm::length(glm::vec3(world[0])),
+                                 std::max(glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))));
+
+    const int level = m_meshLOD->SelectLevel(context.GetScreenRadius(center, sphere.radius * scale), m_lodLevel);
+    if (level == m_lodLevel) return false;
+    m_lodLevel = level;
+    m_mesh = m_meshLOD->GetLevel(level).mesh;
+    return true;
+}
+
 void SceneNode::Render(const glm::mat4& parentTransform, Shader* shader) {
     if (!m_mesh || !shader) return;
 
@@ -1,14 +1,27 @@
 #pragma once
 
 #include "Node.h"
+#include "NodeHandle.h"
+#include <cstdint>
 #include <memory>
 
 namespace SoulsEngine {
 
+// 节点层（位掩码，一个节点可以属于多个层）
+namespace NodeLayer {
+    constexpr uint32_t Default = 1u << 0;      // 普通物体
+    constexpr uint32_t Environment = 1u << 1;  // 地面、墙体等环境
+    constexpr uint32_t ViewModel = 1u << 2;    // 跟随相机单独绘制的模型（如第一人称武器）
+    constexpr uint32_t All = 0xFFFFFFFFu;
+}
+
 // 鍓嶅悜澹版槑
 class Mesh;
+class MeshLOD;
+struct LODContext;
 class Shader;
 class Material;
+class ObjectManager;
 
 // 鍦烘櫙鑺傜偣锛堝彲浠ラ檮鍔燤esh鍜孧aterial锟�?
 class SceneNode : public Node {
@@ -16,13 +29,39 @@ public:
     SceneNode(const std::string& name = "SceneNode");
     virtual ~SceneNode() = default;
 
+    const SceneNode* AsSceneNode() const override { return this; }
+
     // 璁剧疆Mesh
-    void SetMesh(std::shared_ptr<Mesh> mesh) { m_mesh = mesh; }
-    std::shared_ptr<Mesh> GetMesh() const { return m_mesh; }
+    // 同时把网格的局部包围盒登记到TransformSystem，用于视锥体剔除
+    void SetMesh(std::shared_ptr<Mesh> mesh);
+    const std::shared_ptr<Mesh>& GetMesh() const { return m_mesh; }
+
+    // 细节层次：GetMesh()返回当前选中的层次，SetMesh会清除细节层次组
+    // 包围盒使用所有层次的并集，切换层次不需要更新TransformSystem
+    void SetMeshLOD(std::shared_ptr<MeshLOD> meshLOD);
+    const std::shared_ptr<MeshLOD>& GetMeshLOD() const { return m_meshLOD; }
+    int GetLODLevel() const { return m_lodLevel; }
+
+    // 按世界包围球的屏幕半径重新选择层次，层次改变时返回true
+    bool SelectLOD(const LODContext& context);
 
     // 璁剧疆鏉愯川
-    void SetMaterial(std::shared_ptr<Material> material) { m_material = material; }
-    std::shared_ptr<Material> GetMaterial() const { return m_material; }
+    void SetMaterial(std::shared_ptr<Material> material);
+    const std::shared_ptr<Material>& GetMaterial() const { return m_material; }
+
+    // 节点层
+    void SetLayer(uint32_t layer) { m_layer = layer; }
+    uint32_t GetLayer() const { return m_layer; }
+    bool IsInLayer(uint32_t layerMask) const { return (m_layer & layerMask) != 0; }
+
+    // 遮挡体：由OcclusionCuller按网格包围盒光栅化，只应标记本身接近盒子的大物体（墙、地面）
+    void SetOccluder(bool occluder) { m_occluder = occluder; }
+    bool IsOccluder() const { return m_occluder; }
+
+    // 静态物体：创建后不再移动、不改变网格的物体（墙、地面），ShadowMap把它们的深度缓存起来，
+    // 只在光源、级联或静态物体本身变化时重新绘制
+    void SetStatic(bool isStatic) { m_static = isStatic; }
+    bool IsStatic() const { return m_static; }
 
     // 娓叉煋锛堥噸鍐欏熀绫绘柟娉曪級
     virtual void Render(const glm::mat4& parentTransform, Shader* shader) override;
@@ -30,9 +69,23 @@ public:
     // 娓叉煋绾挎锛堢敤浜庨€変腑楂樹寒锟�?
     void RenderWireframe(const glm::mat4& parentTransform, Shader* shader);
 
+    // 改名：已注册的节点同时更新所属ObjectManager的名称索引
+    void SetName(const std::string& name) override;
+
+    // 在ObjectManager中注册后的句柄和所属的管理器（未注册时为空）
+    NodeHandle GetHandle() const { return m_handle; }
+    void SetHandle(NodeHandle handle, ObjectManager* owner = nullptr) { m_handle = handle; m_owner = owner; }
+
 private:
     std::shared_ptr<Mesh> m_mesh;
+    std::shared_ptr<MeshLOD> m_meshLOD;
+    int m_lodLevel = 0;
     std::shared_ptr<Material> m_material;  // 鏉愯川
+    NodeHandle m_handle;
+    ObjectManager* m_owner = nullptr;
+    uint32_t m_layer;
+    bool m_occluder = false;
+    bool m_static = false;
 };
 
 } // namespace SoulsEngine
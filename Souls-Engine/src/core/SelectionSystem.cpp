@@ -4,6 +4,7 @@
 
 #include "SelectionSystem.h"
 #include "Camera.h"
+#include "ObjectManager.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -314,9 +315,9 @@ glm::vec3 SelectionSystem::ScreenToWorld(const glm::vec2& screenPos, const Camer
 }
 
 std::shared_ptr<SceneNode> SelectionSystem::PickNode(const glm::vec2& screenPos, const Camera& camera,
-                                                     const std::vector<std::shared_ptr<SceneNode>>& nodes,
-                                                     int windowWidth, int windowHeight) const {
-    if (nodes.empty()) return nullptr;
+                                                     ObjectManager& objectManager, int windowWidth, int windowHeight,
+                                                     uint32_t layerMask) const {
+    if (objectManager.GetNodeCount() == 0) return nullptr;
     
     // 璁＄畻浠庣浉鏈哄埌榧犳爣鐨勫皠绾?
     glm::vec3 cameraPos = camera.GetPosition();
@@ -341,64 +342,12 @@ std::shared_ptr<SceneNode> SelectionSystem::PickNode(const glm::vec2& screenPos,
     // 灏勭嚎璧风偣鏄浉鏈轰綅缃?
     glm::vec3 rayOrigin = cameraPos;
     
-    // 閬嶅巻鎵€鏈夎妭鐐癸紝鎵惧埌涓庡皠绾跨浉浜ょ殑鏈€杩戣妭鐐?
-    std::shared_ptr<SceneNode> closestNode = nullptr;
-    float closestT = std::numeric_limits<float>::max();
-    
-    for (auto& node : nodes) {
-        if (!node) continue;
-        
-        // 跳过不可选的地面节点（例如名称为 "Ground" 的默认环境），防止被鼠标选中或移动
-        if (node->GetName() == "Ground") continue;
-        
-        // 鑾峰彇鑺傜偣鐨勪笘鐣屽彉鎹㈢煩闃?
-        glm::mat4 worldTransform = node->GetWorldTransform();
-        
-        // 璁＄畻鑺傜偣鐨勫寘鍥寸洅锛堝湪灞€閮ㄧ┖闂翠腑锛屽亣璁炬槸鍗曚綅绔嬫柟浣擄級
-        // 鑰冭檻鑺傜偣鐨勭缉鏀?
-        glm::vec3 scale = node->GetScale();
-        glm::vec3 boxMin = glm::vec3(-0.5f) * scale;
-        glm::vec3 boxMax = glm::vec3(0.5f) * scale;
-        
-        // 浣跨敤鍙樻崲鐭╅樀鐨勯€嗙煩闃靛皢灏勭嚎杞崲鍒板眬閮ㄧ┖闂?
-        // 杩欐牱鍙互姝ｇ‘澶勭悊鏃嬭浆鍜岀缉鏀?
-        glm::mat4 invTransform = glm::inverse(worldTransform);
-        glm::vec3 localRayOrigin = glm::vec3(invTransform * glm::vec4(rayOrigin, 1.0f));
-        glm::vec3 localRayDir = glm::vec3(invTransform * glm::vec4(rayDir, 0.0f));
-        
-        // 褰掍竴鍖栨柟鍚戝悜閲忥紙娉ㄦ剰锛氬湪灞€閮ㄧ┖闂翠腑锛屾柟鍚戝悜閲忓彲鑳借缂╂斁褰卞搷锛?
-        float dirLength = glm::length(localRayDir);
-        if (dirLength < 0.0001f) continue; // 閬垮厤闄ら浂
-        localRayDir = localRayDir / dirLength;
-        
-        // 鍦ㄥ眬閮ㄧ┖闂翠腑杩涜灏勭嚎-AABB鐩镐氦妫€娴?
-        glm::vec3 invDir = 1.0f / localRayDir;
-        glm::vec3 t1 = (boxMin - localRayOrigin) * invDir;
-        glm::vec3 t2 = (boxMax - localRayOrigin) * invDir;
-        
-        glm::vec3 tMin = glm::min(t1, t2);
-        glm::vec3 tMax = glm::max(t1, t2);
-        
-        float tNear = glm::max(glm::max(tMin.x, tMin.y), tMin.z);
-        float tFar = glm::min(glm::min(tMax.x, tMax.y), tMax.z);
-        
-        // 妫€鏌ユ槸鍚︾浉浜?
-        if (tNear <= tFar && tFar >= 0.0f) {
-            // 鐩镐氦锛屼娇鐢ㄨ緝杩戠殑浜ょ偣
-            float t = (tNear >= 0.0f) ? tNear : tFar;
-            
-            // 灏唗杞崲鍥炰笘鐣岀┖闂达紙涔樹互鏂瑰悜鍚戦噺鐨勫師濮嬮暱搴︼級
-            float worldT = t * dirLength;
-            
-            // 鍙€冭檻鐩告満鍓嶆柟鐨勪氦鐐?
-            if (worldT >= 0.0f && worldT < closestT) {
-                closestT = worldT;
-                closestNode = node;
-            }
-        }
+    // 经层次包围盒查询最近命中，叶子中按网格的局部包围盒做精确的有向包围盒测试
+    RayHit hit;
+    if (!objectManager.Raycast(rayOrigin, rayDir, std::numeric_limits<float>::max(), layerMask, hit)) {
+        return nullptr;
     }
-    
-    return closestNode;
+    return objectManager.GetSharedNode(hit.node->GetHandle());
 }
 
 } // namespace SoulsEngine
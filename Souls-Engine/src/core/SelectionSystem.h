@@ -10,6 +10,7 @@ namespace SoulsEngine {
 
 // 前向声明
 class Camera;
+class ObjectManager;
 
 // 选择系统类
 class SelectionSystem {
@@ -41,10 +42,10 @@ public:
     void EndScale();
     bool IsScaling() const { return m_isScaling; }
 
-    // 根据鼠标位置选择最近的节点（简化版射线检测）
-    std::shared_ptr<SceneNode> PickNode(const glm::vec2& screenPos, const Camera& camera, 
-                                         const std::vector<std::shared_ptr<SceneNode>>& nodes, 
-                                         int windowWidth, int windowHeight) const;
+    // 根据鼠标位置选择射线命中的最近节点（经ObjectManager的层次包围盒查询，默认不选地面、墙体和第一人称模型）
+    std::shared_ptr<SceneNode> PickNode(const glm::vec2& screenPos, const Camera& camera,
+                                         ObjectManager& objectManager, int windowWidth, int windowHeight,
+                                         uint32_t layerMask = ~(NodeLayer::Environment | NodeLayer::ViewModel)) const;
 
 private:
     std::shared_ptr<SceneNode> m_selectedNode;
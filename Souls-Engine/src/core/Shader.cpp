@@ -1,4 +1,7 @@
 #include "Shader.h"
+#include "FrameUniforms.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -15,7 +18,8 @@ Shader::~Shader() {
     }
 }
 
-bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
+bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath,
+                           const ShaderDefines& defines) {
     std::string vertexCode = ReadFile(vertexPath);
     std::string fragmentCode = ReadFile(fragmentPath);
     
@@ -24,25 +28,40 @@ bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fra
         return false;
     }
     
-    return LoadFromSource(vertexCode, fragmentCode);
+    return CompileAndLink(vertexCode, vertexPath, fragmentCode, fragmentPath, defines);
 }
 
-bool Shader::LoadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
+bool Shader::LoadFromSource(const std::string& vertexSource, const std::string& fragmentSource,
+                            const ShaderDefines& defines) {
+    return CompileAndLink(vertexSource, "", fragmentSource, "", defines);
+}
+
+bool Shader::CompileAndLink(const std::string& vertexSource, const std::string& vertexPath,
+                            const std::string& fragmentSource, const std::string& fragmentPath,
+                            const ShaderDefines& defines) {
+    // 展开 #include 并插入defines
+    std::string vertexCode, fragmentCode;
+    std::vector<std::string> vertexFiles, fragmentFiles;
+    if (!Preprocess(vertexSource, vertexPath, defines, vertexCode, vertexFiles)
+        || !Preprocess(fragmentSource, fragmentPath, defines, fragmentCode, fragmentFiles)) {
+        return false;
+    }
+
     // 编译顶点着色器
-    GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexCode, vertexFiles);
     if (vertexShader == 0) {
         return false;
     }
     
     // 编译片段着色器
-    GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentCode, fragmentFiles);
     if (fragmentShader == 0) {
         glDeleteShader(vertexShader);
         return false;
     }
     
     // 链接程序
-    bool success = LinkProgram(vertexShader, fragmentShader);
+    bool success = LinkProgram({ vertexShader, fragmentShader });
     
     // 删除着色器（已经链接到程序中，不再需要）
     glDeleteShader(vertexShader);
@@ -51,13 +70,104 @@ bool Shader::LoadFromSource(const std::string& vertexSource, const std::string&
     return success;
 }
 
+bool Shader::LoadComputeFromFile(const std::string& computePath) {
+    std::string computeCode = ReadFile(computePath);
+    if (computeCode.empty()) {
+        std::cerr << "Failed to read shader files" << std::endl;
+        return false;
+    }
+
+    return LoadComputeFromSource(computeCode);
+}
+
+bool Shader::LoadComputeFromSource(const std::string& computeSource) {
+    GLuint computeShader = CompileShader(GL_COMPUTE_SHADER, computeSource);
+    if (computeShader == 0) {
+        return false;
+    }
+
+    bool success = LinkProgram({ computeShader });
+    glDeleteShader(computeShader);
+    return success;
+}
+
 void Shader::Use() const {
     if (m_programID != 0) {
         glUseProgram(m_programID);
     }
 }
 
-GLuint Shader::CompileShader(GLenum type, const std::string& source) {
+bool Shader::Preprocess(const std::string& source, const std::string& path, const ShaderDefines& defines,
+                        std::string& output, std::vector<std::string>& sourceFiles) {
+    output.clear();
+    sourceFiles.assign(1, path.empty() ? std::string("<source>") : path);
+    return ExpandIncludes(source, 0, &defines, output, sourceFiles);
+}
+
+bool Shader::ExpandIncludes(const std::string& source, int fileIndex, const ShaderDefines* defines,
+                            std::string& output, std::vector<std::string>& sourceFiles) {
+    // 被包含的文件相对包含它的文件所在目录查找
+    const std::string& currentPath = sourceFiles[fileIndex];
+    const size_t slash = currentPath.find_last_of("/\\");
+    const std::string directory = slash == std::string::npos ? std::string() : currentPath.substr(0, slash + 1);
+
+    std::istringstream stream(source);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line)) {
+        ++lineNumber;
+        const size_t start = line.find_first_not_of(" \t");
+        const std::string directive = start == std::string::npos ? std::string() : line.substr(start);
+
+        if (defines && directive.compare(0, 8, "#version") == 0) {
+            // #version 必须是第一条语句，defines紧跟其后
+            output += line;
+            output += '\n';
+            for (const auto& define : *defines) {
+                output += "#define " + define.first + " " + define.second + "\n";
+            }
+            if (!defines->empty()) {
+                output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+            }
+            continue;
+        }
+
+        if (directive.compare(0, 8, "#include") != 0) {
+            output += line;
+            output += '\n';
+            continue;
+        }
+
+        const size_t open = directive.find('"');
+        const size_t close = open == std::string::npos ? std::string::npos : directive.find('"', open + 1);
+        if (close == std::string::npos || close == open + 1) {
+            std::cerr << "ERROR::SHADER::PREPROCESS: malformed #include in " << sourceFiles[fileIndex]
+                      << " line " << lineNumber << std::endl;
+            return false;
+        }
+
+        // 每个文件只展开一次（同时避免循环包含）
+        const std::string includePath = directory + directive.substr(open + 1, close - open - 1);
+        if (std::find(sourceFiles.begin(), sourceFiles.end(), includePath) == sourceFiles.end()) {
+            std::string includeSource = ReadFile(includePath);
+            if (includeSource.empty()) {
+                std::cerr << "ERROR::SHADER::PREPROCESS: failed to include " << includePath
+                          << " from " << sourceFiles[fileIndex] << std::endl;
+                return false;
+            }
+            const int includeIndex = static_cast<int>(sourceFiles.size());
+            sourceFiles.push_back(includePath);
+            output += "#line 1 " + std::to_string(includeIndex) + "\n";
+            if (!ExpandIncludes(includeSource, includeIndex, nullptr, output, sourceFiles)) {
+                return false;
+            }
+        }
+        output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+    }
+    return true;
+}
+
+GLuint Shader::CompileShader(GLenum type, const std::string& source, const std::vector<std::string>& sourceFiles) {
     GLuint shader = glCreateShader(type);
     if (shader == 0) {
         std::cerr << "Failed to create shader" << std::endl;
@@ -74,8 +184,17 @@ GLuint Shader::CompileShader(GLenum type, const std::string& source) {
     if (!success) {
         GLchar infoLog[512];
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        const char* shaderType = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
+        const char* shaderType = (type == GL_VERTEX_SHADER) ? "VERTEX"
+                               : (type == GL_COMPUTE_SHADER) ? "COMPUTE" : "FRAGMENT";
         std::cerr << "ERROR::SHADER::" << shaderType << "::COMPILATION_FAILED\n" << infoLog << std::endl;
+        if (sourceFiles.size() > 1) {
+            // 报错行号的格式为 "源字符串编号:行号"，编号对应展开的文件
+            std::cerr << "Source strings:";
+            for (size_t i = 0; i < sourceFiles.size(); ++i) {
+                std::cerr << " " << i << " = " << sourceFiles[i];
+            }
+            std::cerr << std::endl;
+        }
         glDeleteShader(shader);
         return 0;
     }
@@ -83,15 +202,16 @@ GLuint Shader::CompileShader(GLenum type, const std::string& source) {
     return shader;
 }
 
-bool Shader::LinkProgram(GLuint vertexShader, GLuint fragmentShader) {
+bool Shader::LinkProgram(std::initializer_list<GLuint> shaders) {
     m_programID = glCreateProgram();
     if (m_programID == 0) {
         std::cerr << "Failed to create shader program" << std::endl;
         return false;
     }
     
-    glAttachShader(m_programID, vertexShader);
-    glAttachShader(m_programID, fragmentShader);
+    for (GLuint shader : shaders) {
+        glAttachShader(m_programID, shader);
+    }
     glLinkProgram(m_programID);
     
     // 检查链接错误
@@ -105,6 +225,11 @@ bool Shader::LinkProgram(GLuint vertexShader, GLuint fragmentShader) {
         m_programID = 0;
         return false;
     }
+
+    // 共享的每帧uniform块绑定到固定绑定点
+    FrameUniforms::BindProgramBlocks(m_programID);
+
+    ReflectUniforms();
     
     return true;
 }
@@ -127,20 +252,110 @@ std::string Shader::ReadFile(const std::string& filepath) {
     }
 }
 
+void Shader::ReflectUniforms() {
+    m_uniforms.clear();
+    m_uniformIndices.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<GLchar> nameBuffer(static_cast<size_t>(std::max(maxLength, 1)));
+
+    auto addUniform = [this](const std::string& name, GLint location, GLenum type) {
+        m_uniformIndices.emplace(name, m_uniforms.size());
+        m_uniforms.push_back({ name, location, type });
+    };
+
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_programID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                           &length, &size, &type, nameBuffer.data());
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+
+        // 数组报告为 "name[0]"，每个元素单独查询位置
+        const bool isArray = name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0;
+        const std::string baseName = isArray ? name.substr(0, name.size() - 3) : name;
+        const GLint elementCount = isArray ? size : 1;
+
+        for (GLint element = 0; element < elementCount; ++element) {
+            std::string elementName = isArray ? baseName + "[" + std::to_string(element) + "]" : name;
+            GLint location = glGetUniformLocation(m_programID, elementName.c_str());
+            if (location < 0) {
+                continue;  // uniform块中的成员没有位置
+            }
+            addUniform(elementName, location, type);
+            if (isArray && element == 0) {
+                addUniform(baseName, location, type);
+            }
+        }
+    }
+}
+
 GLint Shader::GetUniformLocation(const std::string& name) const {
-    // 检查缓存
-    auto it = m_uniformLocationCache.find(name);
-    if (it != m_uniformLocationCache.end()) {
-        return it->second;
+    auto it = m_uniformIndices.find(name);
+    return it != m_uniformIndices.end() ? m_uniforms[it->second].location : -1;
+}
+
+GLint Shader::ResolveUniform(const std::string& name, GLenum expectedType) const {
+    auto it = m_uniformIndices.find(name);
+    if (it == m_uniformIndices.end()) {
+        return -1;
     }
-    
-    // 获取位置并缓存
-    GLint location = glGetUniformLocation(m_programID, name.c_str());
-    if (location == -1) {
-        std::cerr << "Warning: Uniform '" << name << "' doesn't exist!" << std::endl;
+
+    const UniformInfo& uniform = m_uniforms[it->second];
+    bool compatible = uniform.type == expectedType;
+    if (expectedType == GL_INT) {
+        // 采样器和bool也通过glUniform1i设置
+        compatible = compatible || uniform.type == GL_BOOL
+            || uniform.type == GL_SAMPLER_2D || uniform.type == GL_SAMPLER_2D_SHADOW
+            || uniform.type == GL_SAMPLER_2D_ARRAY_SHADOW
+            || uniform.type == GL_SAMPLER_BUFFER || uniform.type == GL_UNSIGNED_INT_SAMPLER_BUFFER;
+    }
+    if (!compatible) {
+        std::cerr << "Warning: Uniform '" << name << "' type mismatch (GLSL type 0x" << std::hex << uniform.type
+                  << ", requested 0x" << expectedType << std::dec << ")" << std::endl;
+        return -1;
+    }
+    return uniform.location;
+}
+
+void Shader::Set(UniformHandle<bool> handle, bool value) const {
+    if (handle.location >= 0) {
+        glUniform1i(handle.location, static_cast<int>(value));
+    }
+}
+
+void Shader::Set(UniformHandle<int> handle, int value) const {
+    if (handle.location >= 0) {
+        glUniform1i(handle.location, value);
+    }
+}
+
+void Shader::Set(UniformHandle<float> handle, float value) const {
+    if (handle.location >= 0) {
+        glUniform1f(handle.location, value);
+    }
+}
+
+void Shader::Set(UniformHandle<glm::vec3> handle, const glm::vec3& value) const {
+    if (handle.location >= 0) {
+        glUniform3f(handle.location, value.x, value.y, value.z);
+    }
+}
+
+void Shader::Set(UniformHandle<glm::vec4> handle, const glm::vec4& value) const {
+    if (handle.location >= 0) {
+        glUniform4f(handle.location, value.x, value.y, value.z, value.w);
+    }
+}
+
+void Shader::Set(UniformHandle<glm::mat4> handle, const glm::mat4& value) const {
+    if (handle.location >= 0) {
+        glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
     }
-    m_uniformLocationCache[name] = location;
-    return location;
 }
 
 void Shader::SetBool(const std::string& name, bool value) const {
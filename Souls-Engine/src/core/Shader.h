@@ -1,11 +1,34 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <initializer_list>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace SoulsEngine {
 
+// 编译期特性宏：每一项在 #version 之后插入为 "#define 名字 值"（值可以为空）
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+// Uniform句柄 - 按名字解析一次后用于设置uniform，避免每次设置时按字符串查找
+// 模板参数是C++侧的值类型，解析时与链接后反射得到的GLSL类型核对
+template <typename T>
+struct UniformHandle {
+    GLint location = -1;
+
+    bool IsValid() const { return location >= 0; }
+};
+
+// 链接后通过glGetActiveUniform反射得到的uniform（uniform块中的成员不包含在内）
+struct UniformInfo {
+    std::string name;   // 数组元素分别记录为 name[i]，name 本身指向第0个元素
+    GLint location;
+    GLenum type;        // GL_FLOAT_VEC3 等
+};
+
 // Shader 程序管理类
 class Shader {
 public:
@@ -17,10 +40,17 @@ public:
     Shader& operator=(const Shader&) = delete;
 
     // 从文件加载并编译Shader
-    bool LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
+    // 源文件中的 #include "文件" 相对包含它的文件展开（每个文件只展开一次），defines插入到 #version 之后
+    bool LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath,
+                       const ShaderDefines& defines = {});
     
-    // 从源代码编译Shader
-    bool LoadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
+    // 从源代码编译Shader（#include 相对当前工作目录展开）
+    bool LoadFromSource(const std::string& vertexSource, const std::string& fragmentSource,
+                        const ShaderDefines& defines = {});
+
+    // 加载计算着色器程序（需要GL 4.3上下文）
+    bool LoadComputeFromFile(const std::string& computePath);
+    bool LoadComputeFromSource(const std::string& computeSource);
 
     // 使用Shader程序
     void Use() const;
@@ -28,7 +58,7 @@ public:
     // 获取Shader程序ID
     GLuint GetProgramID() const { return m_programID; }
 
-    // 设置Uniform变量
+    // 设置Uniform变量（按名字查找，程序中不存在的uniform被忽略）
     void SetBool(const std::string& name, bool value) const;
     void SetInt(const std::string& name, int value) const;
     void SetFloat(const std::string& name, float value) const;
@@ -36,22 +66,80 @@ public:
     void SetVec4(const std::string& name, float x, float y, float z, float w) const;
     void SetMat4(const std::string& name, const float* value) const;
 
+    // 获取Uniform位置（从反射表查找，不存在时返回-1）
+    GLint GetUniformLocation(const std::string& name) const;
+
+    // 程序中是否有该uniform（被编译器优化掉的uniform视为不存在）
+    bool HasUniform(const std::string& name) const { return m_uniformIndices.count(name) > 0; }
+
+    // 链接时反射得到的所有uniform
+    const std::vector<UniformInfo>& GetActiveUniforms() const { return m_uniforms; }
+
+    // 解析uniform句柄：不存在时返回无效句柄（设置时被忽略），类型不匹配时报错并返回无效句柄
+    template <typename T>
+    UniformHandle<T> GetUniformHandle(const std::string& name) const;
+
+    // 通过句柄设置Uniform变量（调用方需已Use该程序；无效句柄被忽略）
+    void Set(UniformHandle<bool> handle, bool value) const;
+    void Set(UniformHandle<int> handle, int value) const;
+    void Set(UniformHandle<float> handle, float value) const;
+    void Set(UniformHandle<glm::vec3> handle, const glm::vec3& value) const;
+    void Set(UniformHandle<glm::vec4> handle, const glm::vec4& value) const;
+    void Set(UniformHandle<glm::mat4> handle, const glm::mat4& value) const;
+
 private:
     GLuint m_programID;
-    mutable std::unordered_map<std::string, GLint> m_uniformLocationCache;
+    std::vector<UniformInfo> m_uniforms;
+    std::unordered_map<std::string, size_t> m_uniformIndices;  // 名字 -> m_uniforms下标
+
+    // 链接成功后枚举程序中的uniform
+    void ReflectUniforms();
+
+    // 按名字和期望的GLSL类型查找位置（GetUniformHandle的实现）
+    GLint ResolveUniform(const std::string& name, GLenum expectedType) const;
+
+    // 预处理：展开 #include 并插入defines，用 #line 保持报错的行号（源字符串编号是sourceFiles的下标）
+    bool Preprocess(const std::string& source, const std::string& path, const ShaderDefines& defines,
+                    std::string& output, std::vector<std::string>& sourceFiles);
+
+    // 把source中的 #include 递归展开到output，fileIndex是source在sourceFiles中的下标
+    // （只处理顶层文件时defines非空；#include 不受 #if 等条件编译影响，总是展开）
+    bool ExpandIncludes(const std::string& source, int fileIndex, const ShaderDefines* defines,
+                        std::string& output, std::vector<std::string>& sourceFiles);
 
-    // 编译单个Shader
-    GLuint CompileShader(GLenum type, const std::string& source);
+    // 预处理并编译链接顶点+片段程序（路径为空表示源代码不来自文件）
+    bool CompileAndLink(const std::string& vertexSource, const std::string& vertexPath,
+                        const std::string& fragmentSource, const std::string& fragmentPath,
+                        const ShaderDefines& defines);
+
+    // 编译单个Shader（sourceFiles用于在错误信息中说明源字符串编号对应的文件）
+    GLuint CompileShader(GLenum type, const std::string& source,
+                         const std::vector<std::string>& sourceFiles = {});
     
-    // 链接Shader程序
-    bool LinkProgram(GLuint vertexShader, GLuint fragmentShader);
+    // 链接Shader程序（顶点+片段，或单个计算着色器）
+    bool LinkProgram(std::initializer_list<GLuint> shaders);
     
     // 从文件读取内容
     std::string ReadFile(const std::string& filepath);
-    
-    // 获取Uniform位置（带缓存）
-    GLint GetUniformLocation(const std::string& name) const;
 };
 
+namespace detail {
+    // C++值类型对应的GLSL类型（int同时匹配采样器，见Shader::ResolveUniform）
+    template <typename T> struct UniformType;
+    template <> struct UniformType<bool> { static constexpr GLenum value = GL_BOOL; };
+    template <> struct UniformType<int> { static constexpr GLenum value = GL_INT; };
+    template <> struct UniformType<float> { static constexpr GLenum value = GL_FLOAT; };
+    template <> struct UniformType<glm::vec3> { static constexpr GLenum value = GL_FLOAT_VEC3; };
+    template <> struct UniformType<glm::vec4> { static constexpr GLenum value = GL_FLOAT_VEC4; };
+    template <> struct UniformType<glm::mat4> { static constexpr GLenum value = GL_FLOAT_MAT4; };
+}
+
+template <typename T>
+UniformHandle<T> Shader::GetUniformHandle(const std::string& name) const {
+    UniformHandle<T> handle;
+    handle.location = ResolveUniform(name, detail::UniformType<T>::value);
+    return handle;
+}
+
 } // namespace SoulsEngine
 
@@ -0,0 +1,54 @@
+#include "ShaderVariants.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace SoulsEngine {
+
+ShaderVariants::ShaderVariants(std::string vertexPath, std::string fragmentPath)
+    : m_vertexPath(std::move(vertexPath)), m_fragmentPath(std::move(fragmentPath)) {
+}
+
+std::string ShaderVariants::MakeKey(const ShaderDefines& defines) {
+    ShaderDefines sorted = defines;
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string key;
+    for (const auto& define : sorted) {
+        if (!key.empty()) {
+            key += ';';
+        }
+        key += define.first + "=" + define.second;
+    }
+    return key;
+}
+
+Shader* ShaderVariants::Get(const ShaderDefines& defines) {
+    const std::string key = MakeKey(defines);
+    auto it = m_variants.find(key);
+    if (it != m_variants.end()) {
+        return it->second.get();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto shader = std::make_unique<Shader>();
+    const bool loaded = shader->LoadFromFiles(m_vertexPath, m_fragmentPath, defines);
+    m_stats.compileMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (!loaded) {
+        std::cerr << "ERROR::SHADER::VARIANT: failed to build " << m_fragmentPath
+                  << " with defines \"" << key << "\"" << std::endl;
+        m_stats.failures++;
+        shader.reset();
+    } else {
+        m_stats.variants++;
+    }
+    return m_variants.emplace(key, std::move(shader)).first->second.get();
+}
+
+void ShaderVariants::Clear() {
+    m_variants.clear();
+    m_stats = ShaderVariantStats();
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Shader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace SoulsEngine {
+
+// 着色器变体统计
+struct ShaderVariantStats {
+    uint32_t variants = 0;   // 已编译成功的变体
+    uint32_t failures = 0;   // 编译或链接失败的变体（失败结果同样缓存，不会每帧重试）
+    float compileMs = 0.0f;  // 累计编译时间
+};
+
+// 着色器变体缓存 - 同一对源文件按不同的编译期特性宏（ShaderDefines）编译出多个程序，第一次请求时编译
+//
+// 渲染器按需要的功能请求变体（例如不启用阴影时 SHADOWS=0，选中轮廓用 OUTLINE），
+// 关闭的功能连同分支和uniform一起在编译期去掉，片段着色器中不再有运行时判断
+// 键与defines的顺序无关；各变体是独立的程序，uniform位置和句柄要按变体分别解析
+class ShaderVariants {
+public:
+    ShaderVariants(std::string vertexPath, std::string fragmentPath);
+    ~ShaderVariants() = default;
+
+    // 禁止拷贝（持有着色器程序）
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+    // 获取变体，不存在时编译；编译失败时返回nullptr
+    Shader* Get(const ShaderDefines& defines = {});
+
+    // 删除所有变体（例如着色器文件修改后重新加载）
+    void Clear();
+
+    const ShaderVariantStats& GetStats() const { return m_stats; }
+
+    // defines排序后的键，例如 "LIGHT_COUNT=4;SHADOWS=0"
+    static std::string MakeKey(const ShaderDefines& defines);
+
+private:
+    std::string m_vertexPath;
+    std::string m_fragmentPath;
+    std::unordered_map<std::string, std::unique_ptr<Shader>> m_variants;  // 失败的变体保存为nullptr
+    ShaderVariantStats m_stats;
+};
+
+} // namespace SoulsEngine
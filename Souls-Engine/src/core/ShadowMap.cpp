@@ -1,106 +1,311 @@
 #include "ShadowMap.h"
+#include "ObjectManager.h"
+#include "RenderQueue.h"
+#include "Shader.h"
+#include "TransformSystem.h"
 #include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace SoulsEngine {
 
-ShadowMap::ShadowMap(unsigned int width, unsigned int height)
-    : m_width(width)
-    , m_height(height)
-    , m_depthMapFBO(0)
-    , m_depthTexture(0)
+ShadowMap::ShadowMap(const ShadowSettings& settings)
+    : m_settings(settings)
 {
+    m_settings.cascadeCount = std::min(std::max(m_settings.cascadeCount, 1), MaxCascades);
 }
 
 ShadowMap::~ShadowMap() {
-    if (m_depthMapFBO != 0) {
-        glDeleteFramebuffers(1, &m_depthMapFBO);
-        m_depthMapFBO = 0;
+    Shutdown();
+}
+
+namespace {
+    // 创建深度纹理数组（每个级联一层）
+    // compare为true时使用线性过滤+深度比较：每次采样由硬件完成2x2的PCF
+    GLuint CreateDepthArray(unsigned int resolution, int layers, bool compare) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, resolution, resolution, layers,
+                     0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+        const GLint filter = compare ? GL_LINEAR : GL_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        if (compare) {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        }
+
+        // 设置边界颜色（超出阴影贴图范围的地方不在阴影中）
+        float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return texture;
     }
-    if (m_depthTexture != 0) {
-        glDeleteTextures(1, &m_depthTexture);
-        m_depthTexture = 0;
+
+    // 创建只有深度附件的帧缓冲，挂接texture的第0层并检查完整性（调用方负责恢复绑定）
+    bool CreateDepthFramebuffer(GLuint texture, GLuint& framebuffer) {
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, 0);
+
+        // 不绘制颜色数据
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+
+        return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
     }
 }
 
 bool ShadowMap::Initialize() {
-    // 创建帧缓冲对象
-    glGenFramebuffers(1, &m_depthMapFBO);
-
-    // 创建深度纹理
-    glGenTextures(1, &m_depthTexture);
-    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, 
-                 m_width, m_height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    
-    // 设置边界颜色（超出阴影贴图范围的地方不在阴影中）
-    float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-
-    // 将深度纹理附加到帧缓冲
-    glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
-    
-    // 不绘制颜色数据
-    glDrawBuffer(GL_NONE);
-    glReadBuffer(GL_NONE);
-
-    // 检查帧缓冲完整性
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    Shutdown();
+
+    // 之后恢复调用方的帧缓冲
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    m_depthTexture = CreateDepthArray(m_settings.resolution, m_settings.cascadeCount, true);
+    bool complete = CreateDepthFramebuffer(m_depthTexture, m_depthMapFBO);
+    if (complete && m_settings.cacheStatic) {
+        m_staticTexture = CreateDepthArray(m_settings.resolution, m_settings.cascadeCount, false);
+        complete = CreateDepthFramebuffer(m_staticTexture, m_staticFBO);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    if (!complete) {
         std::cerr << "ERROR::SHADOWMAP:: Framebuffer is not complete!" << std::endl;
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        Shutdown();
         return false;
     }
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    InvalidateStaticCache();
     return true;
 }
 
-void ShadowMap::BeginRender() {
-    glViewport(0, 0, m_width, m_height);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
-    glClear(GL_DEPTH_BUFFER_BIT);
-    
-    // 启用正面剔除（只渲染背面，避免阴影痤疮）
-    glCullFace(GL_FRONT);
+void ShadowMap::Shutdown() {
+    for (GLuint* framebuffer : { &m_depthMapFBO, &m_staticFBO }) {
+        if (*framebuffer != 0) {
+            glDeleteFramebuffers(1, framebuffer);
+            *framebuffer = 0;
+        }
+    }
+    for (GLuint* texture : { &m_depthTexture, &m_staticTexture }) {
+        if (*texture != 0) {
+            glDeleteTextures(1, texture);
+            *texture = 0;
+        }
+    }
+}
+
+bool ShadowMap::SetSettings(const ShadowSettings& settings) {
+    ShadowSettings clamped = settings;
+    clamped.cascadeCount = std::min(std::max(clamped.cascadeCount, 1), MaxCascades);
+
+    bool recreate = clamped.cascadeCount != m_settings.cascadeCount || clamped.resolution != m_settings.resolution ||
+                    clamped.cacheStatic != m_settings.cacheStatic;
+    m_settings = clamped;
+    if (recreate && m_depthTexture != 0) {
+        return Initialize();
+    }
+    return true;
 }
 
-void ShadowMap::EndRender() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glCullFace(GL_BACK);  // 恢复背面剔除
-    
-    // 恢复视口（需要在调用处设置正确的视口大小）
+void ShadowMap::InvalidateStaticCache() {
+    for (Cascade& cascade : m_cascades) {
+        cascade.cacheValid = false;
+    }
 }
 
-glm::mat4 ShadowMap::GetLightSpaceMatrix(const glm::vec3& lightPos,
-                                          const glm::vec3& lightDir,
-                                          float nearPlane,
-                                          float farPlane,
-                                          float orthoSize) const {
-    // 计算光源的视图矩阵
-    // lightDir是光源方向（从光源指向目标），所以target = lightPos + lightDir
-    glm::vec3 lightTarget = lightPos + lightDir * 10.0f;  // 确保target在合理距离
-    
-    // 计算up向量（确保与lightDir不平行）
-    glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
-    if (abs(glm::dot(lightDir, up)) > 0.9f) {
+void ShadowMap::Update(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDirection,
+                       const BoundingBox& sceneBounds) {
+    const int cascadeCount = m_settings.cascadeCount;
+
+    // 从透视投影矩阵还原近/远平面和视锥体在深度1处的半宽/半高
+    const float nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+    const float farPlane = std::min(projection[3][2] / (projection[2][2] + 1.0f), m_settings.maxDistance);
+    const float halfWidth = 1.0f / projection[0][0];
+    const float halfHeight = 1.0f / projection[1][1];
+    const glm::mat4 inverseView = glm::inverse(view);
+
+    // 光源视图只包含旋转（原点在世界原点），纹素对齐在这个空间中进行
+    m_lightDirection = glm::normalize(lightDirection);
+    glm::vec3 up(0.0f, 1.0f, 0.0f);
+    if (std::abs(glm::dot(m_lightDirection, up)) > 0.9f) {
         // 如果lightDir几乎与up平行，使用另一个up向量
         up = glm::vec3(0.0f, 0.0f, 1.0f);
     }
-    
-    glm::mat4 lightView = glm::lookAt(lightPos, lightTarget, up);
-    
-    // 正交投影矩阵（适合方向光）
-    // 使用更大的正交投影范围以覆盖整个场景
-    glm::mat4 lightProjection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, nearPlane, farPlane);
-    
-    // 光源空间矩阵 = 投影矩阵 * 视图矩阵
-    return lightProjection * lightView;
+    m_lightView = glm::lookAt(glm::vec3(0.0f), m_lightDirection, up);
+
+    // 场景包围盒在光源空间中最靠近光源的位置（光源视图朝-Z方向看，z越大越靠近光源）
+    float sceneNearZ = -FLT_MAX;
+    if (sceneBounds.IsValid()) {
+        BoundingBox lightSpaceBounds = sceneBounds.Transform(m_lightView);
+        sceneNearZ = lightSpaceBounds.center.z + lightSpaceBounds.extents.z;
+    }
+
+    float splitNear = nearPlane;
+    for (int i = 0; i < cascadeCount; ++i) {
+        // 对数切分与均匀切分的混合
+        float ratio = static_cast<float>(i + 1) / static_cast<float>(cascadeCount);
+        float logSplit = nearPlane * std::pow(farPlane / nearPlane, ratio);
+        float uniformSplit = nearPlane + (farPlane - nearPlane) * ratio;
+        float splitFar = m_settings.splitLambda * logSplit + (1.0f - m_settings.splitLambda) * uniformSplit;
+
+        // 该段视锥体的8个角（世界空间）
+        glm::vec3 corners[8];
+        glm::vec3 center(0.0f);
+        for (int c = 0; c < 8; ++c) {
+            float depth = (c & 4) ? splitFar : splitNear;
+            glm::vec4 viewCorner((c & 1 ? 1.0f : -1.0f) * halfWidth * depth,
+                                 (c & 2 ? 1.0f : -1.0f) * halfHeight * depth, -depth, 1.0f);
+            corners[c] = glm::vec3(inverseView * viewCorner);
+            center += corners[c];
+        }
+        center /= 8.0f;
+
+        // 包围球半径只取决于切分距离和投影，向上取整到1/16消除浮点抖动
+        float radius = 0.0f;
+        for (const glm::vec3& corner : corners) {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        // 球心在光源空间按纹素对齐
+        // 启用缓存时按resolution/16个纹素（投影半宽的1/8）对齐，半宽放大到8/7倍，对齐偏移后仍能包含整个包围球
+        Cascade& cascade = m_cascades[i];
+        const float halfSize = m_settings.cacheStatic ? radius * 8.0f / 7.0f : radius;
+        cascade.texelSize = 2.0f * halfSize / static_cast<float>(m_settings.resolution);
+        const float snap = m_settings.cacheStatic ? halfSize / 8.0f : cascade.texelSize;
+        glm::vec3 lightCenter = glm::vec3(m_lightView * glm::vec4(center, 1.0f));
+        lightCenter.x = std::floor(lightCenter.x / snap) * snap;
+        lightCenter.y = std::floor(lightCenter.y / snap) * snap;
+
+        // 深度范围：远端到包围球为止，近端扩展到场景中最靠近光源的物体
+        // 启用缓存时深度方向同样对齐，场景的近端向光源方向取整，动态物体的小幅移动不会改变级联矩阵
+        float nearZ = std::max(lightCenter.z + radius, sceneNearZ);
+        if (m_settings.cacheStatic) {
+            lightCenter.z = std::floor(lightCenter.z / snap) * snap;
+            nearZ = std::max(lightCenter.z + halfSize, std::ceil(sceneNearZ / snap) * snap);
+        }
+        float farZ = lightCenter.z - halfSize;
+        glm::mat4 lightProjection = glm::ortho(lightCenter.x - halfSize, lightCenter.x + halfSize,
+                                               lightCenter.y - halfSize, lightCenter.y + halfSize,
+                                               -nearZ, -farZ);
+
+        cascade.viewProjection = lightProjection * m_lightView;
+        cascade.splitDistance = splitFar;
+        splitNear = splitFar;
+    }
 }
 
-} // namespace SoulsEngine
+void ShadowMap::RenderCascades(ObjectManager& objects, const Shader& depthShader, RenderQueue& queue, uint32_t layerMask) {
+    if (m_depthMapFBO == 0) return;
+
+    // 保存调用方的帧缓冲和视口
+    GLint previousFramebuffer = 0;
+    GLint previousViewport[4] = { 0, 0, 0, 0 };
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    glViewport(0, 0, m_settings.resolution, m_settings.resolution);
+
+    // 深度偏移（按斜率和最小可分辨深度）避免阴影痤疮；不剔除背面，单面的圆盘等物体也能投射阴影
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+
+    const bool cacheStatic = m_settings.cacheStatic && m_staticFBO != 0;
+    const uint64_t staticSignature = cacheStatic ? ComputeStaticSignature(objects, layerMask) : 0;
+    const GLint size = static_cast<GLint>(m_settings.resolution);
+
+    for (int i = 0; i < m_settings.cascadeCount; ++i) {
+        Cascade& cascade = m_cascades[i];
+        cascade.cacheRebuilt = false;
+
+        if (!cacheStatic) {
+            glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture, 0, i);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            cascade.stats = DrawCasters(objects, depthShader, queue, cascade, layerMask, CasterFilter::All);
+            continue;
+        }
+
+        // 级联矩阵或静态物体变化时重新绘制静态缓存
+        glBindFramebuffer(GL_FRAMEBUFFER, m_staticFBO);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_staticTexture, 0, i);
+        if (!cascade.cacheValid || cascade.cachedSignature != staticSignature ||
+            cascade.cachedViewProjection != cascade.viewProjection) {
+            glClear(GL_DEPTH_BUFFER_BIT);
+            cascade.staticStats = DrawCasters(objects, depthShader, queue, cascade, layerMask, CasterFilter::Static);
+            cascade.cachedViewProjection = cascade.viewProjection;
+            cascade.cachedSignature = staticSignature;
+            cascade.cacheValid = true;
+            cascade.cacheRebuilt = true;
+        }
+
+        // 拷贝缓存的深度，再在上面绘制动态物体
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_depthMapFBO);
+        glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture, 0, i);
+        glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
+        cascade.stats = DrawCasters(objects, depthShader, queue, cascade, layerMask, CasterFilter::Dynamic);
+    }
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+}
+
+CullingStats ShadowMap::DrawCasters(ObjectManager& objects, const Shader& depthShader, RenderQueue& queue,
+                                    const Cascade& cascade, uint32_t layerMask, CasterFilter filter) const {
+    depthShader.Use();
+    depthShader.Set(depthShader.GetUniformHandle<glm::mat4>("lightSpaceMatrix"), cascade.viewProjection);
+
+    // 每个级联只绘制与它的正交视锥体相交的物体
+    ViewFrustum frustum(cascade.viewProjection);
+    queue.Begin(m_lightView);
+    uint32_t drawn = 0;
+    CullingStats stats = objects.ForEachVisibleRenderable(frustum, [&queue, &drawn, filter](SceneNode& node) {
+        if (filter == CasterFilter::All || node.IsStatic() == (filter == CasterFilter::Static)) {
+            queue.Submit(node);
+            drawn++;
+        }
+    }, layerMask);
+    queue.Execute(depthShader);
+
+    // 可见数只统计实际绘制的节点
+    stats.visible = drawn;
+    return stats;
+}
 
+uint64_t ShadowMap::ComputeStaticSignature(ObjectManager& objects, uint32_t layerMask) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto combine = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    TransformSystem& transforms = TransformSystem::Get();
+    objects.ForEachRenderable([&](SceneNode& node) {
+        if (!node.IsStatic()) return;
+        const Mesh* mesh = node.GetMesh().get();
+        BoundingBox bounds = transforms.GetWorldBounds(node.GetTransformId());
+        combine(&mesh, sizeof(mesh));
+        combine(&bounds.center, sizeof(bounds.center));
+        combine(&bounds.extents, sizeof(bounds.extents));
+    }, layerMask);
+    return hash;
+}
+
+void ShadowMap::BindTexture() const {
+    glActiveTexture(GL_TEXTURE0 + TextureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_depthTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+} // namespace SoulsEngine
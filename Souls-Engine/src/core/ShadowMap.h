@@ -1,57 +1,133 @@
 #pragma once
 
+#include "SceneNode.h"
+#include "ViewFrustum.h"
+#include "../geometry/Bounds.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
+#include <cstdint>
 
 namespace SoulsEngine {
 
-// 阴影映射类 - 管理阴影贴图的生成和使用
+// 前向声明
+class ObjectManager;
+class RenderQueue;
+class Shader;
+
+// 阴影质量设置：级联数量和分辨率是主要的质量/性能开关
+struct ShadowSettings {
+    int cascadeCount = 3;             // 级联数量（1 - ShadowMap::MaxCascades）
+    unsigned int resolution = 2048;   // 每个级联的阴影贴图边长
+    float maxDistance = 60.0f;        // 阴影覆盖的最远视图距离（不超过相机远平面）
+    float splitLambda = 0.75f;        // 切分方式：0为均匀切分，1为对数切分，之间线性混合
+    bool cacheStatic = true;          // 缓存静态物体的深度（级联按更粗的网格对齐，有效分辨率降低1/8）
+};
+
+// 级联阴影贴图（方向光）- 把相机视锥体按距离切分成若干段，每段用一张正交投影的阴影贴图覆盖，
+// 所有级联存放在一个深度纹理数组中，片段着色器按视图空间深度选择级联（sampler2DArrayShadow，硬件比较+PCF）
+//
+// 每个级联用包含该段视锥体的包围球拟合，正交投影的大小只取决于包围球半径（相机旋转时不变），
+// 投影中心在光源空间按纹素大小对齐，因此相机移动时阴影边缘不会闪烁。
+// 光源方向上的深度范围扩展到整个场景包围盒，级联外的物体也能投射阴影
+//
+// 静态物体缓存（ShadowSettings::cacheStatic）：SceneNode::SetStatic标记的物体单独绘制到缓存纹理数组，
+// 每帧把缓存的深度拷贝（glBlitFramebuffer）到阴影贴图后只绘制动态物体。
+// 级联矩阵、光源方向或静态物体（网格、世界包围盒）变化时才重新绘制缓存。
+// 为了让相机移动时级联矩阵不必每帧变化，启用缓存时投影中心按resolution/16个纹素的网格对齐，
+// 正交投影相应放大1/7覆盖对齐造成的偏移
+//
+// 一帧的流程：
+//   Update          由相机矩阵、光源方向和场景包围盒拟合各级联
+//   RenderCascades  深度通道：每个级联用自己的正交视锥体剔除后通过渲染队列绘制（depth.vert / depth.frag）
+//   FrameUniforms::SetShadows + BindTexture   主通道采样
 class ShadowMap {
 public:
-    ShadowMap(unsigned int width = 2048, unsigned int height = 2048);
+    static constexpr int MaxCascades = 4;
+
+    // 阴影贴图使用的纹理单元（FrameUniforms::BindProgramBlocks把shadowMap采样器绑定到这里）
+    static constexpr GLuint TextureUnit = 4;
+
+    explicit ShadowMap(const ShadowSettings& settings = ShadowSettings());
     ~ShadowMap();
 
     // 禁止拷贝
     ShadowMap(const ShadowMap&) = delete;
     ShadowMap& operator=(const ShadowMap&) = delete;
 
-    // 初始化阴影贴图
+    // 按当前设置创建深度纹理数组和帧缓冲（需要有效的OpenGL上下文）
     bool Initialize();
+    void Shutdown();
 
-    // 开始渲染到阴影贴图
-    void BeginRender();
-
-    // 结束渲染到阴影贴图
-    void EndRender();
-
-    // 获取深度纹理ID
-    GLuint GetDepthTexture() const { return m_depthTexture; }
-
-    // 获取阴影贴图尺寸
-    unsigned int GetWidth() const { return m_width; }
-    unsigned int GetHeight() const { return m_height; }
+    // 修改设置，级联数量、分辨率或缓存开关变化时重新创建纹理
+    bool SetSettings(const ShadowSettings& settings);
+    const ShadowSettings& GetSettings() const { return m_settings; }
 
-    // 计算光源空间矩阵（从光源视角的视图投影矩阵）
-    glm::mat4 GetLightSpaceMatrix(const glm::vec3& lightPos, 
-                                   const glm::vec3& lightDir,
-                                   float nearPlane = 0.1f,
-                                   float farPlane = 100.0f,
-                                   float orthoSize = 20.0f) const;
+    // 下一次RenderCascades时重新绘制所有级联的静态缓存
+    void InvalidateStaticCache();
 
-private:
-    unsigned int m_width;
-    unsigned int m_height;
-    GLuint m_depthMapFBO;      // 帧缓冲对象
-    GLuint m_depthTexture;     // 深度纹理
-};
-
-} // namespace SoulsEngine
+    // 拟合各级联
+    // view/projection为相机矩阵（对称透视投影），lightDirection为光线传播方向（从光源指向场景），
+    // sceneBounds为所有投影物体的世界包围盒（无效时深度范围只覆盖级联本身）
+    void Update(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDirection,
+                const BoundingBox& sceneBounds);
 
+    // 深度通道：依次渲染所有级联，结束后恢复之前的帧缓冲和视口
+    // 只绘制属于layerMask中任一层的节点
+    void RenderCascades(ObjectManager& objects, const Shader& depthShader, RenderQueue& queue,
+                        uint32_t layerMask = ~NodeLayer::ViewModel);
 
+    // 把深度纹理数组绑定到TextureUnit
+    void BindTexture() const;
 
+    // 级联数据（Update之后有效）
+    int GetCascadeCount() const { return m_settings.cascadeCount; }
+    const glm::mat4& GetCascadeMatrix(int cascade) const { return m_cascades[cascade].viewProjection; }
+    float GetCascadeSplit(int cascade) const { return m_cascades[cascade].splitDistance; }
+    float GetCascadeTexelSize(int cascade) const { return m_cascades[cascade].texelSize; }
+    const glm::vec3& GetLightDirection() const { return m_lightDirection; }
 
+    // 上一次RenderCascades中每个级联的剔除统计（启用缓存时只包含动态物体）
+    const CullingStats& GetCascadeStats(int cascade) const { return m_cascades[cascade].stats; }
 
+    // 静态缓存最近一次重建时的剔除统计，以及上一次RenderCascades是否重建了该级联的缓存
+    const CullingStats& GetCascadeStaticStats(int cascade) const { return m_cascades[cascade].staticStats; }
+    bool IsCascadeCacheRebuilt(int cascade) const { return m_cascades[cascade].cacheRebuilt; }
 
+    GLuint GetDepthTexture() const { return m_depthTexture; }
+    unsigned int GetResolution() const { return m_settings.resolution; }
 
+private:
+    struct Cascade {
+        glm::mat4 viewProjection = glm::mat4(1.0f);  // 光源空间正交投影 * 光源视图
+        float splitDistance = 0.0f;                  // 该级联覆盖的最远视图距离
+        float texelSize = 0.0f;                      // 一个纹素对应的世界空间尺寸
+        CullingStats stats;
+
+        // 静态缓存
+        CullingStats staticStats;
+        glm::mat4 cachedViewProjection = glm::mat4(1.0f);  // 缓存绘制时的级联矩阵
+        uint64_t cachedSignature = 0;                      // 缓存绘制时的静态物体签名
+        bool cacheValid = false;
+        bool cacheRebuilt = false;
+    };
+
+    // 把一个级联中属于layerMask、按filter筛选的节点绘制到当前帧缓冲，返回剔除统计
+    enum class CasterFilter { All, Static, Dynamic };
+    CullingStats DrawCasters(ObjectManager& objects, const Shader& depthShader, RenderQueue& queue,
+                             const Cascade& cascade, uint32_t layerMask, CasterFilter filter) const;
+
+    // 静态物体的签名（网格和世界包围盒的哈希），用于发现静态物体的变化
+    static uint64_t ComputeStaticSignature(ObjectManager& objects, uint32_t layerMask);
+
+    ShadowSettings m_settings;
+    Cascade m_cascades[MaxCascades];
+    glm::mat4 m_lightView = glm::mat4(1.0f);
+    glm::vec3 m_lightDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+
+    GLuint m_depthMapFBO = 0;      // 帧缓冲对象（每个级联渲染前挂接纹理数组的对应层）
+    GLuint m_depthTexture = 0;     // 深度纹理数组
+    GLuint m_staticFBO = 0;        // 静态缓存的帧缓冲对象
+    GLuint m_staticTexture = 0;    // 静态缓存的深度纹理数组（只在cacheStatic时创建）
+};
 
+} // namespace SoulsEngine
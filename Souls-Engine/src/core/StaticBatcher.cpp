@@ -0,0 +1,208 @@
+#include "StaticBatcher.h"
+#include "JobSystem.h"
+#include "Material.h"
+#include "ObjectManager.h"
+#include "RenderQueue.h"
+#include "TransformSystem.h"
+#include "ViewFrustum.h"
+#include "../geometry/Mesh.h"
+#include <cstring>
+#include <unordered_map>
+
+namespace SoulsEngine {
+
+namespace {
+    // 合并后的世界空间网格
+    class BatchMesh : public Mesh {
+    public:
+        BatchMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices) {
+            SetupMesh(vertices, indices);
+        }
+    };
+
+    // 材质分组的键：参数完全相同的材质合并到同一组（不同的Material对象也可以）
+    struct MaterialKey {
+        float values[10] = {};  // ambient, diffuse, specular, 光泽度
+        bool hasMaterial = false;
+
+        explicit MaterialKey(const Material* material) {
+            if (!material) return;
+            hasMaterial = true;
+            const glm::vec3 ambient = material->GetAmbient();
+            const glm::vec3 diffuse = material->GetDiffuse();
+            const glm::vec3 specular = material->GetSpecular();
+            std::memcpy(values, &ambient, sizeof(ambient));
+            std::memcpy(values + 3, &diffuse, sizeof(diffuse));
+            std::memcpy(values + 6, &specular, sizeof(specular));
+            values[9] = material->GetShininess();
+        }
+
+        bool operator==(const MaterialKey& other) const {
+            return hasMaterial == other.hasMaterial && std::memcmp(values, other.values, sizeof(values)) == 0;
+        }
+    };
+
+    // 源网格读回的数据（同一网格被多个节点使用时只读一次）
+    struct SourceGeometry {
+        std::vector<MeshVertex> vertices;
+        std::vector<uint32_t> indices;
+        bool read = false;
+        bool valid = false;
+    };
+}
+
+bool StaticBatcher::IsBatchable(const SceneNode& node) {
+    if (!node.IsStatic() || !node.GetMesh() || node.GetMeshLOD()) {
+        return false;
+    }
+    const Material* material = node.GetMaterial().get();
+    return !material || material->GetAlpha() >= 1.0f;
+}
+
+uint64_t StaticBatcher::ComputeSignature(ObjectManager& objects, uint32_t layerMask) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto combine = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    TransformSystem& transforms = TransformSystem::Get();
+    objects.ForEachRenderable([&](SceneNode& node) {
+        if (!IsBatchable(node)) return;
+        const Mesh* mesh = node.GetMesh().get();
+        const glm::mat4& world = transforms.GetWorldMatrix(node.GetTransformId());
+        const MaterialKey key(node.GetMaterial().get());
+        combine(&mesh, sizeof(mesh));
+        combine(&world, sizeof(world));
+        combine(key.values, sizeof(key.values));
+        combine(&key.hasMaterial, sizeof(key.hasMaterial));
+    }, layerMask);
+    combine(&layerMask, sizeof(layerMask));
+    return hash;
+}
+
+bool StaticBatcher::Update(ObjectManager& objects, uint32_t layerMask) {
+    TransformSystem::Get().UpdateWorldTransforms(&JobSystem::Get());
+
+    const uint64_t signature = ComputeSignature(objects, layerMask);
+    if (m_built && signature == m_signature) {
+        return false;
+    }
+
+    Rebuild(objects, layerMask);
+    m_signature = signature;
+    m_built = true;
+    return true;
+}
+
+void StaticBatcher::Rebuild(ObjectManager& objects, uint32_t layerMask) {
+    m_batches.clear();
+    m_batched.clear();
+    const uint32_t rebuilds = m_stats.rebuilds + 1;
+    m_stats = StaticBatchStats();
+    m_stats.rebuilds = rebuilds;
+
+    // 按材质分组，组内保持场景顺序
+    struct Group {
+        MaterialKey key;
+        std::shared_ptr<Material> material;
+        std::vector<SceneNode*> nodes;
+    };
+    std::vector<Group> groups;
+    objects.ForEachRenderable([&](SceneNode& node) {
+        if (!IsBatchable(node) || node.GetMesh()->GetVertexCount() == 0) return;
+        const MaterialKey key(node.GetMaterial().get());
+        for (Group& group : groups) {
+            if (group.key == key) {
+                group.nodes.push_back(&node);
+                return;
+            }
+        }
+        groups.push_back({ key, node.GetMaterial(), { &node } });
+    }, layerMask);
+
+    TransformSystem& transforms = TransformSystem::Get();
+    std::unordered_map<const Mesh*, SourceGeometry> sources;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    for (const Group& group : groups) {
+        auto flush = [&]() {
+            if (vertices.empty()) return;
+            auto mesh = std::make_shared<BatchMesh>(vertices, indices);
+            if (mesh->GetVertexCount() > 0) {
+                m_batches.push_back({ mesh, group.material, mesh->GetLocalBounds() });
+                m_stats.vertices += static_cast<uint32_t>(mesh->GetVertexCount());
+            }
+            vertices.clear();
+            indices.clear();
+        };
+
+        for (SceneNode* node : group.nodes) {
+            const Mesh* mesh = node->GetMesh().get();
+            SourceGeometry& source = sources[mesh];
+            if (!source.read) {
+                source.valid = mesh->ReadBack(source.vertices, source.indices);
+                source.read = true;
+            }
+            if (!source.valid) continue;
+
+            // 当前批次放不下时先结束它（单个超大网格独占一个批次）
+            if (!vertices.empty() && vertices.size() + source.vertices.size() > MaxBatchVertices) {
+                flush();
+            }
+
+            // 位置按世界矩阵变换，法线按法线矩阵变换；镜像变换（行列式为负）时翻转三角形的环绕方向
+            const glm::mat4& world = transforms.GetWorldMatrix(node->GetTransformId());
+            const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(world)));
+            const bool mirrored = glm::determinant(glm::mat3(world)) < 0.0f;
+            const uint32_t baseVertex = static_cast<uint32_t>(vertices.size());
+            for (const MeshVertex& vertex : source.vertices) {
+                MeshVertex transformed = vertex;
+                transformed.position = glm::vec3(world * glm::vec4(vertex.position, 1.0f));
+                const glm::vec3 normal = normalMatrix * vertex.normal;
+                const float length = glm::length(normal);
+                transformed.normal = length > 0.0f ? normal / length : vertex.normal;
+                vertices.push_back(transformed);
+            }
+            for (size_t i = 0; i + 2 < source.indices.size(); i += 3) {
+                indices.push_back(baseVertex + source.indices[i]);
+                indices.push_back(baseVertex + source.indices[mirrored ? i + 2 : i + 1]);
+                indices.push_back(baseVertex + source.indices[mirrored ? i + 1 : i + 2]);
+            }
+            const TransformId id = node->GetTransformId();
+            if (id >= m_batched.size()) {
+                m_batched.resize(id + 1, 0);
+            }
+            m_batched[id] = 1;
+            m_stats.nodes++;
+        }
+        flush();
+    }
+
+    m_stats.batches = static_cast<uint32_t>(m_batches.size());
+}
+
+uint32_t StaticBatcher::Submit(RenderQueue& queue, const ViewFrustum& frustum, const Shader* shader) {
+    m_stats.visibleBatches = 0;
+    for (const Batch& batch : m_batches) {
+        if (frustum.Intersects(batch.bounds)) {
+            queue.Submit(batch.mesh.get(), batch.material.get(), glm::mat4(1.0f), shader);
+            m_stats.visibleBatches++;
+        }
+    }
+    return m_stats.visibleBatches;
+}
+
+void StaticBatcher::Clear() {
+    m_batches.clear();
+    m_batched.clear();
+    m_signature = 0;
+    m_built = false;
+    m_stats = StaticBatchStats();
+}
+
+} // namespace SoulsEngine
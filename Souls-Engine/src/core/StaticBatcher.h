@@ -0,0 +1,88 @@
+#pragma once
+
+#include "SceneNode.h"
+#include "../geometry/Bounds.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 前向声明
+class Mesh;
+class Material;
+class Shader;
+class ObjectManager;
+class RenderQueue;
+class ViewFrustum;
+
+// 静态合批统计
+struct StaticBatchStats {
+    uint32_t nodes = 0;           // 合并进批次的静态节点
+    uint32_t batches = 0;         // 批次（每个批次一个网格、一次绘制）
+    uint32_t visibleBatches = 0;  // 本帧通过视锥体测试、提交到渲染队列的批次
+    uint32_t vertices = 0;        // 所有批次的顶点数
+    uint32_t rebuilds = 0;        // 累计重建次数
+};
+
+// 静态合批 - 把SceneNode::SetStatic标记的节点预先变换到世界空间，按材质合并成少数几个大网格，
+// 每个批次只需要一次视锥体测试和一次绘制，代替逐节点的剔除和提交（墙体、地面等环境几何）
+//
+// 批次延迟重建：Update每帧计算静态节点的签名（网格、世界矩阵、材质参数），
+// 只有静态节点增删或被修改时签名才会变化，此时才重建。源网格的顶点从几何池读回（会等待GPU，只在重建时发生）
+//
+// 细节层次节点和半透明材质不参与合批（前者会切换网格，后者需要逐物体按深度排序），仍走逐节点路径；
+// 遍历场景时用IsBatched跳过已经合批的节点（源网格读回失败或没有顶点的节点不会合并，仍需逐节点绘制）
+// 单个批次不超过MaxBatchVertices个顶点（保持16位索引），超出时同一材质拆成多个批次
+class StaticBatcher {
+public:
+    static constexpr uint32_t MaxBatchVertices = 65536;
+
+    StaticBatcher() = default;
+    ~StaticBatcher() = default;
+
+    // 禁止拷贝（持有合并后的网格）
+    StaticBatcher(const StaticBatcher&) = delete;
+    StaticBatcher& operator=(const StaticBatcher&) = delete;
+
+    // 节点是否由合批绘制（静态、有网格、没有细节层次、材质不透明）
+    static bool IsBatchable(const SceneNode& node);
+
+    // 节点是否已合并进当前的批次（按上一次重建的结果，Update之后调用）
+    bool IsBatched(const SceneNode& node) const {
+        const TransformId id = node.GetTransformId();
+        return id < m_batched.size() && m_batched[id] != 0;
+    }
+
+    // 与场景同步：只合并layerMask中的节点，静态节点变化时重建，返回本次是否重建
+    bool Update(ObjectManager& objects, uint32_t layerMask = NodeLayer::All);
+
+    // 把与视锥体相交的批次提交到渲染队列（模型矩阵为单位矩阵），返回提交的批次数
+    uint32_t Submit(RenderQueue& queue, const ViewFrustum& frustum, const Shader* shader = nullptr);
+
+    // 删除所有批次，下一次Update重新构建
+    void Clear();
+
+    const StaticBatchStats& GetStats() const { return m_stats; }
+
+private:
+    struct Batch {
+        std::shared_ptr<Mesh> mesh;              // 世界空间的合并网格
+        std::shared_ptr<Material> material;      // 组内第一个节点的材质（组内材质参数相同）
+        BoundingBox bounds;                      // 世界包围盒
+    };
+
+    std::vector<Batch> m_batches;
+    std::vector<uint8_t> m_batched;  // 按TransformId索引，上一次重建中实际合并的节点为1
+    uint64_t m_signature = 0;
+    bool m_built = false;
+    StaticBatchStats m_stats;
+
+    // 参与合批的节点的签名（FNV-1a），与ShadowMap的静态缓存签名类似，但包含完整的世界矩阵和材质参数
+    static uint64_t ComputeSignature(ObjectManager& objects, uint32_t layerMask);
+
+    // 重建所有批次
+    void Rebuild(ObjectManager& objects, uint32_t layerMask);
+};
+
+} // namespace SoulsEngine
@@ -3,47 +3,45 @@
 namespace SoulsEngine {
 
 Transform::Transform()
-    : m_position(0.0f, 0.0f, 0.0f)
-    , m_rotation(0.0f, 0.0f, 0.0f)
-    , m_scale(1.0f, 1.0f, 1.0f)
-    , m_matrix(1.0f)
-    , m_dirty(true)
+    : m_id(TransformSystem::Get().Create())
 {
 }
 
 Transform::Transform(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale)
-    : m_position(position)
-    , m_rotation(rotation)
-    , m_scale(scale)
-    , m_matrix(1.0f)
-    , m_dirty(true)
+    : m_id(TransformSystem::Get().Create())
 {
+    SetPosition(position);
+    SetRotation(rotation);
+    SetScale(scale);
 }
 
-glm::mat4 Transform::GetMatrix() const {
-    if (m_dirty) {
-        // 计算变换矩阵：T * R * S
-        // 正确的顺序：先平移，再旋转，最后缩放
-        // 这样旋转会围绕物体自身的位置进行，而不是围绕原点
-        m_matrix = glm::mat4(1.0f);
-        // 1. 先平移到物体位置
-        m_matrix = glm::translate(m_matrix, m_position);
-        // 2. 然后旋转（围绕物体位置，因为已经平移了）
-        m_matrix = glm::rotate(m_matrix, glm::radians(m_rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-        m_matrix = glm::rotate(m_matrix, glm::radians(m_rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-        m_matrix = glm::rotate(m_matrix, glm::radians(m_rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-        // 3. 最后缩放
-        m_matrix = glm::scale(m_matrix, m_scale);
-        m_dirty = false;
+Transform::~Transform() {
+    TransformSystem::Get().Destroy(m_id);
+}
+
+Transform::Transform(const Transform& other)
+    : Transform(other.GetPosition(), other.GetRotation(), other.GetScale())
+{
+}
+
+Transform& Transform::operator=(const Transform& other) {
+    if (this != &other) {
+        SetPosition(other.GetPosition());
+        SetRotation(other.GetRotation());
+        SetScale(other.GetScale());
     }
-    return m_matrix;
+    return *this;
+}
+
+glm::mat4 Transform::GetMatrix() const {
+    // 计算变换矩阵：T * R * S（由TransformSystem缓存）
+    return TransformSystem::Get().GetLocalMatrix(m_id);
 }
 
 void Transform::Reset() {
-    m_position = glm::vec3(0.0f);
-    m_rotation = glm::vec3(0.0f);
-    m_scale = glm::vec3(1.0f);
-    m_dirty = true;
+    SetPosition(glm::vec3(0.0f));
+    SetRotation(glm::vec3(0.0f));
+    SetScale(glm::vec3(1.0f));
 }
 
 // 坐标转换工具函数实现
@@ -3,68 +3,76 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include "TransformSystem.h"
 
 namespace SoulsEngine {
 
 // 变换类 - 封装位置、旋转、缩放
+// 数据存放在TransformSystem中，本类只是持有TransformId的句柄
 class Transform {
 public:
     Transform();
     Transform(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale);
-    ~Transform() = default;
+    ~Transform();
+
+    // 拷贝时分配新的变换槽位并复制TRS
+    Transform(const Transform& other);
+    Transform& operator=(const Transform& other);
 
     // 位置（平移）
-    void SetPosition(const glm::vec3& position) { m_position = position; m_dirty = true; }
-    void SetPosition(float x, float y, float z) { m_position = glm::vec3(x, y, z); m_dirty = true; }
-    glm::vec3 GetPosition() const { return m_position; }
+    void SetPosition(const glm::vec3& position) { TransformSystem::Get().SetPosition(m_id, position); }
+    void SetPosition(float x, float y, float z) { SetPosition(glm::vec3(x, y, z)); }
+    glm::vec3 GetPosition() const { return TransformSystem::Get().GetPosition(m_id); }
     
     // 相对平移
-    void Translate(const glm::vec3& translation) { m_position += translation; m_dirty = true; }
-    void Translate(float x, float y, float z) { m_position += glm::vec3(x, y, z); m_dirty = true; }
+    void Translate(const glm::vec3& translation) { SetPosition(GetPosition() + translation); }
+    void Translate(float x, float y, float z) { Translate(glm::vec3(x, y, z)); }
 
     // 旋转（欧拉角，单位：度）
-    void SetRotation(const glm::vec3& rotation) { m_rotation = rotation; m_dirty = true; }
-    void SetRotation(float x, float y, float z) { m_rotation = glm::vec3(x, y, z); m_dirty = true; }
-    glm::vec3 GetRotation() const { return m_rotation; }
+    void SetRotation(const glm::vec3& rotation) { TransformSystem::Get().SetRotation(m_id, rotation); }
+    void SetRotation(float x, float y, float z) { SetRotation(glm::vec3(x, y, z)); }
+    glm::vec3 GetRotation() const { return TransformSystem::Get().GetRotation(m_id); }
+
+    // 旋转（四元数，内部存储形式）
+    void SetOrientation(const glm::quat& orientation) { TransformSystem::Get().SetOrientation(m_id, orientation); }
+    glm::quat GetOrientation() const { return TransformSystem::Get().GetOrientation(m_id); }
     
     // 相对旋转
-    void Rotate(const glm::vec3& rotation) { m_rotation += rotation; m_dirty = true; }
-    void Rotate(float x, float y, float z) { m_rotation += glm::vec3(x, y, z); m_dirty = true; }
-    void RotateX(float angle) { m_rotation.x += angle; m_dirty = true; }
-    void RotateY(float angle) { m_rotation.y += angle; m_dirty = true; }
-    void RotateZ(float angle) { m_rotation.z += angle; m_dirty = true; }
+    void Rotate(const glm::vec3& rotation) { SetRotation(GetRotation() + rotation); }
+    void Rotate(float x, float y, float z) { Rotate(glm::vec3(x, y, z)); }
+    void RotateX(float angle) { Rotate(glm::vec3(angle, 0.0f, 0.0f)); }
+    void RotateY(float angle) { Rotate(glm::vec3(0.0f, angle, 0.0f)); }
+    void RotateZ(float angle) { Rotate(glm::vec3(0.0f, 0.0f, angle)); }
 
     // 缩放
-    void SetScale(const glm::vec3& scale) { m_scale = scale; m_dirty = true; }
-    void SetScale(float x, float y, float z) { m_scale = glm::vec3(x, y, z); m_dirty = true; }
-    void SetScale(float uniform) { m_scale = glm::vec3(uniform); m_dirty = true; }
-    glm::vec3 GetScale() const { return m_scale; }
+    void SetScale(const glm::vec3& scale) { TransformSystem::Get().SetScale(m_id, scale); }
+    void SetScale(float x, float y, float z) { SetScale(glm::vec3(x, y, z)); }
+    void SetScale(float uniform) { SetScale(glm::vec3(uniform)); }
+    glm::vec3 GetScale() const { return TransformSystem::Get().GetScale(m_id); }
     
     // 相对缩放
-    void Scale(const glm::vec3& scale) { m_scale *= scale; m_dirty = true; }
-    void Scale(float uniform) { m_scale *= uniform; m_dirty = true; }
+    void Scale(const glm::vec3& scale) { SetScale(GetScale() * scale); }
+    void Scale(float uniform) { SetScale(GetScale() * uniform); }
 
     // 获取变换矩阵（T * R * S）
     glm::mat4 GetMatrix() const;
 
     // 重置变换
     void Reset();
-    void ResetPosition() { m_position = glm::vec3(0.0f); m_dirty = true; }
-    void ResetRotation() { m_rotation = glm::vec3(0.0f); m_dirty = true; }
-    void ResetScale() { m_scale = glm::vec3(1.0f); m_dirty = true; }
+    void ResetPosition() { SetPosition(glm::vec3(0.0f)); }
+    void ResetRotation() { SetRotation(glm::vec3(0.0f)); }
+    void ResetScale() { SetScale(glm::vec3(1.0f)); }
 
     // 检查是否需要更新
-    bool IsDirty() const { return m_dirty; }
-    void MarkDirty() { m_dirty = true; }
-    void MarkClean() { m_dirty = false; }
+    bool IsDirty() const { return TransformSystem::Get().IsLocalDirty(m_id); }
+    void MarkDirty() { TransformSystem::Get().MarkLocalDirty(m_id); }
+    void MarkClean() { GetMatrix(); }
 
-private:
-    glm::vec3 m_position;  // 位置
-    glm::vec3 m_rotation;  // 旋转（欧拉角，度）
-    glm::vec3 m_scale;     // 缩放
+    // 变换数据句柄
+    TransformId GetId() const { return m_id; }
 
-    mutable glm::mat4 m_matrix;  // 缓存的变换矩阵
-    mutable bool m_dirty;        // 是否需要重新计算
+private:
+    TransformId m_id;
 };
 
 // 坐标转换工具函数
@@ -0,0 +1,154 @@
+#include "TransformMath.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef SOULS_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace SoulsEngine {
+namespace TransformMath {
+
+glm::quat EulerToQuat(const glm::vec3& eulerDegrees) {
+    // q = qz * qy * qx，展开后只需要三组半角正余弦
+    glm::vec3 half = glm::radians(eulerDegrees) * 0.5f;
+    float cx = std::cos(half.x), sx = std::sin(half.x);
+    float cy = std::cos(half.y), sy = std::sin(half.y);
+    float cz = std::cos(half.z), sz = std::sin(half.z);
+
+    glm::quat q;
+    q.w = cz * cy * cx + sz * sy * sx;
+    q.x = cz * cy * sx - sz * sy * cx;
+    q.y = cz * sy * cx + sz * cy * sx;
+    q.z = sz * cy * cx - cz * sy * sx;
+    return q;
+}
+
+glm::vec3 QuatToEuler(const glm::quat& rotation) {
+    glm::quat q = glm::normalize(rotation);
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    // R = Rz * Ry * Rx，第三行第一列为 -sin(y)
+    float m20 = 2.0f * (xz - wy);
+    float sinY = std::clamp(-m20, -1.0f, 1.0f);
+    glm::vec3 euler;
+    euler.y = std::asin(sinY);
+    if (std::abs(sinY) < 0.9999f) {
+        euler.x = std::atan2(2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy));
+        euler.z = std::atan2(2.0f * (xy + wz), 1.0f - 2.0f * (yy + zz));
+    } else {
+        // 万向节锁：X和Z绕同一轴，全部归到Z上
+        euler.x = 0.0f;
+        euler.z = std::atan2(-2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz));
+    }
+    return glm::degrees(euler);
+}
+
+void ComposeTRS(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4& out) {
+    float x2 = rotation.x + rotation.x, y2 = rotation.y + rotation.y, z2 = rotation.z + rotation.z;
+    float xx = rotation.x * x2, yy = rotation.y * y2, zz = rotation.z * z2;
+    float xy = rotation.x * y2, xz = rotation.x * z2, yz = rotation.y * z2;
+    float wx = rotation.w * x2, wy = rotation.w * y2, wz = rotation.w * z2;
+
+    out[0] = glm::vec4((1.0f - (yy + zz)) * scale.x, (xy + wz) * scale.x, (xz - wy) * scale.x, 0.0f);
+    out[1] = glm::vec4((xy - wz) * scale.y, (1.0f - (xx + zz)) * scale.y, (yz + wx) * scale.y, 0.0f);
+    out[2] = glm::vec4((xz + wy) * scale.z, (yz - wx) * scale.z, (1.0f - (xx + yy)) * scale.z, 0.0f);
+    out[3] = glm::vec4(position, 1.0f);
+}
+
+#ifdef SOULS_SIMD_SSE
+namespace {
+
+// 4个变换并行合成：输入转置为SoA后按分量计算，再转置回列主序写出
+inline void ComposeTRS4(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+                        glm::mat4* out, uint32_t i0, uint32_t i1, uint32_t i2, uint32_t i3) {
+    __m128 qx = _mm_loadu_ps(&rotations[i0].x);
+    __m128 qy = _mm_loadu_ps(&rotations[i1].x);
+    __m128 qz = _mm_loadu_ps(&rotations[i2].x);
+    __m128 qw = _mm_loadu_ps(&rotations[i3].x);
+    _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+    const __m128 sx = _mm_set_ps(scales[i3].x, scales[i2].x, scales[i1].x, scales[i0].x);
+    const __m128 sy = _mm_set_ps(scales[i3].y, scales[i2].y, scales[i1].y, scales[i0].y);
+    const __m128 sz = _mm_set_ps(scales[i3].z, scales[i2].z, scales[i1].z, scales[i0].z);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 x2 = _mm_add_ps(qx, qx);
+    const __m128 y2 = _mm_add_ps(qy, qy);
+    const __m128 z2 = _mm_add_ps(qz, qz);
+    const __m128 xx = _mm_mul_ps(qx, x2);
+    const __m128 yy = _mm_mul_ps(qy, y2);
+    const __m128 zz = _mm_mul_ps(qz, z2);
+    const __m128 xy = _mm_mul_ps(qx, y2);
+    const __m128 xz = _mm_mul_ps(qx, z2);
+    const __m128 yz = _mm_mul_ps(qy, z2);
+    const __m128 wx = _mm_mul_ps(qw, x2);
+    const __m128 wy = _mm_mul_ps(qw, y2);
+    const __m128 wz = _mm_mul_ps(qw, z2);
+
+    __m128 c00 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+    __m128 c01 = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+    __m128 c02 = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+    __m128 c03 = _mm_setzero_ps();
+
+    __m128 c10 = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+    __m128 c11 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+    __m128 c12 = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+    __m128 c13 = _mm_setzero_ps();
+
+    __m128 c20 = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+    __m128 c21 = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+    __m128 c22 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+    __m128 c23 = _mm_setzero_ps();
+
+    __m128 c30 = _mm_set_ps(positions[i3].x, positions[i2].x, positions[i1].x, positions[i0].x);
+    __m128 c31 = _mm_set_ps(positions[i3].y, positions[i2].y, positions[i1].y, positions[i0].y);
+    __m128 c32 = _mm_set_ps(positions[i3].z, positions[i2].z, positions[i1].z, positions[i0].z);
+    __m128 c33 = one;
+
+    _MM_TRANSPOSE4_PS(c00, c01, c02, c03);
+    _MM_TRANSPOSE4_PS(c10, c11, c12, c13);
+    _MM_TRANSPOSE4_PS(c20, c21, c22, c23);
+    _MM_TRANSPOSE4_PS(c30, c31, c32, c33);
+
+    _mm_storeu_ps(&out[i0][0].x, c00); _mm_storeu_ps(&out[i0][1].x, c10); _mm_storeu_ps(&out[i0][2].x, c20); _mm_storeu_ps(&out[i0][3].x, c30);
+    _mm_storeu_ps(&out[i1][0].x, c01); _mm_storeu_ps(&out[i1][1].x, c11); _mm_storeu_ps(&out[i1][2].x, c21); _mm_storeu_ps(&out[i1][3].x, c31);
+    _mm_storeu_ps(&out[i2][0].x, c02); _mm_storeu_ps(&out[i2][1].x, c12); _mm_storeu_ps(&out[i2][2].x, c22); _mm_storeu_ps(&out[i2][3].x, c32);
+    _mm_storeu_ps(&out[i3][0].x, c03); _mm_storeu_ps(&out[i3][1].x, c13); _mm_storeu_ps(&out[i3][2].x, c23); _mm_storeu_ps(&out[i3][3].x, c33);
+}
+
+} // namespace
+#endif
+
+void ComposeTRSBatch(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+                     glm::mat4* out, size_t count) {
+    size_t i = 0;
+#ifdef SOULS_SIMD_SSE
+    for (; i + 4 <= count; i += 4) {
+        uint32_t base = static_cast<uint32_t>(i);
+        ComposeTRS4(positions, rotations, scales, out, base, base + 1, base + 2, base + 3);
+    }
+#endif
+    for (; i < count; ++i) {
+        ComposeTRS(positions[i], rotations[i], scales[i], out[i]);
+    }
+}
+
+void ComposeTRSBatch(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+                     glm::mat4* out, const uint32_t* indices, size_t count) {
+    size_t i = 0;
+#ifdef SOULS_SIMD_SSE
+    for (; i + 4 <= count; i += 4) {
+        ComposeTRS4(positions, rotations, scales, out, indices[i], indices[i + 1], indices[i + 2], indices[i + 3]);
+    }
+#endif
+    for (; i < count; ++i) {
+        uint32_t index = indices[i];
+        ComposeTRS(positions[index], rotations[index], scales[index], out[index]);
+    }
+}
+
+} // namespace TransformMath
+} // namespace SoulsEngine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// 是否启用SSE实现（x64和开启SSE2的x86编译器默认都满足）
+#if !defined(SOULS_NO_SIMD) && !defined(GLM_FORCE_QUAT_DATA_WXYZ) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SOULS_SIMD_SSE 1
+#endif
+
+namespace SoulsEngine {
+
+// 变换数学工具 - 四元数/欧拉角转换与TRS矩阵合成
+namespace TransformMath {
+
+    // 欧拉角（度，按Z、Y、X顺序旋转，即 R = Rz * Ry * Rx）与四元数互转
+    glm::quat EulerToQuat(const glm::vec3& eulerDegrees);
+    glm::vec3 QuatToEuler(const glm::quat& rotation);
+
+    // 直接合成仿射矩阵 T * R * S，不经过中间4x4矩阵乘法
+    void ComposeTRS(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4& out);
+
+    // 批量合成：out[i] = T(positions[i]) * R(rotations[i]) * S(scales[i])
+    // SSE路径每次并行处理4个变换
+    void ComposeTRSBatch(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+                         glm::mat4* out, size_t count);
+
+    // 按索引批量合成：只处理indices中列出的元素，输入输出使用同一索引
+    void ComposeTRSBatch(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+                         glm::mat4* out, const uint32_t* indices, size_t count);
+
+} // namespace TransformMath
+
+} // namespace SoulsEngine
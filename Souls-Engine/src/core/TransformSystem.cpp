@@ -0,0 +1,432 @@
+#include "TransformSystem.h"
+#include "JobSystem.h"
+#include "OcclusionCuller.h"
+#include "TransformMath.h"
+#include "ViewFrustum.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+
+namespace SoulsEngine {
+
+TransformSystem& TransformSystem::Get() {
+    static TransformSystem instance;
+    return instance;
+}
+
+TransformId TransformSystem::Create() {
+    // 这里不压缩空洞：压缩会重排所有槽位，使CullWorldBounds写出的可见性表在下一次
+    // UpdateWorldTransforms之前失效（剔除与绘制之间创建节点时会读到其他节点的结果）
+    // 空洞在UpdateWorldTransforms中统一回收，ID经m_freeIds复用，数组不会无限增长
+
+    TransformId id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        id = static_cast<TransformId>(m_slots.size());
+        m_slots.push_back(0);
+    }
+
+    // 新变换没有父节点，追加到末尾不会破坏“父节点在前”的顺序，不需要重排；
+    // 末尾这段根节点不属于任何子树区间，由UpdateWorldTransforms单独更新，
+    // 直到SetParent/Destroy真正改变层级时才在Rebuild中归入最前面的根节点区间
+    uint32_t slot = static_cast<uint32_t>(m_ids.size());
+    m_slots[id] = slot;
+    m_ids.push_back(id);
+    m_position.emplace_back(0.0f);
+    m_rotation.emplace_back(0.0f);
+    m_orientation.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+    m_scale.emplace_back(1.0f);
+    m_local.emplace_back(1.0f);
+    m_world.emplace_back(1.0f);
+    m_inverseWorld.emplace_back(1.0f);
+    m_parent.push_back(NoParent);
+    m_depth.push_back(0);
+    m_flags.push_back(LocalDirty | WorldDirty | InverseDirty);
+    m_localBounds.emplace_back();
+    m_worldCenterX.push_back(0.0f);
+    m_worldCenterY.push_back(0.0f);
+    m_worldCenterZ.push_back(0.0f);
+    m_worldExtentX.push_back(-FLT_MAX);
+    m_worldExtentY.push_back(-FLT_MAX);
+    m_worldExtentZ.push_back(-FLT_MAX);
+    ++m_version;
+    return id;
+}
+
+void TransformSystem::Destroy(TransformId id) {
+    if (id >= m_slots.size()) return;
+    uint32_t slot = m_slots[id];
+    if (slot >= m_ids.size() || m_ids[slot] != id) return;
+
+    // 只做标记，槽位在下一次Rebuild时统一回收，保持其余数据的顺序不变
+    m_ids[slot] = InvalidTransformId;
+    m_parent[slot] = NoParent;
+    m_flags[slot] = FreeSlot;
+    m_localBounds[slot] = BoundingBox();
+    UpdateWorldBounds(slot);
+    m_slots[id] = 0xFFFFFFFFu;
+    m_freeIds.push_back(id);
+    m_freeSlotCount++;
+    ++m_version;
+}
+
+void TransformSystem::SetParent(TransformId id, TransformId parent) {
+    uint32_t slot = m_slots[id];
+    int32_t parentSlot = (parent == InvalidTransformId) ? NoParent : static_cast<int32_t>(m_slots[parent]);
+    if (m_parent[slot] == parentSlot) return;
+
+    // 层级变化会改变深度和子树分段，下一次更新前重排
+    m_parent[slot] = parentSlot;
+    m_flags[slot] |= WorldDirty;
+    m_orderDirty = true;
+    ++m_version;
+}
+
+TransformId TransformSystem::GetParent(TransformId id) const {
+    int32_t parentSlot = m_parent[m_slots[id]];
+    return parentSlot == NoParent ? InvalidTransformId : m_ids[parentSlot];
+}
+
+const glm::mat4& TransformSystem::GetLocalMatrix(TransformId id) {
+    uint32_t slot = m_slots[id];
+    if (m_flags[slot] & LocalDirty) {
+        UpdateLocal(slot);
+    }
+    return m_local[slot];
+}
+
+const glm::mat4& TransformSystem::GetWorldMatrix(TransformId id) {
+    uint32_t slot = m_slots[id];
+    UpdateWorld(slot);
+    return m_world[slot];
+}
+
+const glm::mat4& TransformSystem::GetInverseWorldMatrix(TransformId id) {
+    uint32_t slot = m_slots[id];
+    UpdateWorld(slot);
+    if (m_flags[slot] & InverseDirty) {
+        m_inverseWorld[slot] = glm::inverse(m_world[slot]);
+        m_flags[slot] &= ~InverseDirty;
+    }
+    return m_inverseWorld[slot];
+}
+
+void TransformSystem::SetLocalBounds(TransformId id, const BoundingBox& bounds) {
+    uint32_t slot = m_slots[id];
+    m_localBounds[slot] = bounds;
+    ++m_version;
+    // 世界矩阵是脏的时，包围盒会在下一次更新世界矩阵时一起计算；
+    // 更新世界矩阵时跳过没有包围盒的槽位，因此清除包围盒时要立即写回空的世界包围盒
+    if (!bounds.IsValid() || !(m_flags[slot] & WorldDirty)) {
+        UpdateWorldBounds(slot);
+    }
+}
+
+BoundingBox TransformSystem::GetWorldBounds(TransformId id) {
+    uint32_t slot = m_slots[id];
+    UpdateWorld(slot);
+    BoundingBox bounds;
+    bounds.center = glm::vec3(m_worldCenterX[slot], m_worldCenterY[slot], m_worldCenterZ[slot]);
+    bounds.extents = glm::vec3(m_worldExtentX[slot], m_worldExtentY[slot], m_worldExtentZ[slot]);
+    return bounds;
+}
+
+size_t TransformSystem::CullWorldBounds(const ViewFrustum& frustum, std::vector<uint8_t>& visibility) const {
+    visibility.resize(m_ids.size());
+    return frustum.CullBoxes(m_worldCenterX.data(), m_worldCenterY.data(), m_worldCenterZ.data(),
+                             m_worldExtentX.data(), m_worldExtentY.data(), m_worldExtentZ.data(),
+                             m_ids.size(), visibility.data());
+}
+
+size_t TransformSystem::CullOccludedBounds(const OcclusionCuller& occlusion, std::vector<uint8_t>& visibility,
+                                           JobSystem* jobSystem) const {
+    const uint32_t count = static_cast<uint32_t>(std::min(visibility.size(), m_ids.size()));
+    std::atomic<size_t> occludedCount{ 0 };
+
+    auto cullRange = [&](uint32_t begin, uint32_t end) {
+        size_t occluded = 0;
+        for (uint32_t slot = begin; slot < end; ++slot) {
+            if (visibility[slot] != Visible) continue;
+            BoundingBox bounds;
+            bounds.center = glm::vec3(m_worldCenterX[slot], m_worldCenterY[slot], m_worldCenterZ[slot]);
+            bounds.extents = glm::vec3(m_worldExtentX[slot], m_worldExtentY[slot], m_worldExtentZ[slot]);
+            if (!occlusion.IsVisible(bounds)) {
+                visibility[slot] = Occluded;
+                occluded++;
+            }
+        }
+        occludedCount += occluded;
+    };
+
+    if (jobSystem) {
+        jobSystem->ParallelFor(count, 256, cullRange);
+    } else {
+        cullRange(0, count);
+    }
+    return occludedCount;
+}
+
+void TransformSystem::SetRotation(TransformId id, const glm::vec3& eulerDegrees) {
+    uint32_t slot = m_slots[id];
+    m_rotation[slot] = eulerDegrees;
+    m_orientation[slot] = TransformMath::EulerToQuat(eulerDegrees);
+    m_flags[slot] |= LocalDirty | WorldDirty;
+    ++m_version;
+}
+
+void TransformSystem::SetOrientation(TransformId id, const glm::quat& orientation) {
+    uint32_t slot = m_slots[id];
+    m_orientation[slot] = glm::normalize(orientation);
+    m_rotation[slot] = TransformMath::QuatToEuler(m_orientation[slot]);
+    m_flags[slot] |= LocalDirty | WorldDirty;
+    ++m_version;
+}
+
+void TransformSystem::UpdateLocal(uint32_t slot) {
+    TransformMath::ComposeTRS(m_position[slot], m_orientation[slot], m_scale[slot], m_local[slot]);
+    m_flags[slot] &= ~LocalDirty;
+}
+
+void TransformSystem::UpdateWorld(uint32_t slot) {
+    if (!(m_flags[slot] & WorldDirty)) return;
+
+    // 按需计算：沿父链向上收集脏的祖先，再自上而下依次计算（不递归，任意深度的链都不会耗尽栈）
+    const int32_t parentSlot = m_parent[slot];
+    if (parentSlot != NoParent && (m_flags[parentSlot] & WorldDirty)) {
+        std::vector<uint32_t> dirtyAncestors;
+        for (int32_t ancestor = parentSlot; ancestor != NoParent && (m_flags[ancestor] & WorldDirty);
+             ancestor = m_parent[ancestor]) {
+            dirtyAncestors.push_back(static_cast<uint32_t>(ancestor));
+        }
+        for (auto it = dirtyAncestors.rbegin(); it != dirtyAncestors.rend(); ++it) {
+            UpdateWorldFromParent(*it);
+        }
+    }
+    UpdateWorldFromParent(slot);
+}
+
+void TransformSystem::UpdateWorldFromParent(uint32_t slot) {
+    if (m_flags[slot] & LocalDirty) {
+        UpdateLocal(slot);
+    }
+    const int32_t parentSlot = m_parent[slot];
+    if (parentSlot != NoParent) {
+        m_world[slot] = m_world[parentSlot] * m_local[slot];
+    } else {
+        m_world[slot] = m_local[slot];
+    }
+    m_flags[slot] = (m_flags[slot] & ~WorldDirty) | InverseDirty;
+    if (m_localBounds[slot].IsValid()) {
+        UpdateWorldBounds(slot);
+    }
+}
+
+void TransformSystem::UpdateWorldBounds(uint32_t slot) {
+    BoundingBox world = m_localBounds[slot].Transform(m_world[slot]);
+    m_worldCenterX[slot] = world.center.x;
+    m_worldCenterY[slot] = world.center.y;
+    m_worldCenterZ[slot] = world.center.z;
+    m_worldExtentX[slot] = world.extents.x;
+    m_worldExtentY[slot] = world.extents.y;
+    m_worldExtentZ[slot] = world.extents.z;
+}
+
+void TransformSystem::UpdateWorldTransforms(JobSystem* jobSystem) {
+    if (m_orderDirty || m_freeSlotCount > 0) {
+        Rebuild();
+    }
+
+    const uint32_t count = static_cast<uint32_t>(m_ids.size());
+    const uint32_t rootCount = m_subtreeOffsets.empty() ? count : m_subtreeOffsets.front();
+    m_changed.assign(count, 0);
+
+    // 先串行更新所有根节点，各子树只依赖根节点和自身区间内的数据
+    UpdateRange(0, rootCount);
+
+    const uint32_t batchCount = m_batchOffsets.size() > 1 ? static_cast<uint32_t>(m_batchOffsets.size()) - 1 : 0;
+    if (jobSystem && jobSystem->GetWorkerCount() > 0 && batchCount > 1) {
+        jobSystem->ParallelFor(batchCount, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t batch = begin; batch < end; ++batch) {
+                UpdateRange(m_batchOffsets[batch], m_batchOffsets[batch + 1]);
+            }
+        });
+        // 上一次Rebuild之后Create追加的根节点在所有子树区间之后
+        UpdateRange(m_batchOffsets.back(), count);
+    } else {
+        UpdateRange(rootCount, count);
+    }
+}
+
+void TransformSystem::UpdateRange(uint32_t begin, uint32_t end) {
+    // 分块处理：先收集局部矩阵脏的槽位批量合成（SIMD），再顺序计算世界矩阵
+    constexpr uint32_t ChunkSize = 256;
+    uint32_t dirtyLocals[ChunkSize];
+
+    for (uint32_t chunkBegin = begin; chunkBegin < end; chunkBegin += ChunkSize) {
+        const uint32_t chunkEnd = std::min(chunkBegin + ChunkSize, end);
+
+        uint32_t dirtyCount = 0;
+        for (uint32_t i = chunkBegin; i < chunkEnd; ++i) {
+            if (m_flags[i] & LocalDirty) {
+                dirtyLocals[dirtyCount++] = i;
+            }
+        }
+        if (dirtyCount > 0) {
+            TransformMath::ComposeTRSBatch(m_position.data(), m_orientation.data(), m_scale.data(),
+                                           m_local.data(), dirtyLocals, dirtyCount);
+        }
+
+        // 父节点总在子节点之前，一次顺序遍历即可完成；
+        // 父节点本次被重新计算时子节点也跟着重新计算
+        for (uint32_t i = chunkBegin; i < chunkEnd; ++i) {
+            uint8_t f = m_flags[i];
+            int32_t parentSlot = m_parent[i];
+            if (parentSlot != NoParent && m_changed[parentSlot]) {
+                f |= WorldDirty;
+            }
+            if (!(f & WorldDirty)) continue;
+
+            if (parentSlot != NoParent) {
+                m_world[i] = m_world[parentSlot] * m_local[i];
+            } else {
+                m_world[i] = m_local[i];
+            }
+            m_flags[i] = (f & ~(LocalDirty | WorldDirty)) | InverseDirty;
+            m_changed[i] = 1;
+            if (m_localBounds[i].IsValid()) {
+                UpdateWorldBounds(i);
+            }
+        }
+    }
+}
+
+void TransformSystem::Rebuild() {
+    const size_t count = m_ids.size();
+
+    // 1. 计算每个有效槽位的深度和所属子树（深度为1的祖先）
+    //    数组可能暂时不满足父在前，因此沿父链向上回溯
+    std::vector<int32_t> depth(count, -1);
+    std::vector<int32_t> subtree(count, -1);
+    std::vector<uint32_t> chain;
+    uint32_t maxDepth = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (m_flags[i] & FreeSlot) continue;
+        uint32_t s = static_cast<uint32_t>(i);
+        chain.clear();
+        while (depth[s] < 0) {
+            chain.push_back(s);
+            int32_t p = m_parent[s];
+            if (p == NoParent || (m_flags[p] & FreeSlot)) {
+                m_parent[s] = NoParent;
+                depth[s] = 0;
+                chain.pop_back();
+                break;
+            }
+            s = static_cast<uint32_t>(p);
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            int32_t p = m_parent[*it];
+            depth[*it] = depth[p] + 1;
+            subtree[*it] = (depth[*it] == 1) ? static_cast<int32_t>(*it) : subtree[p];
+        }
+        maxDepth = std::max(maxDepth, static_cast<uint32_t>(depth[i]));
+    }
+
+    // 2. 两趟稳定计数排序：先按深度，再按子树编号（根节点编号为0）
+    //    结果为：所有根节点 | 子树1（按深度）| 子树2（按深度）| ...
+    std::vector<uint32_t> group(count, 0);
+    uint32_t groupCount = 1;
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] == 1) group[i] = groupCount++;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] > 1) group[i] = group[subtree[i]];
+    }
+
+    auto countingSort = [](const std::vector<uint32_t>& input, uint32_t keyCount,
+                           const auto& key, std::vector<uint32_t>& output) {
+        std::vector<uint32_t> offsets(static_cast<size_t>(keyCount) + 1, 0);
+        for (uint32_t slot : input) offsets[key(slot) + 1]++;
+        for (size_t k = 1; k < offsets.size(); ++k) offsets[k] += offsets[k - 1];
+        output.resize(input.size());
+        for (uint32_t slot : input) output[offsets[key(slot)]++] = slot;
+    };
+
+    std::vector<uint32_t> live;
+    live.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] >= 0) live.push_back(static_cast<uint32_t>(i));
+    }
+    std::vector<uint32_t> byDepth;
+    countingSort(live, maxDepth + 1, [&depth](uint32_t slot) { return static_cast<uint32_t>(depth[slot]); }, byDepth);
+    std::vector<uint32_t> order;
+    countingSort(byDepth, groupCount, [&group](uint32_t slot) { return group[slot]; }, order);
+
+    const size_t liveCount = order.size();
+    std::vector<int32_t> remap(count, NoParent);
+    for (size_t i = 0; i < liveCount; ++i) {
+        remap[order[i]] = static_cast<int32_t>(i);
+    }
+
+    // 记录子树区间，并把相邻的小子树合并为并行批次
+    const uint32_t MinBatchSize = 1024;
+    m_subtreeOffsets.clear();
+    m_batchOffsets.clear();
+    for (size_t i = 0; i < liveCount; ++i) {
+        uint32_t g = group[order[i]];
+        if (g != 0 && (i == 0 || group[order[i - 1]] != g)) {
+            m_subtreeOffsets.push_back(static_cast<uint32_t>(i));
+            if (m_batchOffsets.empty() || i - m_batchOffsets.back() >= MinBatchSize) {
+                m_batchOffsets.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+    if (m_batchOffsets.empty()) {
+        m_batchOffsets.push_back(static_cast<uint32_t>(liveCount));
+    }
+    m_subtreeOffsets.push_back(static_cast<uint32_t>(liveCount));
+    m_batchOffsets.push_back(static_cast<uint32_t>(liveCount));
+
+    // 3. 按新顺序重排所有数组
+    auto gather = [&order](auto& array) {
+        std::remove_reference_t<decltype(array)> sorted;
+        sorted.reserve(order.size());
+        for (uint32_t oldSlot : order) {
+            sorted.push_back(array[oldSlot]);
+        }
+        array.swap(sorted);
+    };
+    gather(m_ids);
+    gather(m_position);
+    gather(m_rotation);
+    gather(m_orientation);
+    gather(m_scale);
+    gather(m_local);
+    gather(m_world);
+    gather(m_inverseWorld);
+    gather(m_parent);
+    gather(m_flags);
+    gather(m_localBounds);
+    gather(m_worldCenterX);
+    gather(m_worldCenterY);
+    gather(m_worldCenterZ);
+    gather(m_worldExtentX);
+    gather(m_worldExtentY);
+    gather(m_worldExtentZ);
+
+    m_depth.resize(liveCount);
+    for (size_t i = 0; i < liveCount; ++i) {
+        int32_t parentSlot = m_parent[i];
+        m_parent[i] = parentSlot == NoParent ? NoParent : remap[parentSlot];
+        m_depth[i] = static_cast<uint16_t>(depth[order[i]]);
+        m_slots[m_ids[i]] = static_cast<uint32_t>(i);
+    }
+
+    m_freeSlotCount = 0;
+    m_orderDirty = false;
+}
+
+} // namespace SoulsEngine
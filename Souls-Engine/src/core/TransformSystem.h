@@ -0,0 +1,163 @@
+#pragma once
+
+#include "../geometry/Bounds.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace SoulsEngine {
+
+class JobSystem;
+class OcclusionCuller;
+class ViewFrustum;
+
+// 变换句柄（稳定ID，不随内部数组重排而改变）
+using TransformId = uint32_t;
+constexpr TransformId InvalidTransformId = 0xFFFFFFFFu;
+
+// 变换系统 - 以SoA形式集中存储所有节点的局部TRS、局部矩阵、世界矩阵和父索引
+// 数组按层级深度排序（父节点总在子节点之前），世界矩阵更新只需一次线性遍历
+// 深度为0的根节点排在最前，其后每个深度为1的节点及其子树占据一段连续区间，
+// 这些区间互不依赖，可以交给JobSystem并行更新
+// 世界矩阵更新时顺带把局部包围盒变换到世界空间，按槽位以SoA形式存放，供视锥体剔除批量测试
+// Node和Transform只持有TransformId，是对这里数据的轻量句柄
+class TransformSystem {
+public:
+    // 全局实例（节点可以脱离场景单独创建，因此存储是进程级的）
+    static TransformSystem& Get();
+
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    // 创建/销毁变换
+    TransformId Create();
+    void Destroy(TransformId id);
+
+    // 层级关系（parent为InvalidTransformId表示根）
+    void SetParent(TransformId id, TransformId parent);
+    TransformId GetParent(TransformId id) const;
+
+    // 局部TRS
+    // 旋转内部以四元数存储；同时保留最后一次设置的欧拉角（度），保证编辑器读写往返一致
+    const glm::vec3& GetPosition(TransformId id) const { return m_position[m_slots[id]]; }
+    const glm::vec3& GetRotation(TransformId id) const { return m_rotation[m_slots[id]]; }
+    const glm::quat& GetOrientation(TransformId id) const { return m_orientation[m_slots[id]]; }
+    const glm::vec3& GetScale(TransformId id) const { return m_scale[m_slots[id]]; }
+    void SetPosition(TransformId id, const glm::vec3& position) { uint32_t s = m_slots[id]; m_position[s] = position; m_flags[s] |= LocalDirty | WorldDirty; ++m_version; }
+    void SetRotation(TransformId id, const glm::vec3& eulerDegrees);
+    void SetOrientation(TransformId id, const glm::quat& orientation);
+    void SetScale(TransformId id, const glm::vec3& scale) { uint32_t s = m_slots[id]; m_scale[s] = scale; m_flags[s] |= LocalDirty | WorldDirty; ++m_version; }
+
+    // 变换矩阵（脏时按需计算；返回的引用在下一次Create/Update之前有效）
+    const glm::mat4& GetLocalMatrix(TransformId id);
+    const glm::mat4& GetWorldMatrix(TransformId id);
+    const glm::mat4& GetInverseWorldMatrix(TransformId id);
+
+    // 脏标记：只标记单个变换的世界矩阵，子树传播由调用方（Node）负责
+    bool IsLocalDirty(TransformId id) const { return (m_flags[m_slots[id]] & LocalDirty) != 0; }
+    void MarkLocalDirty(TransformId id) { m_flags[m_slots[id]] |= LocalDirty | WorldDirty; ++m_version; }
+    bool IsWorldDirty(TransformId id) const { return (m_flags[m_slots[id]] & WorldDirty) != 0; }
+    void MarkWorldDirty(TransformId id) { m_flags[m_slots[id]] |= WorldDirty; }
+
+    // 局部包围盒（通常来自网格）；世界包围盒随世界矩阵一起更新（没有包围盒的槽位跳过），没有包围盒的变换永远不可见
+    void SetLocalBounds(TransformId id, const BoundingBox& bounds);
+    const BoundingBox& GetLocalBounds(TransformId id) const { return m_localBounds[m_slots[id]]; }
+    BoundingBox GetWorldBounds(TransformId id);
+
+    // visibility表中每个槽位的取值
+    enum Visibility : uint8_t {
+        Culled = 0,    // 在视锥体外（或没有包围盒）
+        Visible = 1,
+        Occluded = 2,  // 在视锥体内但被遮挡
+    };
+
+    // 用视锥体批量测试所有槽位的世界包围盒（需先调用UpdateWorldTransforms）
+    // visibility按槽位写入，之后用IsVisible按ID查询，直到下一次UpdateWorldTransforms
+    size_t CullWorldBounds(const ViewFrustum& frustum, std::vector<uint8_t>& visibility) const;
+
+    // 对CullWorldBounds之后仍可见的槽位做遮挡测试（需先OcclusionCuller::Wait），返回被遮挡的数量
+    // 传入jobSystem时并行测试
+    size_t CullOccludedBounds(const OcclusionCuller& occlusion, std::vector<uint8_t>& visibility,
+                              JobSystem* jobSystem = nullptr) const;
+
+    bool IsVisible(const std::vector<uint8_t>& visibility, TransformId id) const {
+        uint32_t slot = m_slots[id];
+        return slot < visibility.size() && visibility[slot] == Visible;
+    }
+    bool IsOccluded(const std::vector<uint8_t>& visibility, TransformId id) const {
+        uint32_t slot = m_slots[id];
+        return slot < visibility.size() && visibility[slot] == Occluded;
+    }
+
+    // 一次线性遍历更新所有脏的局部/世界矩阵（必要时先按深度重排数组）
+    // 传入jobSystem时各子树区间并行更新，结果与串行逐位一致
+    void UpdateWorldTransforms(JobSystem* jobSystem = nullptr);
+
+    // 版本号：任何变换、层级或包围盒的修改都会使其递增，缓存世界空间数据的系统（如SceneBVH）据此判断是否需要更新
+    uint64_t GetVersion() const { return m_version; }
+
+    // 统计
+    size_t GetCount() const { return m_ids.size() - m_freeSlotCount; }
+    size_t GetCapacity() const { return m_ids.size(); }
+
+private:
+    TransformSystem() = default;
+
+    enum Flags : uint8_t {
+        LocalDirty = 1 << 0,
+        WorldDirty = 1 << 1,
+        InverseDirty = 1 << 2,
+        FreeSlot = 1 << 3
+    };
+
+    static constexpr int32_t NoParent = -1;
+
+    void UpdateLocal(uint32_t slot);
+    void UpdateWorld(uint32_t slot);
+    // 父节点的世界矩阵已是最新时，只计算这一个槽位
+    void UpdateWorldFromParent(uint32_t slot);
+    void UpdateWorldBounds(uint32_t slot);
+
+    // 顺序更新[begin, end)区间，区间内节点的父节点必须已经更新
+    void UpdateRange(uint32_t begin, uint32_t end);
+
+    // 压缩已释放的槽位并重排：根节点在前，之后按子树分段，段内按深度排序
+    void Rebuild();
+
+    // ID -> 槽位映射
+    std::vector<uint32_t> m_slots;
+    std::vector<TransformId> m_freeIds;
+
+    // 按槽位排列的SoA数据
+    std::vector<TransformId> m_ids;
+    std::vector<glm::vec3> m_position;
+    std::vector<glm::vec3> m_rotation;
+    std::vector<glm::quat> m_orientation;
+    std::vector<glm::vec3> m_scale;
+    std::vector<glm::mat4> m_local;
+    std::vector<glm::mat4> m_world;
+    std::vector<glm::mat4> m_inverseWorld;
+    std::vector<int32_t> m_parent;
+    std::vector<uint16_t> m_depth;
+    std::vector<uint8_t> m_flags;
+
+    // 包围盒：局部包围盒按槽位存放，世界包围盒的中心/半边长各分量单独成组，便于SIMD批量测试
+    std::vector<BoundingBox> m_localBounds;
+    std::vector<float> m_worldCenterX, m_worldCenterY, m_worldCenterZ;
+    std::vector<float> m_worldExtentX, m_worldExtentY, m_worldExtentZ;
+
+    // 线性更新时记录本次重新计算过的槽位（用于向子节点传播）
+    std::vector<uint8_t> m_changed;
+
+    // 子树区间：[m_subtreeOffsets[i], m_subtreeOffsets[i+1])，第一个区间开始于根节点之后
+    std::vector<uint32_t> m_subtreeOffsets;
+    // 并行更新时每个任务处理的区间（若干相邻子树合并，避免任务过碎）
+    std::vector<uint32_t> m_batchOffsets;
+
+    size_t m_freeSlotCount = 0;
+    uint64_t m_version = 0;
+    bool m_orderDirty = false;
+};
+
+} // namespace SoulsEngine
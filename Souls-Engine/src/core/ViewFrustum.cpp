@@ -0,0 +1,115 @@
+#include "ViewFrustum.h"
+#include "TransformMath.h"
+#include <cmath>
+
+#ifdef SOULS_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace SoulsEngine {
+
+void ViewFrustum::Extract(const glm::mat4& viewProjection) {
+    // glm按列存储，第i行为 (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&viewProjection](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    // OpenGL裁剪空间：-w <= x,y,z <= w
+    m_planes[Left] = r3 + r0;
+    m_planes[Right] = r3 - r0;
+    m_planes[Bottom] = r3 + r1;
+    m_planes[Top] = r3 - r1;
+    m_planes[Near] = r3 + r2;
+    m_planes[Far] = r3 - r2;
+
+    for (glm::vec4& plane : m_planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+}
+
+bool ViewFrustum::Intersects(const BoundingBox& box) const {
+    if (!box.IsValid()) return false;
+    for (const glm::vec4& plane : m_planes) {
+        // 包围盒在平面法线方向上的投影半径
+        glm::vec3 normal(plane);
+        float distance = glm::dot(normal, box.center) + plane.w;
+        float radius = glm::dot(glm::abs(normal), box.extents);
+        if (distance + radius < 0.0f) return false;
+    }
+    return true;
+}
+
+bool ViewFrustum::Intersects(const BoundingSphere& sphere) const {
+    if (!sphere.IsValid()) return false;
+    for (const glm::vec4& plane : m_planes) {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) return false;
+    }
+    return true;
+}
+
+size_t ViewFrustum::CullBoxes(const float* centerX, const float* centerY, const float* centerZ,
+                              const float* extentX, const float* extentY, const float* extentZ,
+                              size_t count, uint8_t* visible) const {
+    size_t visibleCount = 0;
+    size_t i = 0;
+
+#ifdef SOULS_SIMD_SSE
+    // 平面系数预先广播，循环内只剩乘加和比较
+    __m128 planeX[PlaneCount], planeY[PlaneCount], planeZ[PlaneCount], planeW[PlaneCount];
+    __m128 absX[PlaneCount], absY[PlaneCount], absZ[PlaneCount];
+    for (int p = 0; p < PlaneCount; ++p) {
+        planeX[p] = _mm_set1_ps(m_planes[p].x);
+        planeY[p] = _mm_set1_ps(m_planes[p].y);
+        planeZ[p] = _mm_set1_ps(m_planes[p].z);
+        planeW[p] = _mm_set1_ps(m_planes[p].w);
+        absX[p] = _mm_set1_ps(std::abs(m_planes[p].x));
+        absY[p] = _mm_set1_ps(std::abs(m_planes[p].y));
+        absZ[p] = _mm_set1_ps(std::abs(m_planes[p].z));
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(centerX + i);
+        const __m128 cy = _mm_loadu_ps(centerY + i);
+        const __m128 cz = _mm_loadu_ps(centerZ + i);
+        const __m128 ex = _mm_loadu_ps(extentX + i);
+        const __m128 ey = _mm_loadu_ps(extentY + i);
+        const __m128 ez = _mm_loadu_ps(extentZ + i);
+
+        // 空包围盒（任一半边长为负）直接判为不可见
+        __m128 inside = _mm_and_ps(_mm_cmpge_ps(ex, zero), _mm_and_ps(_mm_cmpge_ps(ey, zero), _mm_cmpge_ps(ez, zero)));
+        for (int p = 0; p < PlaneCount; ++p) {
+            // 运算顺序与标量路径一致，两条路径的结果逐位相同
+            __m128 distance = _mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy));
+            distance = _mm_add_ps(_mm_add_ps(distance, _mm_mul_ps(planeZ[p], cz)), planeW[p]);
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)),
+                                       _mm_mul_ps(absZ[p], ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        visible[i + 0] = static_cast<uint8_t>(mask & 1);
+        visible[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+        visible[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+        visible[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+        visibleCount += static_cast<size_t>(visible[i] + visible[i + 1] + visible[i + 2] + visible[i + 3]);
+    }
+#endif
+
+    // 标量路径（以及SSE路径剩余的不足4个）
+    for (; i < count; ++i) {
+        BoundingBox box;
+        box.center = glm::vec3(centerX[i], centerY[i], centerZ[i]);
+        box.extents = glm::vec3(extentX[i], extentY[i], extentZ[i]);
+        visible[i] = Intersects(box) ? 1 : 0;
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
+} // namespace SoulsEngine
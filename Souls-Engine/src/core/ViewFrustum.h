@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../geometry/Bounds.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace SoulsEngine {
+
+// 视锥体剔除统计
+struct CullingStats {
+    uint32_t tested = 0;    // 参与测试的可渲染节点数
+    uint32_t visible = 0;   // 通过测试的节点数
+    uint32_t occluded = 0;  // 在视锥体内但被遮挡剔除的节点数
+};
+
+// 视锥体 - 从投影*视图矩阵提取6个裁剪平面（Gribb-Hartmann方法），用于剔除包围盒
+// 平面法线指向视锥体内部并已归一化：dot(normal, p) + d >= 0 表示点p在平面内侧
+class ViewFrustum {
+public:
+    enum Plane {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+
+    ViewFrustum() = default;
+    explicit ViewFrustum(const glm::mat4& viewProjection) { Extract(viewProjection); }
+    ViewFrustum(const glm::mat4& view, const glm::mat4& projection) { Extract(projection * view); }
+
+    // 从投影*视图矩阵提取平面
+    void Extract(const glm::mat4& viewProjection);
+
+    // 平面（xyz为法线，w为距离）
+    const glm::vec4& GetPlane(int index) const { return m_planes[index]; }
+
+    // 单个包围盒/包围球测试（相交也算可见）
+    bool Intersects(const BoundingBox& box) const;
+    bool Intersects(const BoundingSphere& sphere) const;
+
+    // 批量测试SoA排列的包围盒（中心和半边长各一组数组），visible[i]写入0或1，返回可见数量
+    // SSE路径每次并行测试4个包围盒；空包围盒（半边长为负）总是不可见
+    size_t CullBoxes(const float* centerX, const float* centerY, const float* centerZ,
+                     const float* extentX, const float* extentY, const float* extentZ,
+                     size_t count, uint8_t* visible) const;
+
+private:
+    glm::vec4 m_planes[PlaneCount] = {};
+};
+
+} // namespace SoulsEngine
@@ -79,6 +79,11 @@ void WeaponModel::CreateWeapon(ObjectManager* objectManager) {
     body->AddChild(barrel);
     body->AddChild(stock);
     
+    // Weapon parts are drawn separately in front of the camera, keep them out of scene passes and raycasts
+    for (const auto& part : { body, barrel, stock, scopeBase, scopeRing, scopeLens }) {
+        part->SetLayer(NodeLayer::ViewModel);
+    }
+    
     m_weaponNode = body;
     m_weaponNode->SetPosition(m_normalPosition);
     m_weaponNode->SetRotation(5.0f, 0.0f, -10.0f);  // Initial slight tilt
@@ -100,12 +105,19 @@ void WeaponModel::Update(bool isZoomed, int windowWidth, int windowHeight) {
     
     // Interpolate current position
     glm::vec3 currentPos = glm::mix(m_normalPosition, m_zoomedPosition, m_animationProgress);
-    m_weaponNode->SetPosition(currentPos);
     
     // Slightly rotate weapon when zoomed for more natural feel
     float rotX = glm::mix(5.0f, 0.0f, m_animationProgress);
     float rotZ = glm::mix(-10.0f, 0.0f, m_animationProgress);
-    m_weaponNode->SetRotation(rotX, 0.0f, rotZ);
+    glm::vec3 currentRot(rotX, 0.0f, rotZ);
+    
+    // Only write the node while the animation is moving, so an idle weapon does not dirty the transform system
+    if (m_weaponNode->GetPosition() != currentPos) {
+        m_weaponNode->SetPosition(currentPos);
+    }
+    if (m_weaponNode->GetRotation() != currentRot) {
+        m_weaponNode->SetRotation(currentRot);
+    }
     
     // Update animation progress (for external access)
     m_animationProgress = m_animationProgress;  // Keep current value
@@ -17,6 +17,7 @@
 static PFNGLGETSTRINGPROC glad_glGetString = NULL;
 static PFNGLCLEARCOLORPROC glad_glClearColor = NULL;
 static PFNGLCLEARPROC glad_glClear = NULL;
+static PFNGLFINISHPROC glad_glFinish = NULL;
 static PFNGLVIEWPORTPROC glad_glViewport = NULL;
 static PFNGLENABLEPROC glad_glEnable = NULL;
 static PFNGLDEPTHFUNCPROC glad_glDepthFunc = NULL;
@@ -56,6 +57,57 @@ static PFNGLVERTEXATTRIBPOINTERPROC glad_glVertexAttribPointer = NULL;
 static PFNGLDRAWELEMENTSPROC glad_glDrawElements = NULL;
 static PFNGLDRAWARRAYSPROC glad_glDrawArrays = NULL;
 static PFNGLGETATTRIBLOCATIONPROC glad_glGetAttribLocation = NULL;
+static PFNGLDRAWARRAYSINSTANCEDPROC glad_glDrawArraysInstanced = NULL;
+static PFNGLDRAWELEMENTSINSTANCEDPROC glad_glDrawElementsInstanced = NULL;
+static PFNGLVERTEXATTRIBDIVISORPROC glad_glVertexAttribDivisor = NULL;
+static PFNGLDISABLEVERTEXATTRIBARRAYPROC glad_glDisableVertexAttribArray = NULL;
+static PFNGLBUFFERSUBDATAPROC glad_glBufferSubData = NULL;
+static PFNGLBINDBUFFERBASEPROC glad_glBindBufferBase = NULL;
+static PFNGLGETUNIFORMBLOCKINDEXPROC glad_glGetUniformBlockIndex = NULL;
+static PFNGLUNIFORMBLOCKBINDINGPROC glad_glUniformBlockBinding = NULL;
+static PFNGLGETACTIVEUNIFORMPROC glad_glGetActiveUniform = NULL;
+static PFNGLGENTEXTURESPROC glad_glGenTextures = NULL;
+static PFNGLDELETETEXTURESPROC glad_glDeleteTextures = NULL;
+static PFNGLBINDTEXTUREPROC glad_glBindTexture = NULL;
+static PFNGLACTIVETEXTUREPROC glad_glActiveTexture = NULL;
+static PFNGLTEXIMAGE2DPROC glad_glTexImage2D = NULL;
+static PFNGLTEXIMAGE3DPROC glad_glTexImage3D = NULL;
+static PFNGLTEXPARAMETERIPROC glad_glTexParameteri = NULL;
+static PFNGLTEXPARAMETERFVPROC glad_glTexParameterfv = NULL;
+static PFNGLGENERATEMIPMAPPROC glad_glGenerateMipmap = NULL;
+static PFNGLGENFRAMEBUFFERSPROC glad_glGenFramebuffers = NULL;
+static PFNGLDELETEFRAMEBUFFERSPROC glad_glDeleteFramebuffers = NULL;
+static PFNGLBINDFRAMEBUFFERPROC glad_glBindFramebuffer = NULL;
+static PFNGLFRAMEBUFFERTEXTURE2DPROC glad_glFramebufferTexture2D = NULL;
+static PFNGLFRAMEBUFFERTEXTURELAYERPROC glad_glFramebufferTextureLayer = NULL;
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC glad_glCheckFramebufferStatus = NULL;
+static PFNGLDRAWBUFFERPROC glad_glDrawBuffer = NULL;
+static PFNGLREADBUFFERPROC glad_glReadBuffer = NULL;
+static PFNGLDISABLEPROC glad_glDisable = NULL;
+static PFNGLCULLFACEPROC glad_glCullFace = NULL;
+static PFNGLPOLYGONOFFSETPROC glad_glPolygonOffset = NULL;
+static PFNGLGETINTEGERVPROC glad_glGetIntegerv = NULL;
+static PFNGLBLITFRAMEBUFFERPROC glad_glBlitFramebuffer = NULL;
+static PFNGLTEXBUFFERPROC glad_glTexBuffer = NULL;
+static PFNGLDRAWBUFFERSPROC glad_glDrawBuffers = NULL;
+static PFNGLDEPTHMASKPROC glad_glDepthMask = NULL;
+static PFNGLGENQUERIESPROC glad_glGenQueries = NULL;
+static PFNGLDELETEQUERIESPROC glad_glDeleteQueries = NULL;
+static PFNGLBEGINQUERYPROC glad_glBeginQuery = NULL;
+static PFNGLENDQUERYPROC glad_glEndQuery = NULL;
+static PFNGLGETQUERYOBJECTIVPROC glad_glGetQueryObjectiv = NULL;
+static PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v = NULL;
+static PFNGLCLEARBUFFERFVPROC glad_glClearBufferfv = NULL;
+static PFNGLISENABLEDPROC glad_glIsEnabled = NULL;
+static PFNGLGETBOOLEANVPROC glad_glGetBooleanv = NULL;
+static PFNGLDRAWELEMENTSBASEVERTEXPROC glad_glDrawElementsBaseVertex = NULL;
+static PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC glad_glDrawElementsInstancedBaseVertex = NULL;
+static PFNGLCOPYBUFFERSUBDATAPROC glad_glCopyBufferSubData = NULL;
+static PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_glMultiDrawElementsIndirect = NULL;
+static PFNGLDISPATCHCOMPUTEPROC glad_glDispatchCompute = NULL;
+static PFNGLMEMORYBARRIERPROC glad_glMemoryBarrier = NULL;
+static PFNGLBINDIMAGETEXTUREPROC glad_glBindImageTexture = NULL;
+static PFNGLGETBUFFERSUBDATAPROC glad_glGetBufferSubData = NULL;
 
 // 加载OpenGL函数
 int gladLoadGLLoader(GLADloadproc load) {
@@ -78,6 +130,7 @@ int gladLoadGLLoader(GLADloadproc load) {
     // 加载其他函数
     glad_glClearColor = (PFNGLCLEARCOLORPROC)load("glClearColor");
     glad_glClear = (PFNGLCLEARPROC)load("glClear");
+    glad_glFinish = (PFNGLFINISHPROC)load("glFinish");
     glad_glViewport = (PFNGLVIEWPORTPROC)load("glViewport");
     glad_glEnable = (PFNGLENABLEPROC)load("glEnable");
     glad_glDepthFunc = (PFNGLDEPTHFUNCPROC)load("glDepthFunc");
@@ -117,6 +170,57 @@ int gladLoadGLLoader(GLADloadproc load) {
     glad_glDrawElements = (PFNGLDRAWELEMENTSPROC)load("glDrawElements");
     glad_glDrawArrays = (PFNGLDRAWARRAYSPROC)load("glDrawArrays");
     glad_glGetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)load("glGetAttribLocation");
+    glad_glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)load("glDrawArraysInstanced");
+    glad_glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)load("glDrawElementsInstanced");
+    glad_glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)load("glVertexAttribDivisor");
+    glad_glDisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)load("glDisableVertexAttribArray");
+    glad_glBufferSubData = (PFNGLBUFFERSUBDATAPROC)load("glBufferSubData");
+    glad_glBindBufferBase = (PFNGLBINDBUFFERBASEPROC)load("glBindBufferBase");
+    glad_glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)load("glGetUniformBlockIndex");
+    glad_glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)load("glUniformBlockBinding");
+    glad_glGetActiveUniform = (PFNGLGETACTIVEUNIFORMPROC)load("glGetActiveUniform");
+    glad_glGenTextures = (PFNGLGENTEXTURESPROC)load("glGenTextures");
+    glad_glDeleteTextures = (PFNGLDELETETEXTURESPROC)load("glDeleteTextures");
+    glad_glBindTexture = (PFNGLBINDTEXTUREPROC)load("glBindTexture");
+    glad_glActiveTexture = (PFNGLACTIVETEXTUREPROC)load("glActiveTexture");
+    glad_glTexImage2D = (PFNGLTEXIMAGE2DPROC)load("glTexImage2D");
+    glad_glTexImage3D = (PFNGLTEXIMAGE3DPROC)load("glTexImage3D");
+    glad_glTexParameteri = (PFNGLTEXPARAMETERIPROC)load("glTexParameteri");
+    glad_glTexParameterfv = (PFNGLTEXPARAMETERFVPROC)load("glTexParameterfv");
+    glad_glGenerateMipmap = (PFNGLGENERATEMIPMAPPROC)load("glGenerateMipmap");
+    glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)load("glGenFramebuffers");
+    glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)load("glDeleteFramebuffers");
+    glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)load("glBindFramebuffer");
+    glad_glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)load("glFramebufferTexture2D");
+    glad_glFramebufferTextureLayer = (PFNGLFRAMEBUFFERTEXTURELAYERPROC)load("glFramebufferTextureLayer");
+    glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)load("glCheckFramebufferStatus");
+    glad_glDrawBuffer = (PFNGLDRAWBUFFERPROC)load("glDrawBuffer");
+    glad_glReadBuffer = (PFNGLREADBUFFERPROC)load("glReadBuffer");
+    glad_glDisable = (PFNGLDISABLEPROC)load("glDisable");
+    glad_glCullFace = (PFNGLCULLFACEPROC)load("glCullFace");
+    glad_glPolygonOffset = (PFNGLPOLYGONOFFSETPROC)load("glPolygonOffset");
+    glad_glGetIntegerv = (PFNGLGETINTEGERVPROC)load("glGetIntegerv");
+    glad_glBlitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)load("glBlitFramebuffer");
+    glad_glTexBuffer = (PFNGLTEXBUFFERPROC)load("glTexBuffer");
+    glad_glDrawBuffers = (PFNGLDRAWBUFFERSPROC)load("glDrawBuffers");
+    glad_glDepthMask = (PFNGLDEPTHMASKPROC)load("glDepthMask");
+    glad_glGenQueries = (PFNGLGENQUERIESPROC)load("glGenQueries");
+    glad_glDeleteQueries = (PFNGLDELETEQUERIESPROC)load("glDeleteQueries");
+    glad_glBeginQuery = (PFNGLBEGINQUERYPROC)load("glBeginQuery");
+    glad_glEndQuery = (PFNGLENDQUERYPROC)load("glEndQuery");
+    glad_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load("glGetQueryObjectiv");
+    glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
+    glad_glClearBufferfv = (PFNGLCLEARBUFFERFVPROC)load("glClearBufferfv");
+    glad_glIsEnabled = (PFNGLISENABLEDPROC)load("glIsEnabled");
+    glad_glGetBooleanv = (PFNGLGETBOOLEANVPROC)load("glGetBooleanv");
+    glad_glDrawElementsBaseVertex = (PFNGLDRAWELEMENTSBASEVERTEXPROC)load("glDrawElementsBaseVertex");
+    glad_glDrawElementsInstancedBaseVertex = (PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC)load("glDrawElementsInstancedBaseVertex");
+    glad_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)load("glCopyBufferSubData");
+    glad_glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)load("glMultiDrawElementsIndirect");
+    glad_glDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC)load("glDispatchCompute");
+    glad_glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)load("glMemoryBarrier");
+    glad_glBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC)load("glBindImageTexture");
+    glad_glGetBufferSubData = (PFNGLGETBUFFERSUBDATAPROC)load("glGetBufferSubData");
 
     return 1;
 }
@@ -139,6 +243,7 @@ int gladLoadGLUserPtr(GLADuserptrloadfunc load, void* userptr) {
 
     glad_glClearColor = (PFNGLCLEARCOLORPROC)load(userptr, "glClearColor");
     glad_glClear = (PFNGLCLEARPROC)load(userptr, "glClear");
+    glad_glFinish = (PFNGLFINISHPROC)load(userptr, "glFinish");
     glad_glViewport = (PFNGLVIEWPORTPROC)load(userptr, "glViewport");
     glad_glEnable = (PFNGLENABLEPROC)load(userptr, "glEnable");
     glad_glDepthFunc = (PFNGLDEPTHFUNCPROC)load(userptr, "glDepthFunc");
@@ -178,6 +283,57 @@ int gladLoadGLUserPtr(GLADuserptrloadfunc load, void* userptr) {
     glad_glDrawElements = (PFNGLDRAWELEMENTSPROC)load(userptr, "glDrawElements");
     glad_glDrawArrays = (PFNGLDRAWARRAYSPROC)load(userptr, "glDrawArrays");
     glad_glGetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)load(userptr, "glGetAttribLocation");
+    glad_glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)load(userptr, "glDrawArraysInstanced");
+    glad_glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)load(userptr, "glDrawElementsInstanced");
+    glad_glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)load(userptr, "glVertexAttribDivisor");
+    glad_glDisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)load(userptr, "glDisableVertexAttribArray");
+    glad_glBufferSubData = (PFNGLBUFFERSUBDATAPROC)load(userptr, "glBufferSubData");
+    glad_glBindBufferBase = (PFNGLBINDBUFFERBASEPROC)load(userptr, "glBindBufferBase");
+    glad_glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)load(userptr, "glGetUniformBlockIndex");
+    glad_glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)load(userptr, "glUniformBlockBinding");
+    glad_glGetActiveUniform = (PFNGLGETACTIVEUNIFORMPROC)load(userptr, "glGetActiveUniform");
+    glad_glGenTextures = (PFNGLGENTEXTURESPROC)load(userptr, "glGenTextures");
+    glad_glDeleteTextures = (PFNGLDELETETEXTURESPROC)load(userptr, "glDeleteTextures");
+    glad_glBindTexture = (PFNGLBINDTEXTUREPROC)load(userptr, "glBindTexture");
+    glad_glActiveTexture = (PFNGLACTIVETEXTUREPROC)load(userptr, "glActiveTexture");
+    glad_glTexImage2D = (PFNGLTEXIMAGE2DPROC)load(userptr, "glTexImage2D");
+    glad_glTexImage3D = (PFNGLTEXIMAGE3DPROC)load(userptr, "glTexImage3D");
+    glad_glTexParameteri = (PFNGLTEXPARAMETERIPROC)load(userptr, "glTexParameteri");
+    glad_glTexParameterfv = (PFNGLTEXPARAMETERFVPROC)load(userptr, "glTexParameterfv");
+    glad_glGenerateMipmap = (PFNGLGENERATEMIPMAPPROC)load(userptr, "glGenerateMipmap");
+    glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)load(userptr, "glGenFramebuffers");
+    glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)load(userptr, "glDeleteFramebuffers");
+    glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)load(userptr, "glBindFramebuffer");
+    glad_glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)load(userptr, "glFramebufferTexture2D");
+    glad_glFramebufferTextureLayer = (PFNGLFRAMEBUFFERTEXTURELAYERPROC)load(userptr, "glFramebufferTextureLayer");
+    glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)load(userptr, "glCheckFramebufferStatus");
+    glad_glDrawBuffer = (PFNGLDRAWBUFFERPROC)load(userptr, "glDrawBuffer");
+    glad_glReadBuffer = (PFNGLREADBUFFERPROC)load(userptr, "glReadBuffer");
+    glad_glDisable = (PFNGLDISABLEPROC)load(userptr, "glDisable");
+    glad_glCullFace = (PFNGLCULLFACEPROC)load(userptr, "glCullFace");
+    glad_glPolygonOffset = (PFNGLPOLYGONOFFSETPROC)load(userptr, "glPolygonOffset");
+    glad_glGetIntegerv = (PFNGLGETINTEGERVPROC)load(userptr, "glGetIntegerv");
+    glad_glBlitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)load(userptr, "glBlitFramebuffer");
+    glad_glTexBuffer = (PFNGLTEXBUFFERPROC)load(userptr, "glTexBuffer");
+    glad_glDrawBuffers = (PFNGLDRAWBUFFERSPROC)load(userptr, "glDrawBuffers");
+    glad_glDepthMask = (PFNGLDEPTHMASKPROC)load(userptr, "glDepthMask");
+    glad_glGenQueries = (PFNGLGENQUERIESPROC)load(userptr, "glGenQueries");
+    glad_glDeleteQueries = (PFNGLDELETEQUERIESPROC)load(userptr, "glDeleteQueries");
+    glad_glBeginQuery = (PFNGLBEGINQUERYPROC)load(userptr, "glBeginQuery");
+    glad_glEndQuery = (PFNGLENDQUERYPROC)load(userptr, "glEndQuery");
+    glad_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load(userptr, "glGetQueryObjectiv");
+    glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load(userptr, "glGetQueryObjectui64v");
+    glad_glClearBufferfv = (PFNGLCLEARBUFFERFVPROC)load(userptr, "glClearBufferfv");
+    glad_glIsEnabled = (PFNGLISENABLEDPROC)load(userptr, "glIsEnabled");
+    glad_glGetBooleanv = (PFNGLGETBOOLEANVPROC)load(userptr, "glGetBooleanv");
+    glad_glDrawElementsBaseVertex = (PFNGLDRAWELEMENTSBASEVERTEXPROC)load(userptr, "glDrawElementsBaseVertex");
+    glad_glDrawElementsInstancedBaseVertex = (PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC)load(userptr, "glDrawElementsInstancedBaseVertex");
+    glad_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)load(userptr, "glCopyBufferSubData");
+    glad_glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)load(userptr, "glMultiDrawElementsIndirect");
+    glad_glDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC)load(userptr, "glDispatchCompute");
+    glad_glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)load(userptr, "glMemoryBarrier");
+    glad_glBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC)load(userptr, "glBindImageTexture");
+    glad_glGetBufferSubData = (PFNGLGETBUFFERSUBDATAPROC)load(userptr, "glGetBufferSubData");
 
     return 1;
 }
@@ -202,6 +358,12 @@ void glClear(GLbitfield mask) {
     }
 }
 
+void glFinish(void) {
+    if (glad_glFinish != NULL) {
+        glad_glFinish();
+    }
+}
+
 void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
     if (glad_glViewport != NULL) {
         glad_glViewport(x, y, width, height);
@@ -419,3 +581,325 @@ GLint glGetAttribLocation(GLuint program, const char* name) {
     return -1;
 }
 
+// 实例化绘制相关函数实现
+void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+    if (glad_glDrawArraysInstanced != NULL) {
+        glad_glDrawArraysInstanced(mode, first, count, instancecount);
+    }
+}
+
+void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount) {
+    if (glad_glDrawElementsInstanced != NULL) {
+        glad_glDrawElementsInstanced(mode, count, type, indices, instancecount);
+    }
+}
+
+void glVertexAttribDivisor(GLuint index, GLuint divisor) {
+    if (glad_glVertexAttribDivisor != NULL) {
+        glad_glVertexAttribDivisor(index, divisor);
+    }
+}
+
+void glDisableVertexAttribArray(GLuint index) {
+    if (glad_glDisableVertexAttribArray != NULL) {
+        glad_glDisableVertexAttribArray(index);
+    }
+}
+
+// Uniform Buffer Object函数实现
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    if (glad_glBufferSubData != NULL) {
+        glad_glBufferSubData(target, offset, size, data);
+    }
+}
+
+void glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    if (glad_glBindBufferBase != NULL) {
+        glad_glBindBufferBase(target, index, buffer);
+    }
+}
+
+GLuint glGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName) {
+    if (glad_glGetUniformBlockIndex != NULL) {
+        return glad_glGetUniformBlockIndex(program, uniformBlockName);
+    }
+    return 0xFFFFFFFFu;
+}
+
+void glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) {
+    if (glad_glUniformBlockBinding != NULL) {
+        glad_glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+    }
+}
+
+// Uniform反射函数实现
+void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+    if (glad_glGetActiveUniform != NULL) {
+        glad_glGetActiveUniform(program, index, bufSize, length, size, type, name);
+    }
+}
+
+// 纹理函数实现
+void glGenTextures(GLsizei n, GLuint* textures) {
+    if (glad_glGenTextures != NULL) {
+        glad_glGenTextures(n, textures);
+    }
+}
+
+void glDeleteTextures(GLsizei n, const GLuint* textures) {
+    if (glad_glDeleteTextures != NULL) {
+        glad_glDeleteTextures(n, textures);
+    }
+}
+
+void glBindTexture(GLenum target, GLuint texture) {
+    if (glad_glBindTexture != NULL) {
+        glad_glBindTexture(target, texture);
+    }
+}
+
+void glActiveTexture(GLenum texture) {
+    if (glad_glActiveTexture != NULL) {
+        glad_glActiveTexture(texture);
+    }
+}
+
+void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+    if (glad_glTexImage2D != NULL) {
+        glad_glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+    }
+}
+
+void glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) {
+    if (glad_glTexImage3D != NULL) {
+        glad_glTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+    }
+}
+
+void glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    if (glad_glTexParameteri != NULL) {
+        glad_glTexParameteri(target, pname, param);
+    }
+}
+
+void glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params) {
+    if (glad_glTexParameterfv != NULL) {
+        glad_glTexParameterfv(target, pname, params);
+    }
+}
+
+void glGenerateMipmap(GLenum target) {
+    if (glad_glGenerateMipmap != NULL) {
+        glad_glGenerateMipmap(target);
+    }
+}
+
+// 帧缓冲函数实现
+void glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    if (glad_glGenFramebuffers != NULL) {
+        glad_glGenFramebuffers(n, framebuffers);
+    }
+}
+
+void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    if (glad_glDeleteFramebuffers != NULL) {
+        glad_glDeleteFramebuffers(n, framebuffers);
+    }
+}
+
+void glBindFramebuffer(GLenum target, GLuint framebuffer) {
+    if (glad_glBindFramebuffer != NULL) {
+        glad_glBindFramebuffer(target, framebuffer);
+    }
+}
+
+void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+    if (glad_glFramebufferTexture2D != NULL) {
+        glad_glFramebufferTexture2D(target, attachment, textarget, texture, level);
+    }
+}
+
+void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer) {
+    if (glad_glFramebufferTextureLayer != NULL) {
+        glad_glFramebufferTextureLayer(target, attachment, texture, level, layer);
+    }
+}
+
+GLenum glCheckFramebufferStatus(GLenum target) {
+    if (glad_glCheckFramebufferStatus != NULL) {
+        return glad_glCheckFramebufferStatus(target);
+    }
+    return 0;
+}
+
+void glDrawBuffer(GLenum buf) {
+    if (glad_glDrawBuffer != NULL) {
+        glad_glDrawBuffer(buf);
+    }
+}
+
+void glReadBuffer(GLenum src) {
+    if (glad_glReadBuffer != NULL) {
+        glad_glReadBuffer(src);
+    }
+}
+
+// 光栅化状态函数实现
+void glDisable(GLenum cap) {
+    if (glad_glDisable != NULL) {
+        glad_glDisable(cap);
+    }
+}
+
+void glCullFace(GLenum mode) {
+    if (glad_glCullFace != NULL) {
+        glad_glCullFace(mode);
+    }
+}
+
+void glPolygonOffset(GLfloat factor, GLfloat units) {
+    if (glad_glPolygonOffset != NULL) {
+        glad_glPolygonOffset(factor, units);
+    }
+}
+
+void glGetIntegerv(GLenum pname, GLint* data) {
+    if (glad_glGetIntegerv != NULL) {
+        glad_glGetIntegerv(pname, data);
+    }
+}
+
+// 帧缓冲拷贝函数实现
+void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+    if (glad_glBlitFramebuffer != NULL) {
+        glad_glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    }
+}
+
+// 纹理缓冲函数实现
+void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {
+    if (glad_glTexBuffer != NULL) {
+        glad_glTexBuffer(target, internalformat, buffer);
+    }
+}
+
+// 多渲染目标函数实现
+void glDrawBuffers(GLsizei n, const GLenum* bufs) {
+    if (glad_glDrawBuffers != NULL) {
+        glad_glDrawBuffers(n, bufs);
+    }
+}
+
+void glDepthMask(GLboolean flag) {
+    if (glad_glDepthMask != NULL) {
+        glad_glDepthMask(flag);
+    }
+}
+
+// 计时查询函数实现
+void glGenQueries(GLsizei n, GLuint* ids) {
+    if (glad_glGenQueries != NULL) {
+        glad_glGenQueries(n, ids);
+    }
+}
+
+void glDeleteQueries(GLsizei n, const GLuint* ids) {
+    if (glad_glDeleteQueries != NULL) {
+        glad_glDeleteQueries(n, ids);
+    }
+}
+
+void glBeginQuery(GLenum target, GLuint id) {
+    if (glad_glBeginQuery != NULL) {
+        glad_glBeginQuery(target, id);
+    }
+}
+
+void glEndQuery(GLenum target) {
+    if (glad_glEndQuery != NULL) {
+        glad_glEndQuery(target);
+    }
+}
+
+void glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
+    if (glad_glGetQueryObjectiv != NULL) {
+        glad_glGetQueryObjectiv(id, pname, params);
+    }
+}
+
+void glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+    if (glad_glGetQueryObjectui64v != NULL) {
+        glad_glGetQueryObjectui64v(id, pname, params);
+    }
+}
+
+// 状态查询函数实现
+void glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat *value) {
+    if (glad_glClearBufferfv != NULL) {
+        glad_glClearBufferfv(buffer, drawbuffer, value);
+    }
+}
+
+GLboolean glIsEnabled(GLenum cap) {
+    if (glad_glIsEnabled != NULL) {
+        return glad_glIsEnabled(cap);
+    }
+    return 0;
+}
+
+void glGetBooleanv(GLenum pname, GLboolean *data) {
+    if (glad_glGetBooleanv != NULL) {
+        glad_glGetBooleanv(pname, data);
+    }
+}
+
+// 基准顶点绘制函数实现
+void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex) {
+    if (glad_glDrawElementsBaseVertex != NULL) {
+        glad_glDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+    }
+}
+
+void glDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex) {
+    if (glad_glDrawElementsInstancedBaseVertex != NULL) {
+        glad_glDrawElementsInstancedBaseVertex(mode, count, type, indices, instancecount, basevertex);
+    }
+}
+
+void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) {
+    if (glad_glCopyBufferSubData != NULL) {
+        glad_glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+    }
+}
+
+// 间接绘制函数实现
+void glMultiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride) {
+    if (glad_glMultiDrawElementsIndirect != NULL) {
+        glad_glMultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+    }
+}
+
+// 计算着色器函数实现
+void glDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z) {
+    if (glad_glDispatchCompute != NULL) {
+        glad_glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+    }
+}
+
+void glMemoryBarrier(GLbitfield barriers) {
+    if (glad_glMemoryBarrier != NULL) {
+        glad_glMemoryBarrier(barriers);
+    }
+}
+
+void glBindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format) {
+    if (glad_glBindImageTexture != NULL) {
+        glad_glBindImageTexture(unit, texture, level, layered, layer, access, format);
+    }
+}
+
+void glGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void *data) {
+    if (glad_glGetBufferSubData != NULL) {
+        glad_glGetBufferSubData(target, offset, size, data);
+    }
+}
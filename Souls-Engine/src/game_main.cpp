@@ -9,6 +9,7 @@
 #include "core/GameManager.h"
 #include "core/Light.h"
 #include "core/LightManager.h"
+#include "core/FrameUniforms.h"
 #include "core/ImGuiSystem.h"
 #include <GLFW/glfw3.h>
 #include <imgui.h>
@@ -107,10 +108,10 @@ int main() {
     // 设置视口
     glViewport(0, 0, window.GetWidth(), window.GetHeight());
 
-    // 加载Shader
+    // 加载Shader（场景不渲染阴影，使用去掉阴影采样的变体）
     SoulsEngine::Shader shader;
     std::cout << "从以下路径加载Shader: " << vertexPath << " 和 " << fragmentPath << std::endl;
-    if (!shader.LoadFromFiles(vertexPath, fragmentPath)) {
+    if (!shader.LoadFromFiles(vertexPath, fragmentPath, { { "SHADOWS", "0" } })) {
         std::cerr << "错误: Shader编译/链接失败！" << std::endl;
         window.Shutdown();
         std::cout << "按Enter键退出..." << std::endl;
@@ -153,6 +154,15 @@ int main() {
     }
     std::cout << "光源创建完成" << std::endl;
 
+    // 每帧相机和光源数据（uniform缓冲，所有着色器共享）
+    SoulsEngine::FrameUniforms frameUniforms;
+    if (!frameUniforms.Initialize()) {
+        std::cerr << "错误: 每帧uniform缓冲创建失败！" << std::endl;
+        window.Shutdown();
+        std::cin.get();
+        return -1;
+    }
+
     // 创建游戏管理器
     SoulsEngine::GameManager gameManager(&objectManager, &camera);
     gameManager.Initialize();
@@ -227,7 +237,7 @@ int main() {
         gameManager.Update(deltaTime);
 
         // 更新相机位置（跟随玩家，但保持一定距离）
-        auto playerNode = objectManager.FindNode("Player");
+        SoulsEngine::SceneNode* playerNode = objectManager.GetNode(gameManager.GetPlayerHandle());
         if (playerNode) {
             glm::vec3 playerPos = playerNode->GetPosition();
             // 相机跟随玩家，保持一定距离和高度
@@ -245,43 +255,19 @@ int main() {
         glm::mat4 view = camera.GetViewMatrix();
         glm::mat4 projection = camera.GetProjectionMatrix(aspectRatio);
         
-        // 传递矩阵到Shader
-        shader.SetMat4("view", glm::value_ptr(view));
-        shader.SetMat4("projection", glm::value_ptr(projection));
-        
         // 更新场景
         objectManager.Update();
         
         // 设置光照参数 - 支持多光源（符合标准Phong光照模型）
-        glm::vec3 viewPos = camera.GetPosition();
-        auto lights = lightManager.GetLights();
-        int numLights = std::min(static_cast<int>(lights.size()), 8);  // 最多8个光源
-        
-        shader.SetInt("numLights", numLights);
-        // 全局环境光（独立于光源，不受距离衰减影响）
-        shader.SetVec3("globalAmbient", 0.2f, 0.2f, 0.2f);  // I_a: 全局环境光强度
-        shader.SetVec3("viewPos", viewPos.x, viewPos.y, viewPos.z);
-        
-        // 设置每个光源的属性
-        for (int i = 0; i < numLights; i++) {
-            auto light = lights[i];
-            glm::vec3 lightPos = light->GetPosition();
-            glm::vec3 lightColor = light->GetColor();
-            float lightIntensity = light->GetIntensity();
-            
-            std::string lightPrefix = "lights[" + std::to_string(i) + "].";
-            shader.SetVec3(lightPrefix + "position", lightPos.x, lightPos.y, lightPos.z);
-            shader.SetVec3(lightPrefix + "color", lightColor.r, lightColor.g, lightColor.b);
-            shader.SetFloat(lightPrefix + "intensity", lightIntensity);
-            
-            // 设置距离衰减参数
-            shader.SetFloat(lightPrefix + "constant", 1.0f);
-            shader.SetFloat(lightPrefix + "linear", 0.09f);
-            shader.SetFloat(lightPrefix + "quadratic", 0.032f);
-        }
+        // 相机、全局环境光和光源数组一次写入uniform缓冲（最多8个光源，衰减参数 1, 0.09, 0.032）
+        frameUniforms.SetCamera(view, projection, camera.GetPosition());
+        frameUniforms.SetLights(lightManager.GetLights());
+        frameUniforms.Upload();
 
         // 渲染场景
-        objectManager.Render(&shader);
+        // 视锥体外的节点不提交绘制
+        SoulsEngine::ViewFrustum frustum(view, projection);
+        objectManager.Render(&shader, view, &frustum);
 
         // 渲染游戏UI（使用ImGui）
         ImGui_ImplOpenGL3_NewFrame();
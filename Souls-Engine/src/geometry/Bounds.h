@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+
+namespace SoulsEngine {
+
+// 轴对齐包围盒，以中心和半边长表示（视锥体测试和变换都直接使用这种形式）
+// 半边长为负表示空包围盒
+struct BoundingBox {
+    glm::vec3 center = glm::vec3(0.0f);
+    glm::vec3 extents = glm::vec3(-FLT_MAX);
+
+    static BoundingBox FromMinMax(const glm::vec3& minPoint, const glm::vec3& maxPoint) {
+        BoundingBox box;
+        box.center = (minPoint + maxPoint) * 0.5f;
+        box.extents = (maxPoint - minPoint) * 0.5f;
+        return box;
+    }
+
+    bool IsValid() const { return extents.x >= 0.0f && extents.y >= 0.0f && extents.z >= 0.0f; }
+    glm::vec3 GetMin() const { return center - extents; }
+    glm::vec3 GetMax() const { return center + extents; }
+
+    // 经过仿射变换后的包围盒（Arvo方法：中心直接变换，半边长乘以矩阵元素的绝对值）
+    BoundingBox Transform(const glm::mat4& matrix) const {
+        if (!IsValid()) return *this;
+        BoundingBox result;
+        result.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+        for (int row = 0; row < 3; ++row) {
+            result.extents[row] = std::abs(matrix[0][row]) * extents.x
+                                + std::abs(matrix[1][row]) * extents.y
+                                + std::abs(matrix[2][row]) * extents.z;
+        }
+        return result;
+    }
+};
+
+// 包围球
+struct BoundingSphere {
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = -1.0f;
+
+    bool IsValid() const { return radius >= 0.0f; }
+};
+
+} // namespace SoulsEngine
@@ -5,43 +5,47 @@
 namespace SoulsEngine {
 
 Cone::Cone(float radius, float height, int sectors, const glm::vec3& color) {
-    std::vector<float> vertices;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
     float h = height * 0.5f;
     float sectorStep = 2.0f * 3.14159265359f / sectors;
+    const glm::vec3 down(0.0f, -1.0f, 0.0f);
 
-    // 侧面
+    // 侧面法线：在(半径方向, y)平面内垂直于母线，即 (height, radius) 方向
+    auto sideNormal = [&](float angle) {
+        return glm::normalize(glm::vec3(height * cosf(angle), radius, height * sinf(angle)));
+    };
+
+    // 顶点：侧面底圈、每个扇区一个锥顶（法线取扇区中线方向，锥顶处法线不连续）、底面圈、底面中心
+    const uint32_t sideBottom = 0;
+    for (int i = 0; i < sectors; ++i) {
+        float angle = i * sectorStep;
+        AddVertex(vertices, glm::vec3(radius * cosf(angle), -h, radius * sinf(angle)), sideNormal(angle), color);
+    }
+    const uint32_t apex = static_cast<uint32_t>(vertices.size());
     for (int i = 0; i < sectors; ++i) {
-        float angle1 = i * sectorStep;
-        float angle2 = (i + 1) * sectorStep;
-
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
-
-        // 三角形（从顶点到底边）
-        vertices.insert(vertices.end(), { 0.0f,  h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
+        float angle = (i + 0.5f) * sectorStep;
+        AddVertex(vertices, glm::vec3(0.0f, h, 0.0f), sideNormal(angle), color);
     }
+    const uint32_t capBottom = static_cast<uint32_t>(vertices.size());
+    for (int i = 0; i < sectors; ++i) {
+        float angle = i * sectorStep;
+        AddVertex(vertices, glm::vec3(radius * cosf(angle), -h, radius * sinf(angle)), down, color);
+    }
+    uint32_t bottomCenter = AddVertex(vertices, glm::vec3(0.0f, -h, 0.0f), down, color);
 
-    // 底面
     for (int i = 0; i < sectors; ++i) {
-        float angle1 = i * sectorStep;
-        float angle2 = (i + 1) * sectorStep;
+        uint32_t i1 = static_cast<uint32_t>(i);
+        uint32_t i2 = static_cast<uint32_t>((i + 1) % sectors);
 
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
+        // 侧面（从锥顶到底边）
+        indices.insert(indices.end(), { apex + i1, sideBottom + i1, sideBottom + i2 });
 
-        vertices.insert(vertices.end(), { 0.0f, -h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
+        // 底面
+        indices.insert(indices.end(), { bottomCenter, capBottom + i2, capBottom + i1 });
     }
 
-    SetupMesh(vertices);
+    SetupMesh(vertices, indices);
 }
 
 }
-
@@ -6,70 +6,37 @@ namespace SoulsEngine {
 
 Cube::Cube(float size, const glm::vec3& color) {
     float s = size * 0.5f; // 半边长
-    std::vector<float> vertices;
-
-    // 前面 (z = +s, 法线指向 +z)
-    // 第一个三角形：左下 -> 右下 -> 右上
-    vertices.insert(vertices.end(), { -s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s,  s, color.r, color.g, color.b });
-    // 第二个三角形：左下 -> 右上 -> 左上
-    vertices.insert(vertices.end(), { -s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s,  s, color.r, color.g, color.b });
-
-    // 后面 (z = -s, 法线指向 -z)
-    // 第一个三角形：右下 -> 左下 -> 左上
-    vertices.insert(vertices.end(), {  s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s, -s, color.r, color.g, color.b });
-    // 第二个三角形：右下 -> 左上 -> 右上
-    vertices.insert(vertices.end(), {  s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s, -s, color.r, color.g, color.b });
-
-    // 右面 (x = +s, 法线指向 +x)
-    // 第一个三角形：前下 -> 后下 -> 后上
-    vertices.insert(vertices.end(), {  s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s, -s, color.r, color.g, color.b });
-    // 第二个三角形：前下 -> 后上 -> 前上
-    vertices.insert(vertices.end(), {  s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s,  s, color.r, color.g, color.b });
-
-    // 左面 (x = -s, 法线指向 -x)
-    // 第一个三角形：后下 -> 前下 -> 前上
-    vertices.insert(vertices.end(), { -s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s,  s, color.r, color.g, color.b });
-    // 第二个三角形：后下 -> 前上 -> 后上
-    vertices.insert(vertices.end(), { -s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s, -s, color.r, color.g, color.b });
-
-    // 上面 (y = +s, 法线指向 +y)
-    // 第一个三角形：前左 -> 前右 -> 后右
-    vertices.insert(vertices.end(), { -s,  s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s, -s, color.r, color.g, color.b });
-    // 第二个三角形：前左 -> 后右 -> 后左
-    vertices.insert(vertices.end(), { -s,  s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s,  s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s,  s, -s, color.r, color.g, color.b });
-
-    // 下面 (y = -s, 法线指向 -y)
-    // 第一个三角形：后左 -> 后右 -> 前右
-    vertices.insert(vertices.end(), { -s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s, -s,  s, color.r, color.g, color.b });
-    // 第二个三角形：后左 -> 前右 -> 前左
-    vertices.insert(vertices.end(), { -s, -s, -s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), {  s, -s,  s, color.r, color.g, color.b });
-    vertices.insert(vertices.end(), { -s, -s,  s, color.r, color.g, color.b });
-
-    SetupMesh(vertices);
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    // 角点编号的三个二进制位依次表示 x、y、z 取正
+    auto corner = [s](uint32_t index) {
+        return glm::vec3((index & 1) ? s : -s, (index & 2) ? s : -s, (index & 4) ? s : -s);
+    };
+
+    // 每个面4个顶点（相邻面法线不同，角点不能共用），两个三角形，逆时针为正面
+    struct Face {
+        uint32_t corners[4];
+        glm::vec3 normal;
+    };
+    const Face faces[6] = {
+        { { 4, 5, 7, 6 }, glm::vec3( 0.0f,  0.0f,  1.0f) },  // 前面 (z = +s)：左下、右下、右上、左上
+        { { 1, 0, 2, 3 }, glm::vec3( 0.0f,  0.0f, -1.0f) },  // 后面 (z = -s)：右下、左下、左上、右上
+        { { 5, 1, 3, 7 }, glm::vec3( 1.0f,  0.0f,  0.0f) },  // 右面 (x = +s)：前下、后下、后上、前上
+        { { 0, 4, 6, 2 }, glm::vec3(-1.0f,  0.0f,  0.0f) },  // 左面 (x = -s)：后下、前下、前上、后上
+        { { 6, 7, 3, 2 }, glm::vec3( 0.0f,  1.0f,  0.0f) },  // 上面 (y = +s)：前左、前右、后右、后左
+        { { 0, 1, 5, 4 }, glm::vec3( 0.0f, -1.0f,  0.0f) },  // 下面 (y = -s)：后左、后右、前右、前左
+    };
+    for (const auto& face : faces) {
+        uint32_t base = static_cast<uint32_t>(vertices.size());
+        for (uint32_t index : face.corners) {
+            AddVertex(vertices, corner(index), face.normal, color);
+        }
+        indices.insert(indices.end(), { base, base + 1, base + 2 });
+        indices.insert(indices.end(), { base, base + 2, base + 3 });
+    }
+
+    SetupMesh(vertices, indices);
 }
 
 }
-
@@ -5,63 +5,56 @@
 namespace SoulsEngine {
 
 Cylinder::Cylinder(float radius, float height, int sectors, const glm::vec3& color) {
-    std::vector<float> vertices;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
     float h = height * 0.5f;
     float sectorStep = 2.0f * 3.14159265359f / sectors;
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
+    const glm::vec3 down(0.0f, -1.0f, 0.0f);
 
-    // 侧面
+    // 顶点：侧面底圈、侧面顶圈（法线沿半径方向，侧面平滑）、顶面圈、底面圈、顶面中心、底面中心
+    // 侧面和端面在边缘处法线不同，所以边缘顶点各自独立
+    const uint32_t sideBottom = 0;
     for (int i = 0; i < sectors; ++i) {
-        float angle1 = i * sectorStep;
-        float angle2 = (i + 1) * sectorStep;
-
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
-
-        // 第一个三角形
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
-
-        // 第二个三角形
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2,  h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
+        float angle = i * sectorStep;
+        glm::vec3 normal(cosf(angle), 0.0f, sinf(angle));
+        AddVertex(vertices, glm::vec3(radius * normal.x, -h, radius * normal.z), normal, color);
     }
-
-    // 顶面
+    const uint32_t sideTop = static_cast<uint32_t>(vertices.size());
     for (int i = 0; i < sectors; ++i) {
-        float angle1 = i * sectorStep;
-        float angle2 = (i + 1) * sectorStep;
-
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
-
-        vertices.insert(vertices.end(), { 0.0f,  h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2,  h, z2, color.r, color.g, color.b });
+        float angle = i * sectorStep;
+        glm::vec3 normal(cosf(angle), 0.0f, sinf(angle));
+        AddVertex(vertices, glm::vec3(radius * normal.x, h, radius * normal.z), normal, color);
     }
+    const uint32_t capTop = static_cast<uint32_t>(vertices.size());
+    for (int i = 0; i < sectors; ++i) {
+        float angle = i * sectorStep;
+        AddVertex(vertices, glm::vec3(radius * cosf(angle), h, radius * sinf(angle)), up, color);
+    }
+    const uint32_t capBottom = static_cast<uint32_t>(vertices.size());
+    for (int i = 0; i < sectors; ++i) {
+        float angle = i * sectorStep;
+        AddVertex(vertices, glm::vec3(radius * cosf(angle), -h, radius * sinf(angle)), down, color);
+    }
+    uint32_t topCenter = AddVertex(vertices, glm::vec3(0.0f, h, 0.0f), up, color);
+    uint32_t bottomCenter = AddVertex(vertices, glm::vec3(0.0f, -h, 0.0f), down, color);
 
-    // 底面
     for (int i = 0; i < sectors; ++i) {
-        float angle1 = i * sectorStep;
-        float angle2 = (i + 1) * sectorStep;
+        uint32_t i1 = static_cast<uint32_t>(i);
+        uint32_t i2 = static_cast<uint32_t>((i + 1) % sectors);
+
+        // 侧面两个三角形
+        indices.insert(indices.end(), { sideBottom + i1, sideBottom + i2, sideTop + i1 });
+        indices.insert(indices.end(), { sideBottom + i2, sideTop + i2, sideTop + i1 });
 
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
+        // 顶面
+        indices.insert(indices.end(), { topCenter, capTop + i1, capTop + i2 });
 
-        vertices.insert(vertices.end(), { 0.0f, -h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
+        // 底面
+        indices.insert(indices.end(), { bottomCenter, capBottom + i2, capBottom + i1 });
     }
 
-    SetupMesh(vertices);
+    SetupMesh(vertices, indices);
 }
 
 }
-
@@ -5,27 +5,26 @@
 namespace SoulsEngine {
 
 Disk::Disk(float radius, int sectors, const glm::vec3& color) {
-    std::vector<float> vertices;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
     float sectorStep = 2.0f * 3.14159265359f / sectors;
 
-    // 创建圆盘（在XY平面上，法线指向Z轴正方向）
+    // 创建圆盘（在XY平面上，法线指向Z轴正方向）：中心点 + 一圈边缘点
+    const glm::vec3 normal(0.0f, 0.0f, 1.0f);
+    uint32_t center = AddVertex(vertices, glm::vec3(0.0f), normal, color);
     for (int i = 0; i < sectors; ++i) {
-        float angle1 = i * sectorStep;
-        float angle2 = (i + 1) * sectorStep;
-
-        float x1 = radius * cosf(angle1);
-        float y1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float y2 = radius * sinf(angle2);
+        float angle = i * sectorStep;
+        AddVertex(vertices, glm::vec3(radius * cosf(angle), radius * sinf(angle), 0.0f), normal, color);
+    }
 
-        // 每个三角形：中心点 + 两个边缘点
-        vertices.insert(vertices.end(), { 0.0f, 0.0f, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1, y1, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, y2, 0.0f, color.r, color.g, color.b });
+    // 每个三角形：中心点 + 两个相邻的边缘点
+    for (int i = 0; i < sectors; ++i) {
+        uint32_t rim1 = center + 1 + i;
+        uint32_t rim2 = center + 1 + (i + 1) % sectors;
+        indices.insert(indices.end(), { center, rim1, rim2 });
     }
 
-    SetupMesh(vertices);
+    SetupMesh(vertices, indices);
 }
 
 } // namespace SoulsEngine
-
@@ -5,68 +5,60 @@
 namespace SoulsEngine {
 
 Frustum::Frustum(int sides, float topRadius, float bottomRadius, float height, const glm::vec3& color) {
-    std::vector<float> vertices;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
     float h = height * 0.5f;
     float angleStep = 2.0f * 3.14159265359f / sides;
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
+    const glm::vec3 down(0.0f, -1.0f, 0.0f);
 
-    // 侧面
-    for (int i = 0; i < sides; ++i) {
-        float angle1 = i * angleStep;
-        float angle2 = (i + 1) * angleStep;
-
-        float x1t = topRadius * cosf(angle1);
-        float z1t = topRadius * sinf(angle1);
-        float x2t = topRadius * cosf(angle2);
-        float z2t = topRadius * sinf(angle2);
-
-        float x1b = bottomRadius * cosf(angle1);
-        float z1b = bottomRadius * sinf(angle1);
-        float x2b = bottomRadius * cosf(angle2);
-        float z2b = bottomRadius * sinf(angle2);
+    auto ringPoint = [&](int i, float ringRadius, float y) {
+        float angle = i * angleStep;
+        return glm::vec3(ringRadius * cosf(angle), y, ringRadius * sinf(angle));
+    };
 
-        // 第一个三角形
-        vertices.insert(vertices.end(), { x1b, -h, z1b, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2b, -h, z2b, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1t,  h, z1t, color.r, color.g, color.b });
+    // 侧面法线：侧面在中线方向上经过底边中点(底面边心距, -h)和顶边中点(顶面边心距, h)，
+    // 在(中线方向, y)平面内与之垂直的方向为 (height, 底面边心距 - 顶面边心距)
+    float halfStepCos = cosf(angleStep * 0.5f);
+    float apothemDelta = (bottomRadius - topRadius) * halfStepCos;
 
-        // 第二个三角形
-        vertices.insert(vertices.end(), { x2b, -h, z2b, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2t,  h, z2t, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1t,  h, z1t, color.r, color.g, color.b });
+    // 侧面：每个面4个独立顶点（棱边处法线不连续）
+    for (int i = 0; i < sides; ++i) {
+        float midAngle = (i + 0.5f) * angleStep;
+        glm::vec3 normal = glm::normalize(glm::vec3(height * cosf(midAngle), apothemDelta, height * sinf(midAngle)));
+        uint32_t b1 = AddVertex(vertices, ringPoint(i, bottomRadius, -h), normal, color);
+        uint32_t b2 = AddVertex(vertices, ringPoint((i + 1) % sides, bottomRadius, -h), normal, color);
+        uint32_t t2 = AddVertex(vertices, ringPoint((i + 1) % sides, topRadius, h), normal, color);
+        uint32_t t1 = AddVertex(vertices, ringPoint(i, topRadius, h), normal, color);
+
+        indices.insert(indices.end(), { b1, b2, t1 });
+        indices.insert(indices.end(), { b2, t2, t1 });
     }
 
-    // 顶面
+    // 端面：顶面多边形、底面多边形、顶面中心、底面中心
+    const uint32_t capTop = static_cast<uint32_t>(vertices.size());
     for (int i = 0; i < sides; ++i) {
-        float angle1 = i * angleStep;
-        float angle2 = (i + 1) * angleStep;
-
-        float x1 = topRadius * cosf(angle1);
-        float z1 = topRadius * sinf(angle1);
-        float x2 = topRadius * cosf(angle2);
-        float z2 = topRadius * sinf(angle2);
-
-        vertices.insert(vertices.end(), { 0.0f,  h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2,  h, z2, color.r, color.g, color.b });
+        AddVertex(vertices, ringPoint(i, topRadius, h), up, color);
+    }
+    const uint32_t capBottom = static_cast<uint32_t>(vertices.size());
+    for (int i = 0; i < sides; ++i) {
+        AddVertex(vertices, ringPoint(i, bottomRadius, -h), down, color);
     }
+    uint32_t topCenter = AddVertex(vertices, glm::vec3(0.0f, h, 0.0f), up, color);
+    uint32_t bottomCenter = AddVertex(vertices, glm::vec3(0.0f, -h, 0.0f), down, color);
 
-    // 底面
     for (int i = 0; i < sides; ++i) {
-        float angle1 = i * angleStep;
-        float angle2 = (i + 1) * angleStep;
+        uint32_t i1 = static_cast<uint32_t>(i);
+        uint32_t i2 = static_cast<uint32_t>((i + 1) % sides);
 
-        float x1 = bottomRadius * cosf(angle1);
-        float z1 = bottomRadius * sinf(angle1);
-        float x2 = bottomRadius * cosf(angle2);
-        float z2 = bottomRadius * sinf(angle2);
+        // 顶面
+        indices.insert(indices.end(), { topCenter, capTop + i1, capTop + i2 });
 
-        vertices.insert(vertices.end(), { 0.0f, -h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
+        // 底面
+        indices.insert(indices.end(), { bottomCenter, capBottom + i2, capBottom + i1 });
     }
 
-    SetupMesh(vertices);
+    SetupMesh(vertices, indices);
 }
 
 }
-
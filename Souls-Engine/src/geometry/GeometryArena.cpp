@@ -0,0 +1,272 @@
+#include "GeometryArena.h"
+#include <algorithm>
+#include <iostream>
+
+namespace SoulsEngine {
+
+// ---------------------------------------------------------------------------
+// RangeAllocator
+// ---------------------------------------------------------------------------
+
+RangeAllocator::RangeAllocator(uint32_t capacity) {
+    Grow(capacity);
+}
+
+bool RangeAllocator::Allocate(uint32_t size, uint32_t& offset) {
+    if (size == 0) return false;
+
+    for (auto it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it) {
+        if (it->second < size) continue;
+
+        offset = it->first;
+        const uint32_t remaining = it->second - size;
+        m_freeBlocks.erase(it);
+        if (remaining > 0) {
+            m_freeBlocks.emplace(offset + size, remaining);
+        }
+        m_used += size;
+        return true;
+    }
+    return false;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size) {
+    if (size == 0) return;
+    m_used -= size;
+
+    // 与后一个空闲区间合并
+    auto next = m_freeBlocks.lower_bound(offset);
+    if (next != m_freeBlocks.end() && offset + size == next->first) {
+        size += next->second;
+        next = m_freeBlocks.erase(next);
+    }
+
+    // 与前一个空闲区间合并
+    if (next != m_freeBlocks.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+    m_freeBlocks.emplace(offset, size);
+}
+
+void RangeAllocator::Grow(uint32_t newCapacity) {
+    if (newCapacity <= m_capacity) return;
+
+    const uint32_t oldCapacity = m_capacity;
+    m_capacity = newCapacity;
+    // 新增部分作为空闲区间加入（Free负责与末尾的空闲区间合并），不计入已用量
+    m_used += newCapacity - oldCapacity;
+    Free(oldCapacity, newCapacity - oldCapacity);
+}
+
+uint32_t RangeAllocator::GetLargestFreeBlock() const {
+    uint32_t largest = 0;
+    for (const auto& block : m_freeBlocks) {
+        largest = std::max(largest, block.second);
+    }
+    return largest;
+}
+
+// ---------------------------------------------------------------------------
+// GeometryArena
+// ---------------------------------------------------------------------------
+
+namespace {
+    // 索引区间的分配单位（32位索引要求4字节对齐）
+    constexpr uint32_t IndexUnit = 4;
+}
+
+GeometryArena& GeometryArena::Get() {
+    static GeometryArena instance;
+    return instance;
+}
+
+bool GeometryArena::CreatePool(Pool& pool, const VertexLayout& layout) {
+    pool.layout = &layout;
+    pool.vertices = RangeAllocator(InitialVertexCount);
+    pool.indices = RangeAllocator(InitialIndexBytes / IndexUnit);
+
+    glGenBuffers(1, &pool.vertexBuffer);
+    glGenBuffers(1, &pool.indexBuffer);
+    glGenVertexArrays(1, &pool.vao);
+    glGenVertexArrays(1, &pool.instancedVAO);
+    if (pool.vertexBuffer == 0 || pool.indexBuffer == 0 || pool.vao == 0 || pool.instancedVAO == 0) {
+        std::cerr << "Failed to create geometry arena buffers" << std::endl;
+        return false;
+    }
+
+    // 通过拷贝目标上传，不影响当前VAO的索引缓冲绑定
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vertexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(InitialVertexCount) * layout.GetStride(),
+                 nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.indexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(InitialIndexBytes), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    BindPoolBuffers(pool);
+    return true;
+}
+
+void GeometryArena::DestroyPool(Pool& pool) {
+    if (pool.vao != 0) glDeleteVertexArrays(1, &pool.vao);
+    if (pool.instancedVAO != 0) glDeleteVertexArrays(1, &pool.instancedVAO);
+    if (pool.vertexBuffer != 0) glDeleteBuffers(1, &pool.vertexBuffer);
+    if (pool.indexBuffer != 0) glDeleteBuffers(1, &pool.indexBuffer);
+    pool = Pool();
+}
+
+void GeometryArena::GrowBuffer(GLuint& buffer, uint32_t oldBytes, uint32_t newBytes) {
+    GLuint grown = 0;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newBytes), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(oldBytes));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    // 旧缓冲仍被VAO引用，BindPoolBuffers重新指向后才真正释放
+    glDeleteBuffers(1, &buffer);
+    buffer = grown;
+}
+
+void GeometryArena::BindPoolBuffers(const Pool& pool) {
+    // 实例化VAO的逐实例属性由渲染队列每批设置，这里只设置顶点属性和索引缓冲
+    for (GLuint vao : { pool.vao, pool.instancedVAO }) {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, pool.vertexBuffer);
+        pool.layout->Apply();
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.indexBuffer);
+    }
+
+    // 先解绑VAO，避免把索引缓冲从VAO上解除
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::AllocateGrowing(RangeAllocator& allocator, uint32_t size, uint32_t& offset) {
+    while (!allocator.Allocate(size, offset)) {
+        allocator.Grow(std::max(allocator.GetCapacity() * 2, size));
+    }
+}
+
+bool GeometryArena::Allocate(const VertexLayout& layout, const void* vertexData, uint32_t vertexCount,
+                             const void* indexData, uint32_t indexBytes, GeometryAllocation& allocation) {
+    Free(allocation);
+    if (vertexCount == 0) return false;
+
+    Pool& pool = m_pools[static_cast<int>(layout.GetFormat())];
+    if (pool.vao == 0 && !CreatePool(pool, layout)) {
+        // 只释放这个池创建到一半的对象，其他格式的池仍被存活的网格引用
+        DestroyPool(pool);
+        return false;
+    }
+
+    const uint32_t stride = layout.GetStride();
+    const uint32_t oldVertexCapacity = pool.vertices.GetCapacity();
+    const uint32_t oldIndexCapacity = pool.indices.GetCapacity();
+    const uint32_t indexUnits = (indexBytes + IndexUnit - 1) / IndexUnit;
+
+    uint32_t vertexOffset = 0;
+    uint32_t indexUnitOffset = 0;
+    AllocateGrowing(pool.vertices, vertexCount, vertexOffset);
+    if (indexUnits > 0) {
+        AllocateGrowing(pool.indices, indexUnits, indexUnitOffset);
+    }
+
+    // 扩容时拷贝已有数据到新缓冲，再重新指向VAO
+    const bool verticesGrown = pool.vertices.GetCapacity() != oldVertexCapacity;
+    const bool indicesGrown = pool.indices.GetCapacity() != oldIndexCapacity;
+    if (verticesGrown) {
+        GrowBuffer(pool.vertexBuffer, oldVertexCapacity * stride, pool.vertices.GetCapacity() * stride);
+        ++m_growths;
+    }
+    if (indicesGrown) {
+        GrowBuffer(pool.indexBuffer, oldIndexCapacity * IndexUnit, pool.indices.GetCapacity() * IndexUnit);
+        ++m_growths;
+    }
+    if (verticesGrown || indicesGrown) {
+        BindPoolBuffers(pool);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vertexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(vertexOffset) * stride,
+                    static_cast<GLsizeiptr>(vertexCount) * stride, vertexData);
+    if (indexBytes > 0) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, pool.indexBuffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(indexUnitOffset) * IndexUnit,
+                        static_cast<GLsizeiptr>(indexBytes), indexData);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    allocation.format = layout.GetFormat();
+    allocation.vertexOffset = vertexOffset;
+    allocation.vertexCount = vertexCount;
+    allocation.indexOffset = indexUnitOffset * IndexUnit;
+    allocation.indexBytes = indexBytes;
+    ++pool.allocations;
+    return true;
+}
+
+void GeometryArena::Free(GeometryAllocation& allocation) {
+    if (!allocation.IsValid()) return;
+
+    Pool& pool = m_pools[static_cast<int>(allocation.format)];
+    if (pool.vao != 0) {
+        pool.vertices.Free(allocation.vertexOffset, allocation.vertexCount);
+        pool.indices.Free(allocation.indexOffset / IndexUnit, (allocation.indexBytes + IndexUnit - 1) / IndexUnit);
+        --pool.allocations;
+    }
+    allocation = GeometryAllocation();
+}
+
+bool GeometryArena::Read(const GeometryAllocation& allocation, std::vector<uint8_t>& vertexData,
+                         std::vector<uint8_t>& indexData) const {
+    const Pool& pool = m_pools[static_cast<int>(allocation.format)];
+    if (!allocation.IsValid() || pool.vao == 0) {
+        return false;
+    }
+
+    const uint32_t stride = pool.layout->GetStride();
+    vertexData.resize(static_cast<size_t>(allocation.vertexCount) * stride);
+    indexData.resize(allocation.indexBytes);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, pool.vertexBuffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(allocation.vertexOffset) * stride,
+                       static_cast<GLsizeiptr>(vertexData.size()), vertexData.data());
+    if (allocation.indexBytes > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, pool.indexBuffer);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(allocation.indexOffset),
+                           static_cast<GLsizeiptr>(allocation.indexBytes), indexData.data());
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    return true;
+}
+
+void GeometryArena::Shutdown() {
+    for (Pool& pool : m_pools) {
+        DestroyPool(pool);
+    }
+}
+
+GeometryArenaStats GeometryArena::GetStats() const {
+    GeometryArenaStats stats;
+    for (const Pool& pool : m_pools) {
+        if (pool.vao == 0) continue;
+        const uint32_t stride = pool.layout->GetStride();
+        stats.allocations += pool.allocations;
+        stats.vertexBytesUsed += pool.vertices.GetUsed() * stride;
+        stats.vertexBytesCapacity += pool.vertices.GetCapacity() * stride;
+        stats.indexBytesUsed += pool.indices.GetUsed() * IndexUnit;
+        stats.indexBytesCapacity += pool.indices.GetCapacity() * IndexUnit;
+        stats.freeBlocks += pool.vertices.GetFreeBlockCount() + pool.indices.GetFreeBlockCount();
+    }
+    stats.growths = m_growths;
+    return stats;
+}
+
+} // namespace SoulsEngine
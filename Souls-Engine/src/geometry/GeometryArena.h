@@ -0,0 +1,138 @@
+#pragma once
+
+#include "VertexLayout.h"
+#include <glad/glad.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 区间分配器 - 在[0, capacity)中分配连续区间（单位由调用方决定），
+// 空闲区间按起点存放，首次适配分配，释放时与相邻空闲区间合并
+class RangeAllocator {
+public:
+    explicit RangeAllocator(uint32_t capacity = 0);
+
+    // 分配size个单位，成功时返回true并写入offset
+    bool Allocate(uint32_t size, uint32_t& offset);
+
+    // 释放之前分配的区间
+    void Free(uint32_t offset, uint32_t size);
+
+    // 把容量扩大到newCapacity，新增的部分成为空闲区间
+    void Grow(uint32_t newCapacity);
+
+    uint32_t GetCapacity() const { return m_capacity; }
+    uint32_t GetUsed() const { return m_used; }
+    uint32_t GetFreeBlockCount() const { return static_cast<uint32_t>(m_freeBlocks.size()); }
+    uint32_t GetLargestFreeBlock() const;
+
+private:
+    std::map<uint32_t, uint32_t> m_freeBlocks;  // 起点 -> 长度
+    uint32_t m_capacity = 0;
+    uint32_t m_used = 0;
+};
+
+// 一个网格在几何池中的区间（见 GeometryArena）
+struct GeometryAllocation {
+    VertexLayout::Format format = VertexLayout::Format::Half;
+    uint32_t vertexOffset = 0;   // 顶点池中的起始顶点（绘制时作为basevertex）
+    uint32_t vertexCount = 0;
+    uint32_t indexOffset = 0;    // 索引池中的起始字节（4字节对齐）
+    uint32_t indexBytes = 0;
+
+    bool IsValid() const { return vertexCount > 0; }
+};
+
+// 几何池的使用统计
+struct GeometryArenaStats {
+    uint32_t allocations = 0;        // 当前存活的网格数
+    uint32_t vertexBytesUsed = 0;
+    uint32_t vertexBytesCapacity = 0;
+    uint32_t indexBytesUsed = 0;
+    uint32_t indexBytesCapacity = 0;
+    uint32_t freeBlocks = 0;         // 空闲区间数（碎片程度）
+    uint32_t growths = 0;            // 缓冲扩容次数
+};
+
+// 几何池 - 所有网格的顶点和索引存放在少数几个大缓冲中，网格只记录自己的区间
+//
+// 每种顶点格式（VertexLayout::Format）一个池：一个顶点缓冲、一个索引缓冲、一个普通VAO和一个实例化VAO。
+// 顶点区间以顶点为单位分配（同一个池中步长相同），绘制时通过basevertex偏移（glDrawElementsBaseVertex），
+// 网格的索引保持从0开始；索引区间以4字节为单位分配，16位和32位索引可以共用一个缓冲。
+// 同一格式的网格共享VAO，创建和销毁网格不再创建/删除GL对象，渲染队列也不必在网格之间切换VAO
+//
+// 空间不足时容量翻倍：新建更大的缓冲，用glCopyBufferSubData拷贝旧数据，再把两个VAO指向新缓冲，
+// 已有网格的区间不变
+//
+// 进程级单例（网格可以在任何地方创建），GL对象在第一次分配时创建，需要有效的OpenGL上下文。
+// 析构时不调用GL（此时上下文可能已经销毁），需要在上下文有效时释放的调用Shutdown
+class GeometryArena {
+public:
+    // 新建池的初始容量
+    static constexpr uint32_t InitialVertexCount = 256 * 1024;
+    static constexpr uint32_t InitialIndexBytes = 2 * 1024 * 1024;
+
+    static GeometryArena& Get();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    // 分配并上传网格数据（vertexData为layout格式的vertexCount个顶点，indexData为indexBytes字节的索引）
+    bool Allocate(const VertexLayout& layout, const void* vertexData, uint32_t vertexCount,
+                  const void* indexData, uint32_t indexBytes, GeometryAllocation& allocation);
+
+    // 释放网格的区间（allocation被重置）
+    void Free(GeometryAllocation& allocation);
+
+    // 读回区间的数据（vertexData为该格式布局的顶点，indexData为原始索引字节）
+    // 需要等待GPU，只用于构建时的操作（如静态合批），不要每帧调用
+    bool Read(const GeometryAllocation& allocation, std::vector<uint8_t>& vertexData, std::vector<uint8_t>& indexData) const;
+
+    // 指定格式的共享VAO（该格式还没有网格时为0）
+    GLuint GetVAO(VertexLayout::Format format) const { return m_pools[static_cast<int>(format)].vao; }
+    GLuint GetInstancedVAO(VertexLayout::Format format) const { return m_pools[static_cast<int>(format)].instancedVAO; }
+
+    // 删除所有GL对象（之后存活网格的区间无效）
+    void Shutdown();
+
+    GeometryArenaStats GetStats() const;
+
+private:
+    GeometryArena() = default;
+    ~GeometryArena() = default;
+
+    struct Pool {
+        const VertexLayout* layout = nullptr;
+        GLuint vertexBuffer = 0;
+        GLuint indexBuffer = 0;
+        GLuint vao = 0;
+        GLuint instancedVAO = 0;
+        RangeAllocator vertices;   // 单位：顶点
+        RangeAllocator indices;    // 单位：4字节
+        uint32_t allocations = 0;
+    };
+
+    static constexpr int FormatCount = 2;
+
+    // 创建池的缓冲和VAO
+    bool CreatePool(Pool& pool, const VertexLayout& layout);
+
+    // 删除一个池的缓冲和VAO并重置（只删除已创建的对象，不影响其他格式的池）
+    static void DestroyPool(Pool& pool);
+
+    // 把缓冲扩大到newBytes并保留前oldBytes字节
+    static void GrowBuffer(GLuint& buffer, uint32_t oldBytes, uint32_t newBytes);
+
+    // 把池的两个VAO指向当前的顶点和索引缓冲
+    static void BindPoolBuffers(const Pool& pool);
+
+    // 在allocator中分配size个单位，空间不足时把容量翻倍直到放得下（调用方比较容量判断是否扩容）
+    static void AllocateGrowing(RangeAllocator& allocator, uint32_t size, uint32_t& offset);
+
+    Pool m_pools[FormatCount];
+    uint32_t m_growths = 0;
+};
+
+} // namespace SoulsEngine
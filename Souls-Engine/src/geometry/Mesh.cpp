@@ -1,72 +1,207 @@
 #include "Mesh.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
 
 namespace SoulsEngine {
 
-Mesh::Mesh() : m_VAO(0), m_VBO(0), m_vertexCount(0) {
+namespace {
+    std::atomic<uint32_t> s_nextMeshSortId{ 1 };
+}
+
+Mesh::Mesh()
+    : m_vertexCount(0), m_indexCount(0), m_indexType(GL_UNSIGNED_INT)
+    , m_sortId(s_nextMeshSortId.fetch_add(1, std::memory_order_relaxed))
+    , m_layout(nullptr) {
 }
 
 Mesh::~Mesh() {
-    if (m_VBO != 0) {
-        glDeleteBuffers(1, &m_VBO);
-        m_VBO = 0;
+    GeometryArena::Get().Free(m_geometry);
+}
+
+size_t Mesh::GetIndexBufferSize() const {
+    return m_indexCount * (m_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t));
+}
+
+uint32_t Mesh::AddVertex(std::vector<MeshVertex>& vertices, const glm::vec3& position,
+                         const glm::vec3& normal, const glm::vec3& color) {
+    uint32_t index = static_cast<uint32_t>(vertices.size());
+    vertices.push_back({ position, normal, color });
+    return index;
+}
+
+void Mesh::SetupMesh(const std::vector<MeshVertex>& vertices) {
+    // 按位比较合并完全相同的顶点（位置、法线、颜色都相同）
+    struct VertexKey {
+        uint32_t bits[9];
+        bool operator==(const VertexKey& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+    };
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const {
+            size_t hash = 0;
+            for (uint32_t value : key.bits) {
+                hash = hash * 31 + value;
+            }
+            return hash;
+        }
+    };
+
+    static_assert(sizeof(MeshVertex) == sizeof(VertexKey::bits), "MeshVertex必须是9个连续的float");
+
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> uniqueVertices;
+    uniqueVertices.reserve(vertices.size());
+    std::vector<MeshVertex> welded;
+    std::vector<uint32_t> indices;
+    welded.reserve(vertices.size());
+    indices.reserve(vertices.size());
+
+    for (const MeshVertex& vertex : vertices) {
+        VertexKey key;
+        std::memcpy(key.bits, &vertex, sizeof(key.bits));
+        auto result = uniqueVertices.emplace(key, static_cast<uint32_t>(welded.size()));
+        if (result.second) {
+            welded.push_back(vertex);
+        }
+        indices.push_back(result.first->second);
     }
-    if (m_VAO != 0) {
-        glDeleteVertexArrays(1, &m_VAO);
-        m_VAO = 0;
+
+    SetupMesh(welded, indices);
+}
+
+void Mesh::SetupMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices) {
+    m_vertexCount = vertices.size();
+    m_indexCount = indices.size();
+
+    // 选择布局并压缩顶点
+    m_layout = &VertexLayout::Select(vertices);
+    std::vector<uint8_t> packed = m_layout->Pack(vertices);
+    ComputeBounds(vertices);
+
+    // 上传到几何池：顶点数不超过65536时使用16位索引，索引数据减半
+    // （索引相对网格自己的第一个顶点，绘制时加上basevertex）
+    bool uploaded = false;
+    if (m_vertexCount <= 65536) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        m_indexType = GL_UNSIGNED_SHORT;
+        uploaded = GeometryArena::Get().Allocate(*m_layout, packed.data(), static_cast<uint32_t>(m_vertexCount),
+                                                 shortIndices.data(), static_cast<uint32_t>(shortIndices.size() * sizeof(uint16_t)),
+                                                 m_geometry);
+    } else {
+        m_indexType = GL_UNSIGNED_INT;
+        uploaded = GeometryArena::Get().Allocate(*m_layout, packed.data(), static_cast<uint32_t>(m_vertexCount),
+                                                 indices.data(), static_cast<uint32_t>(indices.size() * sizeof(uint32_t)),
+                                                 m_geometry);
+    }
+    if (!uploaded) {
+        m_vertexCount = 0;
+        m_indexCount = 0;
     }
 }
 
-void Mesh::SetupMesh(const std::vector<float>& vertices) {
-    m_vertexCount = vertices.size() / 6; // 每个顶点6个float
-
-    // 创建VAO和VBO
-    glGenVertexArrays(1, &m_VAO);
-    glGenBuffers(1, &m_VBO);
-
-    // 绑定VAO
-    glBindVertexArray(m_VAO);
-
-    // 绑定VBO并上传数据
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, 
-                 static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), 
-                 vertices.data(), 
-                 GL_STATIC_DRAW);
-
-    // 设置顶点属性
-    // 位置属性 (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    // 颜色属性 (location = 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // 解绑
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+bool Mesh::ReadBack(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) const {
+    std::vector<uint8_t> vertexData;
+    std::vector<uint8_t> indexData;
+    if (!m_layout || !GeometryArena::Get().Read(m_geometry, vertexData, indexData)) {
+        return false;
+    }
+
+    vertices = m_layout->Unpack(vertexData.data(), m_vertexCount);
+    indices.resize(IsIndexed() ? m_indexCount : m_vertexCount);
+    if (!IsIndexed()) {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<uint32_t>(i);
+        }
+    } else if (m_indexType == GL_UNSIGNED_SHORT) {
+        const uint16_t* shortIndices = reinterpret_cast<const uint16_t*>(indexData.data());
+        indices.assign(shortIndices, shortIndices + m_indexCount);
+    } else {
+        std::memcpy(indices.data(), indexData.data(), m_indexCount * sizeof(uint32_t));
+    }
+    return true;
+}
+
+void Mesh::ComputeBounds(const std::vector<MeshVertex>& vertices) {
+    if (vertices.empty()) {
+        m_localBounds = BoundingBox();
+        m_boundingSphere = BoundingSphere();
+        return;
+    }
+
+    glm::vec3 minPos = vertices[0].position;
+    glm::vec3 maxPos = vertices[0].position;
+    for (const MeshVertex& vertex : vertices) {
+        minPos = glm::min(minPos, vertex.position);
+        maxPos = glm::max(maxPos, vertex.position);
+    }
+
+    // half的舍入误差不超过坐标绝对值 * 2^-11
+    glm::vec3 error(0.0f);
+    if (m_layout && m_layout->GetFormat() == VertexLayout::Format::Half) {
+        error = glm::max(glm::abs(minPos), glm::abs(maxPos)) * (1.0f / 2048.0f);
+    }
+    m_localBounds = BoundingBox::FromMinMax(minPos - error, maxPos + error);
+
+    // 以包围盒中心为球心，半径取到最远顶点的距离（比半对角线更紧）
+    float maxDistanceSq = 0.0f;
+    for (const MeshVertex& vertex : vertices) {
+        glm::vec3 offset = vertex.position - m_localBounds.center;
+        maxDistanceSq = std::max(maxDistanceSq, glm::dot(offset, offset));
+    }
+    m_boundingSphere.center = m_localBounds.center;
+    m_boundingSphere.radius = std::sqrt(maxDistanceSq) + glm::length(error);
+}
+
+void Mesh::IssueDraw(GLsizei instanceCount) const {
+    const GLint baseVertex = static_cast<GLint>(m_geometry.vertexOffset);
+    const void* indexOffset = reinterpret_cast<const void*>(static_cast<uintptr_t>(m_geometry.indexOffset));
+    if (m_indexCount > 0) {
+        if (instanceCount > 0) {
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), m_indexType,
+                                              indexOffset, instanceCount, baseVertex);
+        } else {
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), m_indexType, indexOffset, baseVertex);
+        }
+    } else if (m_vertexCount > 0) {
+        if (instanceCount > 0) {
+            glDrawArraysInstanced(GL_TRIANGLES, baseVertex, static_cast<GLsizei>(m_vertexCount), instanceCount);
+        } else {
+            glDrawArrays(GL_TRIANGLES, baseVertex, static_cast<GLsizei>(m_vertexCount));
+        }
+    }
 }
 
 void Mesh::Draw() const {
-    if (m_VAO != 0 && m_vertexCount > 0) {
-        glBindVertexArray(m_VAO);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
+    if (m_geometry.IsValid()) {
+        glBindVertexArray(GetVAO());
+        IssueDraw(0);
         glBindVertexArray(0);
     }
 }
 
+void Mesh::DrawBound() const {
+    IssueDraw(0);
+}
+
+void Mesh::DrawInstancedBound(GLsizei instanceCount) const {
+    if (instanceCount > 0) {
+        IssueDraw(instanceCount);
+    }
+}
+
 void Mesh::DrawWireframe() const {
     // 线框效果通过 SceneNode::RenderWireframe 实现
-    if (m_VAO != 0 && m_vertexCount > 0) {
+    if (m_geometry.IsValid()) {
         // 注意：glPolygonMode(GL_LINE) 在 OpenGL Core Profile 中不可用
         // 我们使用一个简化的方法：直接渲染填充模式，边框效果通过
         // SceneNode::RenderWireframe 中的缩放变换和shader的覆盖颜色来实现
         
         // 渲染边框（使用填充模式，但通过shader的覆盖颜色来实现黑色边框效果）
         // 边框效果通过稍微放大对象（在SceneNode中实现）和黑色覆盖颜色实现
-        glBindVertexArray(m_VAO);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
+        glBindVertexArray(GetVAO());
+        IssueDraw(0);
         glBindVertexArray(0);
     }
 }
@@ -1,12 +1,17 @@
 #pragma once
 
+#include "Bounds.h"
+#include "GeometryArena.h"
+#include "VertexLayout.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace SoulsEngine {
 
-// 网格基类，管理 OpenGL 顶点数据
+// 网格基类 - 顶点和索引存放在共享的几何池中（见 GeometryArena），网格只记录自己的区间，
+// 同一顶点格式的网格共用一个VAO，绘制时通过basevertex和索引偏移定位
 class Mesh {
 public:
     Mesh();
@@ -22,17 +27,80 @@ public:
     // 渲染线框（用于选中高亮）
     void DrawWireframe() const;
 
-    // 获取顶点数量
+    // 只发出绘制调用，不绑定/解绑VAO（由调用方通过状态缓存绑定GetVAO()）
+    void DrawBound() const;
+
+    // 实例化绘制instanceCount个实例，调用方需已绑定GetInstancedVAO()并设置好逐实例属性
+    void DrawInstancedBound(GLsizei instanceCount) const;
+
+    // 获取顶点数量（索引网格为去重后的顶点数）
     size_t GetVertexCount() const { return m_vertexCount; }
 
+    // 索引信息：索引数量为0表示非索引网格；索引类型为GL_UNSIGNED_SHORT或GL_UNSIGNED_INT
+    size_t GetIndexCount() const { return m_indexCount; }
+    GLenum GetIndexType() const { return m_indexType; }
+    bool IsIndexed() const { return m_indexCount > 0; }
+
+    // 绘制的顶点数（索引网格为索引数量）
+    size_t GetDrawCount() const { return IsIndexed() ? m_indexCount : m_vertexCount; }
+
+    // 上传到GPU的顶点/索引数据字节数
+    size_t GetVertexBufferSize() const { return m_layout ? m_vertexCount * m_layout->GetStride() : 0; }
+    size_t GetIndexBufferSize() const;
+
+    // 顶点布局（SetupMesh之前为nullptr）
+    const VertexLayout* GetVertexLayout() const { return m_layout; }
+
+    // 局部空间包围体（SetupMesh时由顶点位置计算）
+    const BoundingBox& GetLocalBounds() const { return m_localBounds; }
+    const BoundingSphere& GetBoundingSphere() const { return m_boundingSphere; }
+
+    // 获取顶点数组对象（几何池中该顶点格式共享的VAO，SetupMesh之前为0）
+    GLuint GetVAO() const { return m_geometry.IsValid() ? GeometryArena::Get().GetVAO(m_geometry.format) : 0; }
+
+    // 实例化绘制使用的顶点数组对象：顶点属性与GetVAO()相同，逐实例属性由渲染队列指向实例缓冲
+    GLuint GetInstancedVAO() const {
+        return m_geometry.IsValid() ? GeometryArena::Get().GetInstancedVAO(m_geometry.format) : 0;
+    }
+
+    // 网格在几何池中的区间（basevertex和索引缓冲中的字节偏移）
+    const GeometryAllocation& GetGeometry() const { return m_geometry; }
+
+    // 从几何池读回顶点和索引（顶点为GPU上的量化值；非索引网格按0..n-1生成索引）
+    // 需要等待GPU，只用于构建时的操作（如静态合批）
+    bool ReadBack(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices) const;
+
+    // 渲染队列排序键使用的网格编号（创建时分配，进程内唯一）
+    uint32_t GetSortId() const { return m_sortId; }
+
 protected:
-    GLuint m_VAO;              // 顶点数组对象
-    GLuint m_VBO;              // 顶点缓冲对象
+    GeometryAllocation m_geometry;  // 几何池中的区间
     size_t m_vertexCount;      // 顶点数量
+    size_t m_indexCount;       // 索引数量
+    GLenum m_indexType;        // 索引类型
+    uint32_t m_sortId;         // 排序编号
+    const VertexLayout* m_layout;  // 顶点布局
+    BoundingBox m_localBounds;     // 局部包围盒
+    BoundingSphere m_boundingSphere;  // 局部包围球
+
+    // 初始化索引网格（由子类调用）
+    // 顶点按VertexLayout::Select选择的布局压缩后上传；每3个索引组成一个三角形
+    // 所有索引都小于65536时使用16位索引，否则使用32位索引
+    void SetupMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+
+    // 从三角形列表初始化（每3个顶点一个三角形），完全相同的顶点会被合并后按索引网格上传
+    void SetupMesh(const std::vector<MeshVertex>& vertices);
+
+    // 生成器辅助：追加一个顶点并返回其索引
+    static uint32_t AddVertex(std::vector<MeshVertex>& vertices, const glm::vec3& position,
+                              const glm::vec3& normal, const glm::vec3& color);
+
+private:
+    // 计算包围盒和包围球（half位置按舍入误差外扩，保证包含GPU上的实际顶点）
+    void ComputeBounds(const std::vector<MeshVertex>& vertices);
 
-    // 初始化网格数据（由子类调用）
-    // 顶点格式：每个顶点6个float（3个位置 + 3个颜色）
-    void SetupMesh(const std::vector<float>& vertices);
+    // 发出绘制调用（VAO已绑定）
+    void IssueDraw(GLsizei instanceCount) const;
 };
 
 } // namespace SoulsEngine
@@ -0,0 +1,93 @@
+#include "MeshLOD.h"
+#include "Sphere.h"
+#include "Cylinder.h"
+#include "Cone.h"
+#include "Disk.h"
+#include <cmath>
+
+namespace SoulsEngine {
+
+void MeshLOD::AddLevel(std::shared_ptr<Mesh> mesh, float minScreenRadius) {
+    if (!mesh) return;
+    m_levels.push_back({ mesh, minScreenRadius });
+
+    // 合并包围盒
+    const BoundingBox& bounds = mesh->GetLocalBounds();
+    if (bounds.IsValid()) {
+        if (m_localBounds.IsValid()) {
+            m_localBounds = BoundingBox::FromMinMax(glm::min(m_localBounds.GetMin(), bounds.GetMin()),
+                                                    glm::max(m_localBounds.GetMax(), bounds.GetMax()));
+        } else {
+            m_localBounds = bounds;
+        }
+    }
+
+    // 包围球以合并后的包围盒中心为球心，包含每一级的包围球
+    if (!m_localBounds.IsValid()) return;
+    m_boundingSphere.center = m_localBounds.center;
+    m_boundingSphere.radius = 0.0f;
+    for (const Level& level : m_levels) {
+        const BoundingSphere& sphere = level.mesh->GetBoundingSphere();
+        if (!sphere.IsValid()) continue;
+        m_boundingSphere.radius = std::max(m_boundingSphere.radius,
+                                           glm::length(sphere.center - m_boundingSphere.center) + sphere.radius);
+    }
+}
+
+int MeshLOD::SelectLevel(float screenRadius, int currentLevel) const {
+    const int levelCount = static_cast<int>(m_levels.size());
+    if (levelCount == 0) return 0;
+
+    int level = std::min(std::max(currentLevel, 0), levelCount - 1);
+    // 换到更细的层次
+    while (level > 0 && screenRadius >= m_levels[level - 1].minScreenRadius * (1.0f + m_hysteresis)) {
+        --level;
+    }
+    // 换到更粗的层次
+    while (level + 1 < levelCount && screenRadius < m_levels[level].minScreenRadius * (1.0f - m_hysteresis)) {
+        ++level;
+    }
+    return level;
+}
+
+float MeshLOD::GetMaxScreenRadius(int segments, float tolerance) {
+    return tolerance / (1.0f - std::cos(3.14159265359f / static_cast<float>(segments)));
+}
+
+template <typename CreateMesh>
+std::shared_ptr<MeshLOD> MeshLOD::CreateLevels(float tolerance, CreateMesh&& createMesh) {
+    auto lod = std::make_shared<MeshLOD>();
+    const int levelCount = static_cast<int>(sizeof(LevelSegments) / sizeof(LevelSegments[0]));
+    for (int i = 0; i < levelCount; ++i) {
+        // 下一级（更粗）的误差超过容差时才需要这一级
+        float minScreenRadius = (i + 1 < levelCount) ? GetMaxScreenRadius(LevelSegments[i + 1], tolerance) : 0.0f;
+        lod->AddLevel(createMesh(LevelSegments[i]), minScreenRadius);
+    }
+    return lod;
+}
+
+std::shared_ptr<MeshLOD> MeshLOD::CreateSphere(float radius, const glm::vec3& color, float tolerance) {
+    return CreateLevels(tolerance, [&](int segments) {
+        return std::make_shared<Sphere>(radius, segments, segments / 2, color);
+    });
+}
+
+std::shared_ptr<MeshLOD> MeshLOD::CreateCylinder(float radius, float height, const glm::vec3& color, float tolerance) {
+    return CreateLevels(tolerance, [&](int segments) {
+        return std::make_shared<Cylinder>(radius, height, segments, color);
+    });
+}
+
+std::shared_ptr<MeshLOD> MeshLOD::CreateCone(float radius, float height, const glm::vec3& color, float tolerance) {
+    return CreateLevels(tolerance, [&](int segments) {
+        return std::make_shared<Cone>(radius, height, segments, color);
+    });
+}
+
+std::shared_ptr<MeshLOD> MeshLOD::CreateDisk(float radius, const glm::vec3& color, float tolerance) {
+    return CreateLevels(tolerance, [&](int segments) {
+        return std::make_shared<Disk>(radius, segments, color);
+    });
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Mesh.h"
+#include "Bounds.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 细节层次选择所需的相机参数
+struct LODContext {
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    float projectionScale = 1.0f;  // 距离为1处每世界单位对应的像素数（透视投影）
+
+    // projection为透视投影矩阵，viewportHeight为视口高度（像素）
+    static LODContext FromCamera(const glm::vec3& cameraPosition, const glm::mat4& projection, float viewportHeight) {
+        LODContext context;
+        context.cameraPosition = cameraPosition;
+        context.projectionScale = projection[1][1] * viewportHeight * 0.5f;
+        return context;
+    }
+
+    // 世界空间包围球投影到屏幕上的半径（像素），相机在球内时返回FLT_MAX
+    float GetScreenRadius(const glm::vec3& center, float radius) const {
+        float distance = glm::length(center - cameraPosition);
+        if (distance <= radius) return FLT_MAX;
+        return radius * projectionScale / distance;
+    }
+};
+
+// 一帧细节层次选择的统计
+struct LODStats {
+    uint32_t nodes = 0;                // 使用细节层次的节点数
+    uint32_t levelChanges = 0;         // 本帧切换了层次的节点数
+    uint32_t triangles = 0;            // 选中层次的三角形总数
+    uint32_t fullDetailTriangles = 0;  // 都使用最细层次时的三角形总数
+};
+
+// 网格细节层次组 - 同一形状由细到粗的若干网格，按包围球的屏幕半径选择其中一个
+//
+// 第i级在屏幕半径不小于GetLevel(i).minScreenRadius时使用（最后一级为0）。
+// 为了避免在阈值附近来回切换，换到更细的层次要求半径超过阈值*(1+hysteresis)，
+// 换到更粗的层次要求半径低于阈值*(1-hysteresis)
+//
+// 节点通过SceneNode::SetMeshLOD使用，包围盒取所有层次的并集，切换层次不影响剔除
+class MeshLOD {
+public:
+    struct Level {
+        std::shared_ptr<Mesh> mesh;
+        float minScreenRadius;
+    };
+
+    explicit MeshLOD(float hysteresis = 0.1f) : m_hysteresis(hysteresis) {}
+
+    // 按由细到粗的顺序添加，minScreenRadius需递减
+    void AddLevel(std::shared_ptr<Mesh> mesh, float minScreenRadius);
+
+    size_t GetLevelCount() const { return m_levels.size(); }
+    const Level& GetLevel(size_t level) const { return m_levels[level]; }
+
+    // 所有层次的局部包围盒的并集，以及包含它的包围球
+    const BoundingBox& GetLocalBounds() const { return m_localBounds; }
+    const BoundingSphere& GetBoundingSphere() const { return m_boundingSphere; }
+
+    // 由屏幕半径和当前层次选择新的层次
+    int SelectLevel(float screenRadius, int currentLevel) const;
+
+    // 正n边形近似圆时，轮廓误差不超过tolerance像素的最大屏幕半径：r * (1 - cos(pi / n)) <= tolerance
+    static float GetMaxScreenRadius(int segments, float tolerance);
+
+    // 预生成的几何体细节层次（最细一级使用构造函数的默认分段数），
+    // 每一级在下一级的轮廓误差超过tolerance像素时使用
+    static std::shared_ptr<MeshLOD> CreateSphere(float radius, const glm::vec3& color, float tolerance = DefaultTolerance);
+    static std::shared_ptr<MeshLOD> CreateCylinder(float radius, float height, const glm::vec3& color, float tolerance = DefaultTolerance);
+    static std::shared_ptr<MeshLOD> CreateCone(float radius, float height, const glm::vec3& color, float tolerance = DefaultTolerance);
+    static std::shared_ptr<MeshLOD> CreateDisk(float radius, const glm::vec3& color, float tolerance = DefaultTolerance);
+
+    // 默认轮廓误差（像素）
+    static constexpr float DefaultTolerance = 1.0f;
+
+    // 圆周分段数，由细到粗
+    static constexpr int LevelSegments[] = { 36, 18, 10, 6 };
+
+private:
+    // 按LevelSegments为每一级生成网格并设置阈值
+    template <typename CreateMesh>
+    static std::shared_ptr<MeshLOD> CreateLevels(float tolerance, CreateMesh&& createMesh);
+
+    std::vector<Level> m_levels;
+    BoundingBox m_localBounds;
+    BoundingSphere m_boundingSphere;
+    float m_hysteresis;
+};
+
+} // namespace SoulsEngine
@@ -5,63 +5,55 @@
 namespace SoulsEngine {
 
 Prism::Prism(int sides, float radius, float height, const glm::vec3& color) {
-    std::vector<float> vertices;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
     float h = height * 0.5f;
     float angleStep = 2.0f * 3.14159265359f / sides;
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
+    const glm::vec3 down(0.0f, -1.0f, 0.0f);
 
-    // 侧面
-    for (int i = 0; i < sides; ++i) {
-        float angle1 = i * angleStep;
-        float angle2 = (i + 1) * angleStep;
-
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
-
-        // 第一个三角形
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
+    auto ringPoint = [&](int i, float y) {
+        float angle = i * angleStep;
+        return glm::vec3(radius * cosf(angle), y, radius * sinf(angle));
+    };
 
-        // 第二个三角形
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2,  h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
+    // 侧面：每个面4个独立顶点，法线为该面中线方向（棱边处法线不连续）
+    for (int i = 0; i < sides; ++i) {
+        float midAngle = (i + 0.5f) * angleStep;
+        glm::vec3 normal(cosf(midAngle), 0.0f, sinf(midAngle));
+        uint32_t b1 = AddVertex(vertices, ringPoint(i, -h), normal, color);
+        uint32_t b2 = AddVertex(vertices, ringPoint((i + 1) % sides, -h), normal, color);
+        uint32_t t2 = AddVertex(vertices, ringPoint((i + 1) % sides, h), normal, color);
+        uint32_t t1 = AddVertex(vertices, ringPoint(i, h), normal, color);
+
+        indices.insert(indices.end(), { b1, b2, t1 });
+        indices.insert(indices.end(), { b2, t2, t1 });
     }
 
-    // 顶面
+    // 端面：顶面多边形、底面多边形、顶面中心、底面中心
+    const uint32_t capTop = static_cast<uint32_t>(vertices.size());
     for (int i = 0; i < sides; ++i) {
-        float angle1 = i * angleStep;
-        float angle2 = (i + 1) * angleStep;
-
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
-
-        vertices.insert(vertices.end(), { 0.0f,  h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1,  h, z1, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2,  h, z2, color.r, color.g, color.b });
+        AddVertex(vertices, ringPoint(i, h), up, color);
+    }
+    const uint32_t capBottom = static_cast<uint32_t>(vertices.size());
+    for (int i = 0; i < sides; ++i) {
+        AddVertex(vertices, ringPoint(i, -h), down, color);
     }
+    uint32_t topCenter = AddVertex(vertices, glm::vec3(0.0f, h, 0.0f), up, color);
+    uint32_t bottomCenter = AddVertex(vertices, glm::vec3(0.0f, -h, 0.0f), down, color);
 
-    // 底面
     for (int i = 0; i < sides; ++i) {
-        float angle1 = i * angleStep;
-        float angle2 = (i + 1) * angleStep;
+        uint32_t i1 = static_cast<uint32_t>(i);
+        uint32_t i2 = static_cast<uint32_t>((i + 1) % sides);
 
-        float x1 = radius * cosf(angle1);
-        float z1 = radius * sinf(angle1);
-        float x2 = radius * cosf(angle2);
-        float z2 = radius * sinf(angle2);
+        // 顶面
+        indices.insert(indices.end(), { topCenter, capTop + i1, capTop + i2 });
 
-        vertices.insert(vertices.end(), { 0.0f, -h, 0.0f, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x2, -h, z2, color.r, color.g, color.b });
-        vertices.insert(vertices.end(), { x1, -h, z1, color.r, color.g, color.b });
+        // 底面
+        indices.insert(indices.end(), { bottomCenter, capBottom + i2, capBottom + i1 });
     }
 
-    SetupMesh(vertices);
+    SetupMesh(vertices, indices);
 }
 
 }
-
@@ -5,51 +5,53 @@
 namespace SoulsEngine {
 
 Sphere::Sphere(float radius, int sectors, int stacks, const glm::vec3& color) {
-    std::vector<float> vertices;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
     float sectorStep = 2.0f * 3.14159265359f / sectors;
     float stackStep = 3.14159265359f / stacks;
 
-    // 直接生成三角形
-    for (int i = 0; i < stacks; ++i) {
-        float stackAngle1 = 3.14159265359f / 2.0f - i * stackStep;
-        float stackAngle2 = 3.14159265359f / 2.0f - (i + 1) * stackStep;
+    // 顶点：北极点、中间 stacks-1 圈（每圈 sectors 个点，首尾不重复）、南极点
+    // 法线为球心指向顶点的单位向量
+    AddVertex(vertices, glm::vec3(0.0f, 0.0f, radius), glm::vec3(0.0f, 0.0f, 1.0f), color);
+    for (int i = 1; i < stacks; ++i) {
+        float stackAngle = 3.14159265359f / 2.0f - i * stackStep;
+        float xy = cosf(stackAngle);
+        float z = sinf(stackAngle);
+        for (int j = 0; j < sectors; ++j) {
+            float sectorAngle = j * sectorStep;
+            glm::vec3 normal(xy * cosf(sectorAngle), xy * sinf(sectorAngle), z);
+            AddVertex(vertices, normal * radius, normal, color);
+        }
+    }
+    const uint32_t southPole = AddVertex(vertices, glm::vec3(0.0f, 0.0f, -radius), glm::vec3(0.0f, 0.0f, -1.0f), color);
 
-        float xy1 = radius * cosf(stackAngle1);
-        float z1 = radius * sinf(stackAngle1);
-        float xy2 = radius * cosf(stackAngle2);
-        float z2 = radius * sinf(stackAngle2);
+    // 第 ring 圈第 sector 个点的索引（两极整圈共用一个点）
+    auto ringIndex = [&](int ring, int sector) -> uint32_t {
+        if (ring == 0) return 0;
+        if (ring == stacks) return southPole;
+        return 1 + static_cast<uint32_t>((ring - 1) * sectors + sector % sectors);
+    };
 
+    for (int i = 0; i < stacks; ++i) {
         for (int j = 0; j < sectors; ++j) {
-            float sectorAngle1 = j * sectorStep;
-            float sectorAngle2 = (j + 1) * sectorStep;
-
-            float x1 = xy1 * cosf(sectorAngle1);
-            float y1 = xy1 * sinf(sectorAngle1);
-            float x2 = xy1 * cosf(sectorAngle2);
-            float y2 = xy1 * sinf(sectorAngle2);
-            float x3 = xy2 * cosf(sectorAngle1);
-            float y3 = xy2 * sinf(sectorAngle1);
-            float x4 = xy2 * cosf(sectorAngle2);
-            float y4 = xy2 * sinf(sectorAngle2);
+            uint32_t v1 = ringIndex(i, j);
+            uint32_t v2 = ringIndex(i, j + 1);
+            uint32_t v3 = ringIndex(i + 1, j);
+            uint32_t v4 = ringIndex(i + 1, j + 1);
 
             if (i != 0) {
                 // 第一个三角形
-                vertices.insert(vertices.end(), { x1, y1, z1, color.r, color.g, color.b });
-                vertices.insert(vertices.end(), { x3, y3, z2, color.r, color.g, color.b });
-                vertices.insert(vertices.end(), { x2, y2, z1, color.r, color.g, color.b });
+                indices.insert(indices.end(), { v1, v3, v2 });
             }
 
             if (i != (stacks - 1)) {
                 // 第二个三角形
-                vertices.insert(vertices.end(), { x2, y2, z1, color.r, color.g, color.b });
-                vertices.insert(vertices.end(), { x3, y3, z2, color.r, color.g, color.b });
-                vertices.insert(vertices.end(), { x4, y4, z2, color.r, color.g, color.b });
+                indices.insert(indices.end(), { v2, v3, v4 });
             }
         }
     }
 
-    SetupMesh(vertices);
+    SetupMesh(vertices, indices);
 }
 
 }
-
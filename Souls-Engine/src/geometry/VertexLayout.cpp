@@ -0,0 +1,231 @@
+#include "VertexLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SoulsEngine {
+
+namespace {
+    // half能表示的最大有限值
+    constexpr float HalfMax = 65504.0f;
+
+    // half位置允许的最大舍入误差（相对包围盒对角线）
+    constexpr float HalfTolerance = 1.0f / 1024.0f;
+
+    // 把[-1,1]的值量化为bits位有符号整数（补码），返回低bits位
+    uint32_t PackSnorm(float value, int bits) {
+        const float scale = static_cast<float>((1 << (bits - 1)) - 1);
+        float clamped = std::min(std::max(value, -1.0f), 1.0f);
+        int32_t quantized = static_cast<int32_t>(std::lround(clamped * scale));
+        return static_cast<uint32_t>(quantized) & ((1u << bits) - 1u);
+    }
+
+    // 取低bits位的有符号整数转换为[-1,1]（GL 4.2起的规则：-2^(bits-1)也映射为-1）
+    float UnpackSnorm(uint32_t value, int bits) {
+        const int32_t shift = 32 - bits;
+        const int32_t quantized = static_cast<int32_t>(value << shift) >> shift;
+        const float scale = static_cast<float>((1 << (bits - 1)) - 1);
+        return std::max(static_cast<float>(quantized) / scale, -1.0f);
+    }
+
+    uint8_t PackUnorm8(float value) {
+        float clamped = std::min(std::max(value, 0.0f), 1.0f);
+        return static_cast<uint8_t>(std::lround(clamped * 255.0f));
+    }
+}
+
+VertexLayout::VertexLayout(Format format, uint32_t stride, std::vector<VertexAttribute> attributes)
+    : m_format(format), m_stride(stride), m_attributes(std::move(attributes)) {
+}
+
+const VertexLayout& VertexLayout::Get(Format format) {
+    static const VertexLayout halfLayout(Format::Half, 16, {
+        { PositionLocation, 4, GL_HALF_FLOAT, GL_FALSE, 0 },
+        { NormalLocation, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 8 },
+        { ColorLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, 12 },
+    });
+    static const VertexLayout floatLayout(Format::Float, 20, {
+        { PositionLocation, 3, GL_FLOAT, GL_FALSE, 0 },
+        { NormalLocation, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 12 },
+        { ColorLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, 16 },
+    });
+    return format == Format::Half ? halfLayout : floatLayout;
+}
+
+const VertexLayout& VertexLayout::Select(const std::vector<MeshVertex>& vertices) {
+    if (vertices.empty()) {
+        return Get(Format::Half);
+    }
+
+    glm::vec3 minPos = vertices[0].position;
+    glm::vec3 maxPos = vertices[0].position;
+    for (const MeshVertex& vertex : vertices) {
+        minPos = glm::min(minPos, vertex.position);
+        maxPos = glm::max(maxPos, vertex.position);
+    }
+
+    // half的舍入误差不超过 最大坐标绝对值 * 2^-11
+    float maxAbs = std::max(glm::length(glm::abs(minPos)), glm::length(glm::abs(maxPos)));
+    float diagonal = glm::length(maxPos - minPos);
+    bool fitsHalf = maxAbs <= HalfMax && maxAbs * (1.0f / 2048.0f) <= diagonal * HalfTolerance;
+    return Get(fitsHalf ? Format::Half : Format::Float);
+}
+
+void VertexLayout::Apply() const {
+    for (const VertexAttribute& attribute : m_attributes) {
+        glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                              static_cast<GLsizei>(m_stride), reinterpret_cast<void*>(static_cast<uintptr_t>(attribute.offset)));
+        glEnableVertexAttribArray(attribute.location);
+    }
+}
+
+std::vector<uint8_t> VertexLayout::Pack(const std::vector<MeshVertex>& vertices) const {
+    std::vector<uint8_t> data(vertices.size() * m_stride);
+    uint8_t* out = data.data();
+
+    for (const MeshVertex& vertex : vertices) {
+        uint32_t normalOffset;
+        if (m_format == Format::Half) {
+            uint16_t position[4] = {
+                PackHalf(vertex.position.x), PackHalf(vertex.position.y), PackHalf(vertex.position.z), PackHalf(1.0f)
+            };
+            std::memcpy(out, position, sizeof(position));
+            normalOffset = 8;
+        } else {
+            std::memcpy(out, &vertex.position.x, 3 * sizeof(float));
+            normalOffset = 12;
+        }
+
+        uint32_t normal = PackNormal(vertex.normal);
+        uint32_t color = PackColor(vertex.color);
+        std::memcpy(out + normalOffset, &normal, sizeof(normal));
+        std::memcpy(out + normalOffset + 4, &color, sizeof(color));
+        out += m_stride;
+    }
+
+    return data;
+}
+
+std::vector<MeshVertex> VertexLayout::Unpack(const uint8_t* data, size_t count) const {
+    std::vector<MeshVertex> vertices(count);
+    const uint8_t* in = data;
+
+    for (MeshVertex& vertex : vertices) {
+        uint32_t normalOffset;
+        if (m_format == Format::Half) {
+            uint16_t position[3];
+            std::memcpy(position, in, sizeof(position));
+            vertex.position = glm::vec3(UnpackHalf(position[0]), UnpackHalf(position[1]), UnpackHalf(position[2]));
+            normalOffset = 8;
+        } else {
+            std::memcpy(&vertex.position.x, in, 3 * sizeof(float));
+            normalOffset = 12;
+        }
+
+        uint32_t normal;
+        uint32_t color;
+        std::memcpy(&normal, in + normalOffset, sizeof(normal));
+        std::memcpy(&color, in + normalOffset + 4, sizeof(color));
+        vertex.normal = UnpackNormal(normal);
+        vertex.color = UnpackColor(color);
+        in += m_stride;
+    }
+
+    return vertices;
+}
+
+uint16_t VertexLayout::PackHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t floatExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    // 无穷大和NaN
+    if (floatExponent == 0xFFu) {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+
+    const int32_t exponent = static_cast<int32_t>(floatExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u);  // 上溢为无穷大
+    }
+
+    if (exponent <= 0) {
+        // 非规格化数：补上隐含的1后右移，舍入到最近偶数
+        if (exponent < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // 规格化数：尾数进位会自然进入指数位
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+uint32_t VertexLayout::PackNormal(const glm::vec3& normal) {
+    // 位布局（REV）：[9..0] x | [19..10] y | [29..20] z | [31..30] w
+    return PackSnorm(normal.x, 10)
+        | (PackSnorm(normal.y, 10) << 10)
+        | (PackSnorm(normal.z, 10) << 20);
+}
+
+uint32_t VertexLayout::PackColor(const glm::vec3& color, float alpha) {
+    // 内存中依次为 R G B A
+    return static_cast<uint32_t>(PackUnorm8(color.r))
+        | (static_cast<uint32_t>(PackUnorm8(color.g)) << 8)
+        | (static_cast<uint32_t>(PackUnorm8(color.b)) << 16)
+        | (static_cast<uint32_t>(PackUnorm8(alpha)) << 24);
+}
+
+float VertexLayout::UnpackHalf(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);  // 无穷大和NaN
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // 非规格化数：左移到隐含的1出现，同时减小指数
+        int32_t floatExponent = 127 - 15 + 1;
+        while ((mantissa & 0x400u) == 0) {
+            mantissa <<= 1;
+            --floatExponent;
+        }
+        bits = sign | (static_cast<uint32_t>(floatExponent) << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+glm::vec3 VertexLayout::UnpackNormal(uint32_t normal) {
+    return glm::vec3(UnpackSnorm(normal, 10), UnpackSnorm(normal >> 10, 10), UnpackSnorm(normal >> 20, 10));
+}
+
+glm::vec3 VertexLayout::UnpackColor(uint32_t color) {
+    return glm::vec3(static_cast<float>(color & 0xFFu), static_cast<float>((color >> 8) & 0xFFu),
+                     static_cast<float>((color >> 16) & 0xFFu)) * (1.0f / 255.0f);
+}
+
+} // namespace SoulsEngine
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace SoulsEngine {
+
+// 生成器输出的未压缩顶点，上传前由VertexLayout压缩
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec3 color;
+};
+
+// 单个顶点属性在顶点缓冲中的格式
+struct VertexAttribute {
+    GLuint location;        // 着色器中的location
+    GLint components;       // 分量数
+    GLenum type;            // 分量类型
+    GLboolean normalized;   // 整数类型是否归一化到[0,1]或[-1,1]
+    uint32_t offset;        // 相对顶点起始的字节偏移
+};
+
+// 顶点布局 - 描述顶点缓冲中各属性的格式，并把MeshVertex压缩成该格式
+//
+// 着色器中的location：0 位置, 1 颜色, 2 法线（3之后留给逐实例属性）
+//   Half:  位置 4 x half (8字节) | 法线 GL_INT_2_10_10_10_REV (4字节) | 颜色 RGBA8 (4字节) = 16字节
+//   Float: 位置 3 x float (12字节) | 法线 (4字节) | 颜色 (4字节) = 20字节
+// half位置的相对误差约为2^-11，以原点为中心的网格（所有几何体生成器）足够精确；
+// 远离原点或超出half范围的网格改用float位置
+class VertexLayout {
+public:
+    enum class Format {
+        Half,
+        Float
+    };
+
+    static constexpr GLuint PositionLocation = 0;
+    static constexpr GLuint ColorLocation = 1;
+    static constexpr GLuint NormalLocation = 2;
+
+    // 获取指定格式的布局（全局共享，不需要释放）
+    static const VertexLayout& Get(Format format);
+
+    // 根据顶点范围选择能无损表示网格的最紧凑布局
+    static const VertexLayout& Select(const std::vector<MeshVertex>& vertices);
+
+    Format GetFormat() const { return m_format; }
+    uint32_t GetStride() const { return m_stride; }
+    const std::vector<VertexAttribute>& GetAttributes() const { return m_attributes; }
+
+    // 在当前绑定的VAO上，按本布局把各属性指向当前绑定的GL_ARRAY_BUFFER
+    void Apply() const;
+
+    // 把顶点压缩为本布局的字节流
+    std::vector<uint8_t> Pack(const std::vector<MeshVertex>& vertices) const;
+
+    // 把本布局的count个顶点还原为MeshVertex（Pack的逆过程，得到的是GPU上实际使用的量化值）
+    std::vector<MeshVertex> Unpack(const uint8_t* data, size_t count) const;
+
+    // 压缩辅助
+    static uint16_t PackHalf(float value);                              // IEEE 754 半精度，就近舍入
+    static uint32_t PackNormal(const glm::vec3& normal);                // 有符号归一化 10/10/10/2
+    static uint32_t PackColor(const glm::vec3& color, float alpha = 1.0f);  // RGBA8
+
+    // 解压辅助（与GL对相应格式的转换规则一致）
+    static float UnpackHalf(uint16_t value);
+    static glm::vec3 UnpackNormal(uint32_t normal);
+    static glm::vec3 UnpackColor(uint32_t color);
+
+private:
+    VertexLayout(Format format, uint32_t stride, std::vector<VertexAttribute> attributes);
+
+    Format m_format;
+    uint32_t m_stride;
+    std::vector<VertexAttribute> m_attributes;
+};
+
+} // namespace SoulsEngine
@@ -14,6 +14,9 @@
 #include "core/ImGuiSystem.h"
 #include "core/Light.h"
 #include "core/LightManager.h"
+#include "core/FrameUniforms.h"
+#include "core/DeferredRenderer.h"
+#include "core/GpuTimer.h"
 #include "geometry/Cube.h"
 #include "geometry/Sphere.h"
 #include "geometry/Cylinder.h"
@@ -21,6 +24,7 @@
 #include "geometry/Prism.h"
 #include "geometry/Frustum.h"
 #include "geometry/Mesh.h"
+#include "geometry/GeometryArena.h"
 #include <GLFW/glfw3.h>
 #include <imgui.h> // ?? ImGui ??????????
 #include <glm/glm.hpp>
@@ -62,6 +66,7 @@ int main() {
     };
     
     std::string vertexPath, fragmentPath;
+    std::string shaderDirectory;
     bool shaderFilesFound = false;
     
     for (const auto& basePath : shaderPaths) {
@@ -72,6 +77,7 @@ int main() {
         
         if (FileExists(vertexPath) && FileExists(fragmentPath)) {
             std::cout << "Found shader files at: " << basePath << std::endl;
+            shaderDirectory = basePath;
             shaderFilesFound = true;
             break;
         }
@@ -120,9 +126,12 @@ int main() {
     glViewport(0, 0, window.GetWidth(), window.GetHeight());
 
     // ???Shader
+    // 编辑器不渲染阴影，场景使用去掉阴影采样的变体；选中轮廓和光源指示器使用只输出覆盖颜色的变体
     SoulsEngine::Shader shader;
+    SoulsEngine::Shader outlineShader;
     std::cout << "Loading shaders from: " << vertexPath << " and " << fragmentPath << std::endl;
-    if (!shader.LoadFromFiles(vertexPath, fragmentPath)) {
+    if (!shader.LoadFromFiles(vertexPath, fragmentPath, { { "SHADOWS", "0" } })
+        || !outlineShader.LoadFromFiles(vertexPath, fragmentPath, { { "OUTLINE", "1" } })) {
         std::cerr << "ERROR: Failed to compile/link shaders!" << std::endl;
         window.Shutdown();
         std::cout << "Press Enter to exit..." << std::endl;
@@ -131,6 +140,15 @@ int main() {
     }
     std::cout << "Shaders loaded and compiled successfully!" << std::endl;
 
+    // 延迟渲染的几何通道（与basic.vert共用顶点着色器）和光照通道，加载失败时只能使用前向渲染
+    SoulsEngine::Shader gbufferShader;
+    SoulsEngine::Shader lightingShader;
+    bool deferredShadersLoaded = gbufferShader.LoadFromFiles(vertexPath, shaderDirectory + "gbuffer.frag")
+        && lightingShader.LoadFromFiles(shaderDirectory + "deferred_light.vert", shaderDirectory + "deferred_light.frag");
+    if (!deferredShadersLoaded) {
+        std::cerr << "WARNING: Failed to load deferred shaders, only forward rendering is available" << std::endl;
+    }
+
     // ??????
     SoulsEngine::Camera camera(glm::vec3(0.0f, 2.0f, 8.0f));
     float aspectRatio = static_cast<float>(window.GetWidth()) / static_cast<float>(window.GetHeight());
@@ -160,6 +178,25 @@ int main() {
     SoulsEngine::LightManager lightManager;
     std::cout << "Light Manager created" << std::endl;
 
+    // 每帧相机和光源数据（uniform缓冲，所有着色器共享）
+    SoulsEngine::FrameUniforms frameUniforms;
+    if (!frameUniforms.Initialize()) {
+        std::cerr << "Failed to initialize frame uniforms" << std::endl;
+        window.Shutdown();
+        std::cin.get();
+        return -1;
+    }
+
+    // 延迟渲染的G-buffer（每帧按帧缓冲尺寸调整）和两条渲染路径的GPU计时
+    SoulsEngine::DeferredRenderer deferredRenderer;
+    SoulsEngine::GpuTimer forwardTimer;
+    SoulsEngine::GpuTimer geometryTimer;
+    SoulsEngine::GpuTimer lightingTimer;
+    forwardTimer.Initialize();
+    geometryTimer.Initialize();
+    lightingTimer.Initialize();
+    bool compareFrameDeferred = false;
+
     // ???ImGui???
     SoulsEngine::ImGuiSystem imguiSystem;
     if (!imguiSystem.Initialize(window.GetGLFWWindow())) {
@@ -376,8 +413,7 @@ int main() {
         
         if (!imguiWantsMouse && leftMouseDown && !leftMousePressed) {
             // ????????
-            auto allNodes = objectManager.GetAllNodes();
-            auto pickedNode = selectionSystem.PickNode(normalizedMousePos, camera, allNodes, 
+            auto pickedNode = selectionSystem.PickNode(normalizedMousePos, camera, objectManager,
                                                        window.GetWidth(), window.GetHeight());
             
             // ???????
@@ -532,10 +568,6 @@ int main() {
         glm::mat4 view = camera.GetViewMatrix();
         glm::mat4 projection = camera.GetProjectionMatrix(aspectRatio);
         
-        // ???????????????Shader
-        shader.SetMat4("view", glm::value_ptr(view));
-        shader.SetMat4("projection", glm::value_ptr(projection));
-        
         // ??????????????????- ????????????????????????????????????
         objectManager.Update();
         
@@ -558,55 +590,80 @@ int main() {
             }
         }
         
-        // ??????????????ightManager????????- ?????????????????????
-        glm::vec3 lightPos;
-        glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
-        float lightIntensity = 0.0f;  // ????????
-        
-        auto firstLight = lightManager.GetFirstLight();
-        if (firstLight) {
-            lightPos = firstLight->GetPosition();
-            lightColor = firstLight->GetColor();
-            lightIntensity = firstLight->GetIntensity();
+        // 上传本帧的相机和光源数据（拖动光源指示器后光源位置已在上面更新）
+        frameUniforms.SetCamera(view, projection, camera.GetPosition());
+        frameUniforms.SetLights(lightManager.GetLights());
+        frameUniforms.Upload();
+
+        // ????????????????????
+        // 视锥体外的节点不提交绘制
+        SoulsEngine::ViewFrustum frustum(view, projection);
+
+        // 选择本帧的渲染路径：对比计时时两条路径每帧交替
+        SoulsEngine::RenderPath renderPath = imguiSystem.GetRenderPath();
+        if (imguiSystem.IsCompareTiming()) {
+            compareFrameDeferred = !compareFrameDeferred;
+            renderPath = compareFrameDeferred ? SoulsEngine::RenderPath::Deferred : SoulsEngine::RenderPath::Forward;
+        }
+        if (renderPath == SoulsEngine::RenderPath::Deferred) {
+            int framebufferWidth = 0, framebufferHeight = 0;
+            glfwGetFramebufferSize(window.GetGLFWWindow(), &framebufferWidth, &framebufferHeight);
+            if (!deferredShadersLoaded || !deferredRenderer.Resize(framebufferWidth, framebufferHeight)) {
+                renderPath = SoulsEngine::RenderPath::Forward;
+            }
+        }
+
+        if (renderPath == SoulsEngine::RenderPath::Deferred) {
+            // 几何通道写入G-buffer，光照通道写入屏幕并拷贝深度，之后的线框照常前向绘制
+            geometryTimer.Begin();
+            deferredRenderer.BeginGeometryPass();
+            objectManager.Render(&gbufferShader, view, &frustum);
+            deferredRenderer.EndGeometryPass();
+            geometryTimer.End();
+
+            lightingTimer.Begin();
+            deferredRenderer.LightingPass(lightingShader, view, projection);
+            lightingTimer.End();
+            shader.Use();
         } else {
-            // ???????????????????????0?????????
-            lightPos = glm::vec3(0.0f, 0.0f, 0.0f);  // ?????????????????0
-            lightIntensity = 0.0f;
+            forwardTimer.Begin();
+            objectManager.Render(&shader, view, &frustum);
+            forwardTimer.End();
         }
-        
-        glm::vec3 viewPos = camera.GetPosition();
-        shader.SetVec3("lightPos", lightPos.x, lightPos.y, lightPos.z);
-        shader.SetVec3("lightColor", lightColor.r * lightIntensity, lightColor.g * lightIntensity, lightColor.b * lightIntensity);
-        shader.SetVec3("viewPos", viewPos.x, viewPos.y, viewPos.z);
 
-        // ????????????????????
-        objectManager.Render(&shader);
+        SoulsEngine::RenderTimings renderTimings;
+        renderTimings.forwardMs = forwardTimer.GetMilliseconds();
+        renderTimings.forwardValid = forwardTimer.HasResult();
+        renderTimings.deferredGeometryMs = geometryTimer.GetMilliseconds();
+        renderTimings.deferredLightingMs = lightingTimer.GetMilliseconds();
+        renderTimings.deferredValid = geometryTimer.HasResult() && lightingTimer.HasResult();
+        imguiSystem.SetRenderTimings(renderTimings);
 
         // ????????????????????
         if (auto selectedNode = selectionSystem.GetSelectedNode()) {
             // ?????????
-            shader.SetBool("useOverrideColor", true);
-            shader.SetVec3("overrideColor", 0.0f, 0.0f, 0.0f);  // ???
+            outlineShader.Use();
+            outlineShader.SetVec3("overrideColor", 0.0f, 0.0f, 0.0f);  // ???
             
             // ??????????????
             glm::mat4 identity = glm::mat4(1.0f);
-            selectedNode->RenderWireframe(identity, &shader);
+            selectedNode->RenderWireframe(identity, &outlineShader);
             
             // ?????????
-            shader.SetBool("useOverrideColor", false);
+            shader.Use();
         }
         
         // ?????????????????????
         auto lights = lightManager.GetLights();
         for (auto light : lights) {
             std::string indicatorName = "LightIndicator_" + light->GetName();
-            auto indicatorNode = objectManager.FindNode(indicatorName);
+            SoulsEngine::SceneNode* indicatorNode = objectManager.GetNode(objectManager.FindHandle(indicatorName));
             if (indicatorNode) {
                 // ????????????????????????????????????????
                 // ????????????????????????????????????????????
                 // ????????????????????
                 auto selectedNode = selectionSystem.GetSelectedNode();
-                bool isSelected = (selectedNode == indicatorNode);
+                bool isSelected = (selectedNode.get() == indicatorNode);
                 
                 if (!isSelected) {
                     // ??????????????????????????
@@ -632,13 +689,13 @@ int main() {
                 // ?????????????????????????????????????????
                 
                 // ????????????????????
-                shader.SetBool("useOverrideColor", true);
-                shader.SetVec3("overrideColor", 1.0f, 1.0f, 0.0f);  // ???
+                outlineShader.Use();
+                outlineShader.SetVec3("overrideColor", 1.0f, 1.0f, 0.0f);  // ???
                 
                 glm::mat4 identity = glm::mat4(1.0f);
-                indicatorNode->RenderWireframe(identity, &shader);
+                indicatorNode->RenderWireframe(identity, &outlineShader);
                 
-                shader.SetBool("useOverrideColor", false);
+                shader.Use();
             }
         }
 
@@ -658,6 +715,7 @@ int main() {
     // ????????????????????????
     imguiSystem.Shutdown();
     objectManager.Clear();
+    SoulsEngine::GeometryArena::Get().Shutdown();
 
     std::cout << "Shutting down..." << std::endl;
     
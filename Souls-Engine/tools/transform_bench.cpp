@@ -0,0 +1,407 @@
+// 变换更新基准测试（不需要窗口和OpenGL上下文）
+//
+// 用法：
+//   transform_bench scaling [节点数] [最大工作线程数]
+//       在随机层级的场景上用0..N个工作线程运行 TransformSystem::UpdateWorldTransforms，
+//       输出每种线程数的耗时，并检查结果与串行更新逐位一致（N默认为硬件线程数）
+//   transform_bench hierarchy [链长度] [扇出数]
+//       在深层链和宽扇出的层级上比较缓存的 GetWorldTransform/WorldToLocal 与逐级相乘父链的旧实现
+//   transform_bench bvh [最大节点数] [射线数]
+//       在1000、10000……直到最大节点数（默认100000）个随机旋转/缩放的盒子上测量 SceneBVH 的构建、重新拟合、
+//       最近命中和任意命中射线查询（重新拟合前约10%的节点移动一小段距离），
+//       并与逐节点测试的线性扫描比较耗时和结果（射线数默认2000）
+#include "core/JobSystem.h"
+#include "core/Node.h"
+#include "core/SceneBVH.h"
+#include "core/SceneNode.h"
+#include "core/TransformSystem.h"
+#include "geometry/Mesh.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SoulsEngine;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // 与游戏场景类似的层级：根节点下是一个个物体，每个物体是约64个节点的随机子树
+    std::vector<std::shared_ptr<Node>> BuildRandomScene(int nodeCount) {
+        const int objectSize = 64;
+        std::mt19937 rng(1);
+        std::vector<std::shared_ptr<Node>> nodes;
+        nodes.reserve(nodeCount);
+        nodes.push_back(std::make_shared<Node>("Root"));
+        for (int i = 1; i < nodeCount; ++i) {
+            auto node = std::make_shared<Node>("Node");
+            const int objectStart = 1 + (i - 1) / objectSize * objectSize;
+            Node* parent = i == objectStart ? nodes[0].get() : nodes[objectStart + rng() % (i - objectStart)].get();
+            parent->AddChild(node);
+            node->SetPosition(glm::vec3(static_cast<float>(i % 7), 1.0f, 2.0f));
+            node->SetRotation(glm::vec3(static_cast<float>(i % 13), 3.0f, 4.0f));
+            node->SetScale(glm::vec3(1.0f + static_cast<float>(i % 3) * 0.01f));
+            nodes.push_back(node);
+        }
+        return nodes;
+    }
+
+    // 每一帧：根节点旋转（整棵树变脏），另外修改约1%的节点
+    void AnimateFrame(std::vector<std::shared_ptr<Node>>& nodes, int frame) {
+        nodes[0]->SetRotation(glm::vec3(0.0f, static_cast<float>(frame) * 1.5f, 0.0f));
+        for (size_t i = 1; i < nodes.size(); i += 97) {
+            nodes[i]->SetRotation(glm::vec3(static_cast<float>(i % 13) + static_cast<float>(frame) * 0.3f, 3.0f, 4.0f));
+        }
+    }
+
+    int RunScaling(int nodeCount, unsigned maxWorkers) {
+        const int frames = 20;
+        auto nodes = BuildRandomScene(nodeCount);
+        TransformSystem& transforms = TransformSystem::Get();
+        JobSystem& jobs = JobSystem::Get();
+
+        std::printf("UpdateWorldTransforms: %d nodes, %d frames per run, %u hardware threads\n",
+                    nodeCount, frames, std::thread::hardware_concurrency());
+
+        std::vector<glm::mat4> serial;
+        bool allIdentical = true;
+        for (unsigned workers = 0; workers <= maxWorkers; ++workers) {
+            jobs.SetWorkerCount(workers);
+
+            // 每次从相同的状态开始，保证各线程数的输入完全一致
+            AnimateFrame(nodes, 0);
+            transforms.UpdateWorldTransforms(&jobs);
+
+            double total = 0.0;
+            double best = 1e30;
+            for (int frame = 1; frame <= frames; ++frame) {
+                AnimateFrame(nodes, frame);
+                const auto start = Clock::now();
+                transforms.UpdateWorldTransforms(&jobs);
+                const double ms = ElapsedMs(start);
+                total += ms;
+                best = std::min(best, ms);
+            }
+
+            std::vector<glm::mat4> world;
+            world.reserve(nodes.size());
+            for (const auto& node : nodes) {
+                world.push_back(transforms.GetWorldMatrix(node->GetTransformId()));
+            }
+            if (serial.empty()) {
+                serial = world;
+            }
+            const bool identical = std::memcmp(serial.data(), world.data(), world.size() * sizeof(glm::mat4)) == 0;
+            allIdentical = allIdentical && identical;
+
+            std::printf("  workers %2u: %8.3f ms/frame (best %8.3f ms), bit-identical to serial: %s\n",
+                        workers, total / frames, best, identical ? "yes" : "NO");
+        }
+
+        jobs.SetWorkerCount(JobSystem::GetDefaultWorkerCount());
+        return allIdentical ? 0 : 1;
+    }
+
+    // 旧实现：每次查询都沿父链把局部矩阵逐级相乘
+    glm::mat4 ChainWorldTransform(const Node& node) {
+        glm::mat4 world = node.GetLocalTransform();
+        for (const Node* parent = node.GetParent(); parent; parent = parent->GetParent()) {
+            world = parent->GetLocalTransform() * world;
+        }
+        return world;
+    }
+
+    float MaxDifference(const glm::mat4& a, const glm::mat4& b) {
+        float difference = 0.0f;
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                difference = std::max(difference, std::fabs(a[column][row] - b[column][row]));
+            }
+        }
+        return difference;
+    }
+
+    float MaxDifference(const glm::vec3& a, const glm::vec3& b) {
+        const glm::vec3 difference = glm::abs(a - b);
+        return std::max(difference.x, std::max(difference.y, difference.z));
+    }
+
+    float SinkValue(const glm::mat4& m) { return m[3][0]; }
+    float SinkValue(const glm::vec3& v) { return v.x; }
+
+    // 对queried中的每个节点重复查询passes遍，moveRoot时每一遍之前移动根节点（整条链/所有子节点变脏）
+    // 输出缓存实现与旧实现的耗时，以及最后一遍两者结果的最大差异
+    template <typename Cached, typename Reference>
+    void CompareQueries(const char* name, Node& root, const std::vector<Node*>& queried, int passes, bool moveRoot,
+                        Cached cached, Reference reference) {
+        volatile float sink = 0.0f;
+        auto run = [&](auto query) {
+            const auto start = Clock::now();
+            float sum = 0.0f;
+            for (int pass = 0; pass < passes; ++pass) {
+                if (moveRoot) {
+                    root.SetPosition(glm::vec3(static_cast<float>(pass % 100) * 0.01f, 0.0f, 0.0f));
+                }
+                for (Node* node : queried) {
+                    sum += SinkValue(query(*node));
+                }
+            }
+            sink = sink + sum;
+            return ElapsedMs(start);
+        };
+
+        const double cachedMs = run(cached);
+        const double referenceMs = run(reference);
+
+        float maxError = 0.0f;
+        for (Node* node : queried) {
+            maxError = std::max(maxError, MaxDifference(cached(*node), reference(*node)));
+        }
+        std::printf("  %-48s cached %9.3f ms, chain walk %9.3f ms (%6.1fx), max difference %.2e\n",
+                    name, cachedMs, referenceMs, referenceMs / std::max(cachedMs, 1e-6), maxError);
+    }
+
+    int RunHierarchy(int chainLength, int fanOut) {
+        const glm::vec3 point(1.0f, 2.0f, 3.0f);
+        auto world = [](const Node& node) { return node.GetWorldTransform(); };
+        auto chainWorld = [](const Node& node) { return ChainWorldTransform(node); };
+        auto worldToLocal = [&point](const Node& node) { return node.WorldToLocal(point); };
+        auto chainWorldToLocal = [&point](const Node& node) {
+            return glm::vec3(glm::inverse(ChainWorldTransform(node)) * glm::vec4(point, 1.0f));
+        };
+
+        // 深层链：每个节点只有一个子节点，查询链末端的叶子
+        {
+            auto root = std::make_shared<Node>("ChainRoot");
+            std::vector<std::shared_ptr<Node>> chain{ root };
+            for (int i = 1; i < chainLength; ++i) {
+                auto node = std::make_shared<Node>("Chain");
+                chain.back()->AddChild(node);
+                node->SetPosition(glm::vec3(0.01f, 0.1f, 0.0f));
+                node->SetRotation(glm::vec3(0.1f, 0.2f, 0.3f));
+                chain.push_back(node);
+            }
+            const std::vector<Node*> leaf{ chain.back().get() };
+            std::printf("Deep chain: %d nodes, leaf queried\n", chainLength);
+            CompareQueries("GetWorldTransform x10000, unchanged", *root, leaf, 10000, false, world, chainWorld);
+            CompareQueries("GetWorldTransform x1000, root moved each", *root, leaf, 1000, true, world, chainWorld);
+            CompareQueries("WorldToLocal x10000, unchanged", *root, leaf, 10000, false, worldToLocal, chainWorldToLocal);
+            CompareQueries("WorldToLocal x1000, root moved each", *root, leaf, 1000, true, worldToLocal, chainWorldToLocal);
+        }
+
+        // 宽扇出：根节点下fanOut个子节点，每一遍查询所有子节点
+        {
+            auto root = std::make_shared<Node>("FanRoot");
+            root->SetRotation(glm::vec3(0.0f, 30.0f, 0.0f));
+            std::vector<Node*> queried;
+            for (int i = 0; i < fanOut; ++i) {
+                auto node = std::make_shared<Node>("Fan");
+                root->AddChild(node);
+                node->SetPosition(glm::vec3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100)));
+                node->SetRotation(glm::vec3(0.0f, static_cast<float>(i % 360), 0.0f));
+                queried.push_back(node.get());
+            }
+            std::printf("Wide fan-out: %d children, all queried per pass\n", fanOut);
+            CompareQueries("GetWorldTransform x100 passes, unchanged", *root, queried, 100, false, world, chainWorld);
+            CompareQueries("GetWorldTransform x100 passes, root moved each", *root, queried, 100, true, world, chainWorld);
+            CompareQueries("WorldToLocal x100 passes, unchanged", *root, queried, 100, false, worldToLocal, chainWorldToLocal);
+            CompareQueries("WorldToLocal x100 passes, root moved each", *root, queried, 100, true, worldToLocal, chainWorldToLocal);
+        }
+        return 0;
+    }
+
+    // 只有局部包围盒、没有GPU数据的网格：射线查询只用到包围盒，基准测试因此不需要OpenGL上下文
+    class BoundsOnlyMesh : public Mesh {
+    public:
+        explicit BoundsOnlyMesh(const BoundingBox& bounds) { m_localBounds = bounds; }
+    };
+
+    // 平板法，与SceneBVH的包围盒测试相同（起点在盒内时返回0，不相交时返回FLT_MAX）
+    float IntersectSlabs(const glm::vec3& origin, const glm::vec3& invDirection,
+                         const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxDistance) {
+        glm::vec3 t1 = (boundsMin - origin) * invDirection;
+        glm::vec3 t2 = (boundsMax - origin) * invDirection;
+        glm::vec3 tMin = glm::min(t1, t2);
+        glm::vec3 tMax = glm::max(t1, t2);
+        float tNear = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+        float tFar = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+        return tNear <= tFar ? tNear : FLT_MAX;
+    }
+
+    // 线性扫描：每个节点先测世界包围盒，再把射线变换到局部空间测网格包围盒（与BVH叶子中的精确测试相同）
+    bool LinearRaycast(const std::vector<std::shared_ptr<SceneNode>>& nodes, const glm::vec3& origin,
+                       const glm::vec3& direction, float maxDistance, RayHit& hit) {
+        TransformSystem& transforms = TransformSystem::Get();
+        const glm::vec3 invDirection = 1.0f / direction;
+        float closest = maxDistance;
+        SceneNode* closestNode = nullptr;
+        for (const auto& node : nodes) {
+            const BoundingBox bounds = transforms.GetWorldBounds(node->GetTransformId());
+            if (!bounds.IsValid()) continue;
+            if (IntersectSlabs(origin, invDirection, bounds.GetMin(), bounds.GetMax(), closest) == FLT_MAX) continue;
+
+            const glm::mat4& inverseWorld = transforms.GetInverseWorldMatrix(node->GetTransformId());
+            const glm::vec3 localOrigin = glm::vec3(inverseWorld * glm::vec4(origin, 1.0f));
+            const glm::vec3 localDirection = glm::vec3(inverseWorld * glm::vec4(direction, 0.0f));
+            const BoundingBox& localBounds = node->GetMesh()->GetLocalBounds();
+            const float t = IntersectSlabs(localOrigin, 1.0f / localDirection, localBounds.GetMin(), localBounds.GetMax(), closest);
+            if (t < closest || (t == closest && !closestNode)) {
+                closest = t;
+                closestNode = node.get();
+            }
+        }
+        if (!closestNode) return false;
+        hit.node = closestNode;
+        hit.distance = closest;
+        hit.point = origin + direction * closest;
+        return true;
+    }
+
+    // 在边长随节点数增长（密度不变）的立方体中随机放置盒子，测量BVH与线性扫描
+    // 线性扫描在大场景上很慢，只对前scanRays条射线运行并与BVH的结果逐条比较
+    bool RunBVHSize(int nodeCount, int rayCount, const std::shared_ptr<Mesh>& mesh) {
+        const int scanRays = std::min(rayCount, 200);
+        const float extent = 4.0f * std::cbrt(static_cast<float>(nodeCount));
+        std::mt19937 rng(static_cast<unsigned>(nodeCount));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto randomPosition = [&]() { return glm::vec3(unit(rng), unit(rng), unit(rng)) * extent; };
+
+        std::vector<std::shared_ptr<SceneNode>> nodes;
+        std::vector<SceneNode*> nodePointers;
+        nodes.reserve(nodeCount);
+        nodePointers.reserve(nodeCount);
+        for (int i = 0; i < nodeCount; ++i) {
+            auto node = std::make_shared<SceneNode>("Box");
+            node->SetMesh(mesh);
+            node->SetPosition(randomPosition());
+            node->SetRotation(glm::vec3(unit(rng), unit(rng), unit(rng)) * 360.0f);
+            node->SetScale(glm::vec3(0.5f + unit(rng), 0.5f + unit(rng), 0.5f + unit(rng)));
+            nodes.push_back(node);
+            nodePointers.push_back(node.get());
+        }
+        TransformSystem::Get().UpdateWorldTransforms();
+
+        SceneBVH bvh;
+        auto start = Clock::now();
+        bvh.Build(nodePointers);
+        const double buildMs = ElapsedMs(start);
+
+        // 约10%的节点移动一小段距离后重新拟合（与ObjectManager相同，质量下降过多时重建），之后的查询都在这棵树上进行
+        for (int i = 0; i < nodeCount; i += 10) {
+            nodes[i]->Translate(glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f - 1.0f);
+        }
+        TransformSystem::Get().UpdateWorldTransforms();
+        start = Clock::now();
+        const bool refitOk = bvh.Refit();
+        const double refitMs = ElapsedMs(start);
+        if (!refitOk) {
+            bvh.Build(nodePointers);
+        }
+
+        std::vector<glm::vec3> origins(rayCount);
+        std::vector<glm::vec3> directions(rayCount);
+        for (int i = 0; i < rayCount; ++i) {
+            origins[i] = randomPosition();
+            directions[i] = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f - 1.0f);
+        }
+        const float maxDistance = extent * 2.0f;
+
+        std::vector<RayHit> bvhHits(rayCount);
+        int hitCount = 0;
+        start = Clock::now();
+        for (int i = 0; i < rayCount; ++i) {
+            hitCount += bvh.Raycast(origins[i], directions[i], maxDistance, NodeLayer::All, bvhHits[i]) ? 1 : 0;
+        }
+        const double closestUs = ElapsedMs(start) * 1000.0 / rayCount;
+
+        int anyCount = 0;
+        start = Clock::now();
+        for (int i = 0; i < rayCount; ++i) {
+            anyCount += bvh.RaycastAny(origins[i], directions[i], maxDistance, NodeLayer::All) ? 1 : 0;
+        }
+        const double anyUs = ElapsedMs(start) * 1000.0 / rayCount;
+
+        std::vector<RayHit> scanHits(scanRays);
+        start = Clock::now();
+        for (int i = 0; i < scanRays; ++i) {
+            LinearRaycast(nodes, origins[i], directions[i], maxDistance, scanHits[i]);
+        }
+        const double scanUs = ElapsedMs(start) * 1000.0 / scanRays;
+
+        // 距离相同的重叠盒子可能命中不同的节点，因此比较命中与否和距离
+        int mismatches = anyCount != hitCount ? 1 : 0;
+        for (int i = 0; i < scanRays; ++i) {
+            const bool bvhHit = bvhHits[i].node != nullptr;
+            const bool scanHit = scanHits[i].node != nullptr;
+            if (bvhHit != scanHit || (bvhHit && std::fabs(bvhHits[i].distance - scanHits[i].distance) > 1e-4f)) {
+                ++mismatches;
+            }
+        }
+
+        std::printf("  %7d | %10.2f | %10.3f%s | %12.2f | %10.2f | %12.1f | %6.1f%% | %s\n",
+                    nodeCount, buildMs, refitMs, refitOk ? " " : "*", closestUs, anyUs, scanUs,
+                    100.0 * hitCount / rayCount, mismatches == 0 ? "yes" : "NO");
+        return mismatches == 0;
+    }
+
+    int RunBVH(int maxNodes, int rayCount) {
+        const BoundingBox unitBox = BoundingBox::FromMinMax(glm::vec3(-0.5f), glm::vec3(0.5f));
+        auto mesh = std::make_shared<BoundsOnlyMesh>(unitBox);
+
+        std::printf("SceneBVH ray queries: %d random rays per size (linear scan: first %d), refit after moving 10%% of the nodes by up to 1 unit\n",
+                    rayCount, std::min(rayCount, 200));
+        std::printf("    nodes | build (ms) | refit (ms) | closest (us) | any (us)   | linear (us)  | hits    | matches scan\n");
+        bool allMatch = true;
+        for (int nodeCount = std::min(1000, maxNodes); ; nodeCount = std::min(nodeCount * 10, maxNodes)) {
+            allMatch = RunBVHSize(nodeCount, rayCount, mesh) && allMatch;
+            if (nodeCount == maxNodes) break;
+        }
+        std::printf("  (* = refit reported that the tree should be rebuilt; queries ran on the rebuilt tree)\n");
+        return allMatch ? 0 : 1;
+    }
+
+    void PrintUsage() {
+        std::printf("Usage:\n");
+        std::printf("  transform_bench scaling [nodes=50000] [maxWorkers=hardware threads]\n");
+        std::printf("  transform_bench hierarchy [chainLength=1000] [fanOut=10000]\n");
+        std::printf("  transform_bench bvh [maxNodes=100000] [rays=2000]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::string mode = argc > 1 ? argv[1] : "scaling";
+
+    if (mode == "scaling") {
+        const int nodeCount = argc > 2 ? std::max(std::atoi(argv[2]), 2) : 50000;
+        const unsigned hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        const unsigned maxWorkers = argc > 3 ? static_cast<unsigned>(std::max(std::atoi(argv[3]), 0)) : hardwareThreads;
+        return RunScaling(nodeCount, maxWorkers);
+    }
+
+    if (mode == "hierarchy") {
+        const int chainLength = argc > 2 ? std::max(std::atoi(argv[2]), 2) : 1000;
+        const int fanOut = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 10000;
+        return RunHierarchy(chainLength, fanOut);
+    }
+
+    if (mode == "bvh") {
+        const int maxNodes = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 100000;
+        const int rayCount = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 2000;
+        return RunBVH(maxNodes, rayCount);
+    }
+
+    PrintUsage();
+    return 1;
+}
@@ -0,0 +1,118 @@
+// Uniform设置基准测试：按名字设置（每次glGetUniformLocation）与按预先解析的句柄设置
+//
+// 用法：
+//   uniform_bench [绘制次数] [重复次数]
+//       用 assets/shaders/basic.vert/frag 逐物体设置 model 和材质uniform（与逐节点渲染路径相同的5个uniform），
+//       分别测量只设置uniform和设置后绘制一个立方体的耗时，输出各重复的中位数（默认10000次绘制、15次重复）
+#include <glad/glad.h>
+#include "core/Window.h"
+#include "core/OpenGLContext.h"
+#include "core/Shader.h"
+#include "core/Material.h"
+#include "geometry/Cube.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace SoulsEngine;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    double Median(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+}
+
+int main(int argc, char** argv) {
+    const int draws = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10000;
+    const int repetitions = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 15;
+
+    Window window(320, 240, "Uniform Bench");
+    if (!window.Initialize() || !OpenGLContext::Initialize(window.GetGLFWWindow())) {
+        std::fprintf(stderr, "Error: Failed to create OpenGL context\n");
+        return 1;
+    }
+
+    Shader shader;
+    if (!shader.LoadFromFiles("assets/shaders/basic.vert", "assets/shaders/basic.frag")) {
+        std::fprintf(stderr, "Error: Failed to load assets/shaders/basic.vert/frag (run from the build directory)\n");
+        return 1;
+    }
+
+    Cube cube(1.0f);
+    Material material;
+    std::vector<glm::mat4> models(draws);
+    for (int i = 0; i < draws; ++i) {
+        models[i] = glm::translate(glm::mat4(1.0f), glm::vec3((i % 100) * 0.1f, (i / 100) * 0.1f, -5.0f));
+    }
+
+    shader.Use();
+    glBindVertexArray(cube.GetVAO());
+    const auto model = shader.GetUniformHandle<glm::mat4>("model");
+    const auto ambient = shader.GetUniformHandle<glm::vec3>("material.ambient");
+    const auto diffuse = shader.GetUniformHandle<glm::vec3>("material.diffuse");
+    const auto specular = shader.GetUniformHandle<glm::vec3>("material.specular");
+    const auto shininess = shader.GetUniformHandle<float>("material.shininess");
+
+    // 旧路径：每个uniform按名字查找位置
+    auto setByName = [&](int i) {
+        shader.SetMat4("model", glm::value_ptr(models[i]));
+        const glm::vec3 a = material.GetAmbient();
+        const glm::vec3 d = material.GetDiffuse();
+        const glm::vec3 s = material.GetSpecular();
+        shader.SetVec3("material.ambient", a.x, a.y, a.z);
+        shader.SetVec3("material.diffuse", d.x, d.y, d.z);
+        shader.SetVec3("material.specular", s.x, s.y, s.z);
+        shader.SetFloat("material.shininess", material.GetShininess());
+    };
+    // 新路径：位置在链接后解析一次
+    auto setByHandle = [&](int i) {
+        shader.Set(model, models[i]);
+        shader.Set(ambient, material.GetAmbient());
+        shader.Set(diffuse, material.GetDiffuse());
+        shader.Set(specular, material.GetSpecular());
+        shader.Set(shininess, material.GetShininess());
+    };
+
+    // samples[是否绘制][0=按名字, 1=按句柄]
+    std::vector<double> samples[2][2];
+    for (int repetition = 0; repetition < repetitions; ++repetition) {
+        for (int draw = 0; draw < 2; ++draw) {
+            for (int mode = 0; mode < 2; ++mode) {
+                glFinish();
+                const auto start = Clock::now();
+                for (int i = 0; i < draws; ++i) {
+                    if (mode == 0) {
+                        setByName(i);
+                    } else {
+                        setByHandle(i);
+                    }
+                    if (draw) {
+                        cube.DrawBound();
+                    }
+                }
+                samples[draw][mode].push_back(ElapsedMs(start));
+                glFinish();
+            }
+        }
+    }
+
+    std::printf("Uniforms: %d iterations x 5 uniforms, median of %d runs (CPU submission time)\n", draws, repetitions);
+    std::printf("  uniform sets only: by name %8.3f ms, by handle %8.3f ms\n",
+                Median(samples[0][0]), Median(samples[0][1]));
+    std::printf("  with cube draws:   by name %8.3f ms, by handle %8.3f ms\n",
+                Median(samples[1][0]), Median(samples[1][1]));
+
+    window.Shutdown();
+    return 0;
+}